@@ -38,7 +38,11 @@ commands:
                           notification system
     output ...          → Allows you to add and remove fake outputs to your
                           preferred backend
+    perf                → Prints percentiles of per-monitor frame timings,
+                          latencies and damage
     plugin ...          → Issue a plugin request
+    regexcache          → Prints hit and miss counts of the compiled regex
+                          cache used by window selectors and rules
     reload [config-only] → Issue a reload to force reload the config. Pass
                           'config-only' to disable monitor reload
     rollinglog          → Prints tail of the log. Also supports -f/--follow
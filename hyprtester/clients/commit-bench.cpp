@@ -0,0 +1,222 @@
+#include <cstring>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <algorithm>
+#include <chrono>
+#include <print>
+#include <format>
+#include <string>
+#include <vector>
+
+#include <wayland-client.h>
+#include <wayland.hpp>
+#include <xdg-shell.hpp>
+
+#include <hyprutils/memory/SharedPtr.hpp>
+
+using namespace Hyprutils::Memory;
+
+// commits a toplevel and its desync subsurfaces as fast as the compositor takes them, then puts the timings in its title
+
+constexpr int SIZE = 64;
+
+struct SSubsurface {
+    CSharedPointer<CCWlSurface>    surf;
+    CSharedPointer<CCWlSubsurface> subsurface;
+};
+
+struct SWlState {
+    wl_display*                  display;
+    CSharedPointer<CCWlRegistry> registry;
+
+    // protocols
+    CSharedPointer<CCWlCompositor>    wlCompositor;
+    CSharedPointer<CCWlSubcompositor> wlSubcompositor;
+    CSharedPointer<CCWlShm>           wlShm;
+    CSharedPointer<CCXdgWmBase>       xdgShell;
+
+    CSharedPointer<CCWlShmPool>       shmPool;
+    CSharedPointer<CCWlBuffer>        shmBuf;
+
+    CSharedPointer<CCWlSurface>       surf;
+    CSharedPointer<CCXdgSurface>      xdgSurf;
+    CSharedPointer<CCXdgToplevel>     xdgToplevel;
+    bool                              configured = false;
+
+    std::vector<SSubsurface>          subsurfaces;
+};
+
+static bool bindRegistry(SWlState& state) {
+    state.registry = makeShared<CCWlRegistry>((wl_proxy*)wl_display_get_registry(state.display));
+
+    state.registry->setGlobal([&](CCWlRegistry* r, uint32_t id, const char* name, uint32_t version) {
+        const std::string NAME = name;
+        if (NAME == "wl_compositor")
+            state.wlCompositor = makeShared<CCWlCompositor>((wl_proxy*)wl_registry_bind((wl_registry*)state.registry->resource(), id, &wl_compositor_interface, 6));
+        else if (NAME == "wl_subcompositor")
+            state.wlSubcompositor = makeShared<CCWlSubcompositor>((wl_proxy*)wl_registry_bind((wl_registry*)state.registry->resource(), id, &wl_subcompositor_interface, 1));
+        else if (NAME == "wl_shm")
+            state.wlShm = makeShared<CCWlShm>((wl_proxy*)wl_registry_bind((wl_registry*)state.registry->resource(), id, &wl_shm_interface, 1));
+        else if (NAME == "xdg_wm_base")
+            state.xdgShell = makeShared<CCXdgWmBase>((wl_proxy*)wl_registry_bind((wl_registry*)state.registry->resource(), id, &xdg_wm_base_interface, 1));
+    });
+
+    wl_display_roundtrip(state.display);
+
+    return state.wlCompositor && state.wlSubcompositor && state.wlShm && state.xdgShell;
+}
+
+static bool createShm(SWlState& state) {
+    const size_t STRIDE = SIZE * 4;
+    const size_t BYTES  = STRIDE * SIZE;
+
+    const char*  name = "/wl-shm-commit-bench";
+    int          fd   = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd < 0)
+        return false;
+
+    if (shm_unlink(name) < 0 || ftruncate(fd, BYTES) < 0) {
+        close(fd);
+        return false;
+    }
+
+    state.shmPool = makeShared<CCWlShmPool>(state.wlShm->sendCreatePool(fd, BYTES));
+    close(fd);
+
+    if (!state.shmPool->resource())
+        return false;
+
+    state.shmBuf = makeShared<CCWlBuffer>(state.shmPool->sendCreateBuffer(0, SIZE, SIZE, STRIDE, WL_SHM_FORMAT_XRGB8888));
+    return state.shmBuf->resource();
+}
+
+static bool createToplevel(SWlState& state) {
+    state.surf = makeShared<CCWlSurface>(state.wlCompositor->sendCreateSurface());
+    if (!state.surf->resource())
+        return false;
+
+    state.xdgSurf = makeShared<CCXdgSurface>(state.xdgShell->sendGetXdgSurface(state.surf->resource()));
+    if (!state.xdgSurf->resource())
+        return false;
+
+    state.xdgToplevel = makeShared<CCXdgToplevel>(state.xdgSurf->sendGetToplevel());
+    if (!state.xdgToplevel->resource())
+        return false;
+
+    state.xdgToplevel->setClose([](CCXdgToplevel* p) { exit(0); });
+
+    state.xdgSurf->setConfigure([&state](CCXdgSurface* p, uint32_t serial) {
+        state.xdgSurf->sendAckConfigure(serial);
+
+        if (state.configured)
+            return;
+
+        state.xdgSurf->sendSetWindowGeometry(0, 0, SIZE, SIZE);
+        state.surf->sendAttach(state.shmBuf.get(), 0, 0);
+        state.surf->sendCommit();
+        state.configured = true;
+    });
+
+    state.xdgToplevel->sendSetTitle("commit-bench");
+    state.xdgToplevel->sendSetAppId("commit-bench");
+
+    state.surf->sendAttach(nullptr, 0, 0);
+    state.surf->sendCommit();
+
+    while (!state.configured) {
+        if (wl_display_dispatch(state.display) == -1)
+            return false;
+    }
+
+    return true;
+}
+
+static bool createSubsurfaces(SWlState& state, size_t count) {
+    state.subsurfaces.resize(count);
+
+    for (size_t i = 0; i < count; ++i) {
+        auto& sub = state.subsurfaces[i];
+
+        sub.surf = makeShared<CCWlSurface>(state.wlCompositor->sendCreateSurface());
+        if (!sub.surf->resource())
+            return false;
+
+        sub.subsurface = makeShared<CCWlSubsurface>(state.wlSubcompositor->sendGetSubsurface(sub.surf.get(), state.surf.get()));
+        if (!sub.subsurface->resource())
+            return false;
+
+        // desync, so every commit is applied on its own instead of waiting for the parent
+        sub.subsurface->sendSetPosition(i * 4, i * 4);
+        sub.subsurface->sendSetDesync();
+
+        sub.surf->sendAttach(state.shmBuf.get(), 0, 0);
+        sub.surf->sendCommit();
+    }
+
+    state.surf->sendCommit();
+    wl_display_roundtrip(state.display);
+
+    return true;
+}
+
+int main(int argc, char** argv) {
+    if (argc != 3) {
+        std::println("Usage: commit-bench <subsurfaces> <rounds>");
+        return -1;
+    }
+
+    SWlState     state;
+    const size_t SUBSURFACES = std::stoul(argv[1]);
+    const size_t ROUNDS      = std::stoul(argv[2]);
+
+    // WAYLAND_DISPLAY env should be set to the correct one
+    state.display = wl_display_connect(nullptr);
+    if (!state.display) {
+        std::println("Failed to connect to wayland display");
+        return -1;
+    }
+
+    if (!bindRegistry(state) || !createShm(state) || !createToplevel(state) || !createSubsurfaces(state, SUBSURFACES))
+        return -1;
+
+    state.xdgShell->setPing([&](CCXdgWmBase* p, uint32_t serial) { state.xdgShell->sendPong(serial); });
+
+    // every surface commits a new buffer with damage once per round, the roundtrip waits for the compositor to have handled all of them
+    const size_t COMMITS = ROUNDS * (SUBSURFACES + 1);
+    double       totalUs = 0, worstUs = 0;
+
+    for (size_t r = 0; r < ROUNDS; ++r) {
+        const auto BEGIN = std::chrono::steady_clock::now();
+
+        for (auto& sub : state.subsurfaces) {
+            sub.surf->sendAttach(state.shmBuf.get(), 0, 0);
+            sub.surf->sendDamageBuffer(0, 0, SIZE, SIZE);
+            sub.surf->sendCommit();
+        }
+
+        state.surf->sendAttach(state.shmBuf.get(), 0, 0);
+        state.surf->sendDamageBuffer(0, 0, SIZE, SIZE);
+        state.surf->sendCommit();
+
+        wl_display_roundtrip(state.display);
+
+        const auto US = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - BEGIN).count() / (SUBSURFACES + 1);
+        totalUs += US;
+        worstUs  = std::max(worstUs, US);
+    }
+
+    // tests wait for this title, the window stays around so the compositor side can be inspected
+    state.xdgToplevel->sendSetTitle(std::format("commit-bench done: {} commits, {:.1f}us avg, {:.1f}us in the slowest round", COMMITS, totalUs / ROUNDS, worstUs).c_str());
+    state.surf->sendCommit();
+
+    while (wl_display_dispatch(state.display) != -1) {
+        ;
+    }
+
+    wl_display* display = state.display;
+    state               = {};
+
+    wl_display_disconnect(display);
+    return 0;
+}
@@ -0,0 +1,166 @@
+#include <cstring>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <print>
+#include <format>
+#include <string>
+#include <vector>
+
+#include <wayland-client.h>
+#include <wayland.hpp>
+#include <xdg-shell.hpp>
+
+#include <hyprutils/memory/SharedPtr.hpp>
+
+using namespace Hyprutils::Memory;
+
+// opens as many toplevels as asked for from one process, so tests can fill workspaces without spawning that many terminals
+
+constexpr int SIZE = 64;
+
+struct SToplevel {
+    CSharedPointer<CCWlSurface>   surf;
+    CSharedPointer<CCXdgSurface>  xdgSurf;
+    CSharedPointer<CCXdgToplevel> xdgToplevel;
+    bool                          configured = false;
+};
+
+struct SWlState {
+    wl_display*                  display;
+    CSharedPointer<CCWlRegistry> registry;
+
+    // protocols
+    CSharedPointer<CCWlCompositor> wlCompositor;
+    CSharedPointer<CCWlShm>        wlShm;
+    CSharedPointer<CCXdgWmBase>    xdgShell;
+
+    // one buffer, shared by every surface
+    CSharedPointer<CCWlShmPool> shmPool;
+    CSharedPointer<CCWlBuffer>  shmBuf;
+
+    std::vector<SToplevel>      toplevels;
+    size_t                      configured = 0;
+};
+
+static bool bindRegistry(SWlState& state) {
+    state.registry = makeShared<CCWlRegistry>((wl_proxy*)wl_display_get_registry(state.display));
+
+    state.registry->setGlobal([&](CCWlRegistry* r, uint32_t id, const char* name, uint32_t version) {
+        const std::string NAME = name;
+        if (NAME == "wl_compositor")
+            state.wlCompositor = makeShared<CCWlCompositor>((wl_proxy*)wl_registry_bind((wl_registry*)state.registry->resource(), id, &wl_compositor_interface, 6));
+        else if (NAME == "wl_shm")
+            state.wlShm = makeShared<CCWlShm>((wl_proxy*)wl_registry_bind((wl_registry*)state.registry->resource(), id, &wl_shm_interface, 1));
+        else if (NAME == "xdg_wm_base")
+            state.xdgShell = makeShared<CCXdgWmBase>((wl_proxy*)wl_registry_bind((wl_registry*)state.registry->resource(), id, &xdg_wm_base_interface, 1));
+    });
+
+    wl_display_roundtrip(state.display);
+
+    return state.wlCompositor && state.wlShm && state.xdgShell;
+}
+
+static bool createShm(SWlState& state) {
+    const size_t STRIDE = SIZE * 4;
+    const size_t BYTES  = STRIDE * SIZE;
+
+    const char*  name = "/wl-shm-tiled-windows";
+    int          fd   = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd < 0)
+        return false;
+
+    if (shm_unlink(name) < 0 || ftruncate(fd, BYTES) < 0) {
+        close(fd);
+        return false;
+    }
+
+    state.shmPool = makeShared<CCWlShmPool>(state.wlShm->sendCreatePool(fd, BYTES));
+    close(fd);
+
+    if (!state.shmPool->resource())
+        return false;
+
+    // XRGB8888 is one of the two formats every compositor has to support
+    state.shmBuf = makeShared<CCWlBuffer>(state.shmPool->sendCreateBuffer(0, SIZE, SIZE, STRIDE, WL_SHM_FORMAT_XRGB8888));
+    return state.shmBuf->resource();
+}
+
+static bool createToplevel(SWlState& state, SToplevel& toplevel, size_t idx) {
+    toplevel.surf = makeShared<CCWlSurface>(state.wlCompositor->sendCreateSurface());
+    if (!toplevel.surf->resource())
+        return false;
+
+    toplevel.xdgSurf = makeShared<CCXdgSurface>(state.xdgShell->sendGetXdgSurface(toplevel.surf->resource()));
+    if (!toplevel.xdgSurf->resource())
+        return false;
+
+    toplevel.xdgToplevel = makeShared<CCXdgToplevel>(toplevel.xdgSurf->sendGetToplevel());
+    if (!toplevel.xdgToplevel->resource())
+        return false;
+
+    toplevel.xdgToplevel->setClose([](CCXdgToplevel* p) { exit(0); });
+
+    toplevel.xdgSurf->setConfigure([&state, &toplevel](CCXdgSurface* p, uint32_t serial) {
+        toplevel.xdgSurf->sendAckConfigure(serial);
+
+        if (toplevel.configured)
+            return;
+
+        toplevel.xdgSurf->sendSetWindowGeometry(0, 0, SIZE, SIZE);
+        toplevel.surf->sendAttach(state.shmBuf.get(), 0, 0);
+        toplevel.surf->sendCommit();
+        toplevel.configured = true;
+
+        if (++state.configured == state.toplevels.size()) {
+            std::println("started");
+            std::fflush(stdout);
+        }
+    });
+
+    toplevel.xdgToplevel->sendSetTitle(std::format("tiled-windows {}", idx).c_str());
+    toplevel.xdgToplevel->sendSetAppId("tiled-windows");
+
+    toplevel.surf->sendAttach(nullptr, 0, 0);
+    toplevel.surf->sendCommit();
+
+    return true;
+}
+
+int main(int argc, char** argv) {
+    if (argc != 2 && argc != 3) {
+        std::println("Usage: tiled-windows <count> [first title index]");
+        return -1;
+    }
+
+    SWlState     state;
+    const size_t FIRST = argc == 3 ? std::stoul(argv[2]) : 0;
+    state.toplevels.resize(std::stoul(argv[1]));
+
+    // WAYLAND_DISPLAY env should be set to the correct one
+    state.display = wl_display_connect(nullptr);
+    if (!state.display) {
+        std::println("Failed to connect to wayland display");
+        return -1;
+    }
+
+    if (!bindRegistry(state) || !createShm(state))
+        return -1;
+
+    state.xdgShell->setPing([&](CCXdgWmBase* p, uint32_t serial) { state.xdgShell->sendPong(serial); });
+
+    for (size_t i = 0; i < state.toplevels.size(); ++i) {
+        if (!createToplevel(state, state.toplevels[i], FIRST + i))
+            return -1;
+    }
+
+    while (wl_display_dispatch(state.display) != -1) {
+        ;
+    }
+
+    wl_display* display = state.display;
+    state               = {};
+
+    wl_display_disconnect(display);
+    return 0;
+}
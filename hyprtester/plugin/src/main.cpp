@@ -2,19 +2,37 @@
 #include <src/includes.hpp>
 #include <sstream>
 #include <any>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <numbers>
 
 #define private public
 #include <src/config/ConfigManager.hpp>
 #include <src/config/ConfigDescriptions.hpp>
 #include <src/layout/IHyprLayout.hpp>
 #include <src/managers/LayoutManager.hpp>
+#include <src/managers/KeybindManager.hpp>
 #include <src/managers/input/InputManager.hpp>
 #include <src/managers/PointerManager.hpp>
 #include <src/managers/input/trackpad/TrackpadGestures.hpp>
 #include <src/desktop/rule/windowRule/WindowRuleEffectContainer.hpp>
 #include <src/desktop/rule/windowRule/WindowRuleApplicator.hpp>
+#include <src/desktop/rule/windowRule/WindowRule.hpp>
+#include <src/desktop/rule/Engine.hpp>
 #include <src/Compositor.hpp>
 #include <src/desktop/state/FocusState.hpp>
+#include <src/desktop/state/HitTestIndex.hpp>
+#include <src/debug/HyprCtl.hpp>
+#include <src/protocols/core/Compositor.hpp>
+#include <src/protocols/core/Subcompositor.hpp>
+#include <src/render/OpenGL.hpp>
+#include <src/render/ProgramCache.hpp>
+#include <src/render/Renderer.hpp>
+#include <src/render/decorations/CHyprGroupBarDecoration.hpp>
+#include <src/helpers/MonitorFrameScheduler.hpp>
 #undef private
 
 #include <hyprutils/utils/ScopeGuard.hpp>
@@ -274,6 +292,1318 @@ static SDispatchResult checkRule(std::string in) {
     return {};
 }
 
+constexpr size_t PLUGIN_HYPRCTL_COMMANDS = 100;
+
+static std::string pluginCommand(eHyprCtlOutputFormat format, std::string request) {
+    return "plugin:" + request;
+}
+
+// resolves every registered hyprctl command through the index and the old linear scan, and reports both
+static std::string benchCommands(eHyprCtlOutputFormat format, std::string request) {
+    constexpr size_t ITERATIONS = 1000;
+
+    const auto       LINEAR = [](const std::string& rq) -> SP<SHyprCtlCommand> {
+        for (const auto& cmd : g_pHyprCtl->m_commands) {
+            if (cmd->exact && cmd->name == rq)
+                return cmd;
+        }
+
+        for (const auto& cmd : g_pHyprCtl->m_commands) {
+            if (!cmd->exact && rq.starts_with(cmd->name))
+                return cmd;
+        }
+
+        return nullptr;
+    };
+
+    std::vector<std::string> requests;
+    for (const auto& cmd : g_pHyprCtl->m_commands) {
+        requests.emplace_back(cmd->exact ? cmd->name : cmd->name + " arg");
+    }
+    requests.emplace_back("nonexistentrequest");
+
+    for (const auto& rq : requests) {
+        if (g_pHyprCtl->findCommand(rq) != LINEAR(rq))
+            return std::format("error: {} resolved to a different command", rq);
+    }
+
+    const auto TIME = [&requests](auto&& fn) {
+        size_t     found = 0;
+        const auto BEGIN = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < ITERATIONS; ++i) {
+            for (const auto& rq : requests) {
+                found += !!fn(rq);
+            }
+        }
+        const auto NS = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - BEGIN).count();
+        return found ? NS / (ITERATIONS * requests.size()) : 0.0;
+    };
+
+    const auto INDEXED = TIME([](const std::string& rq) { return g_pHyprCtl->findCommand(rq); });
+    const auto SCANNED = TIME(LINEAR);
+
+    return std::format("ok: {} commands, indexed {:.1f}ns, linear {:.1f}ns per lookup", g_pHyprCtl->m_commands.size(), INDEXED, SCANNED);
+}
+
+// the pre-CJSONWriter window serialization, kept as a reference for the output of the current one
+static std::string legacyWindowJSON(PHLWINDOW w) {
+    auto getFocusHistoryID = [](PHLWINDOW wnd) -> int {
+        for (size_t i = 0; i < Desktop::focusState()->windowHistory().size(); ++i) {
+            if (Desktop::focusState()->windowHistory()[i].lock() == wnd)
+                return i;
+        }
+        return -1;
+    };
+
+    std::string grouped;
+    if (!w->m_groupData.pNextWindow.expired()) {
+        PHLWINDOW head = w->getGroupHead();
+        PHLWINDOW curr = head;
+        while (true) {
+            grouped += std::format("\"0x{:x}\"", rc<uintptr_t>(curr.get()));
+            curr = curr->m_groupData.pNextWindow.lock();
+            if (curr == head)
+                break;
+            grouped += ", ";
+        }
+    }
+
+    const auto tags = std::ranges::fold_left(w->m_ruleApplicator->m_tagKeeper.getTags(), std::string(),
+                                             [](const std::string& a, const std::string& b) { return a.empty() ? std::format("\"{}\"", b) : std::format("{}, \"{}\"", a, b); });
+
+    return std::format(
+        R"#({{
+    "address": "0x{:x}",
+    "mapped": {},
+    "hidden": {},
+    "at": [{}, {}],
+    "size": [{}, {}],
+    "workspace": {{
+        "id": {},
+        "name": "{}"
+    }},
+    "floating": {},
+    "pseudo": {},
+    "monitor": {},
+    "class": "{}",
+    "title": "{}",
+    "initialClass": "{}",
+    "initialTitle": "{}",
+    "pid": {},
+    "xwayland": {},
+    "pinned": {},
+    "fullscreen": {},
+    "fullscreenClient": {},
+    "grouped": [{}],
+    "tags": [{}],
+    "swallowing": "0x{:x}",
+    "focusHistoryID": {},
+    "inhibitingIdle": {},
+    "xdgTag": "{}",
+    "xdgDescription": "{}",
+    "contentType": "{}"
+}},)#",
+        rc<uintptr_t>(w.get()), (w->m_isMapped ? "true" : "false"), (w->isHidden() ? "true" : "false"), sc<int>(w->m_realPosition->goal().x), sc<int>(w->m_realPosition->goal().y),
+        sc<int>(w->m_realSize->goal().x), sc<int>(w->m_realSize->goal().y), w->m_workspace ? w->workspaceID() : WORKSPACE_INVALID,
+        escapeJSONStrings(!w->m_workspace ? "" : w->m_workspace->m_name), (sc<int>(w->m_isFloating) == 1 ? "true" : "false"), (w->m_isPseudotiled ? "true" : "false"),
+        w->monitorID(), escapeJSONStrings(w->m_class), escapeJSONStrings(w->m_title), escapeJSONStrings(w->m_initialClass), escapeJSONStrings(w->m_initialTitle), w->getPID(),
+        (sc<int>(w->m_isX11) == 1 ? "true" : "false"), (w->m_pinned ? "true" : "false"), sc<uint8_t>(w->m_fullscreenState.internal), sc<uint8_t>(w->m_fullscreenState.client),
+        grouped, tags, rc<uintptr_t>(w->m_swallowed.get()), getFocusHistoryID(w), (g_pInputManager->isWindowInhibiting(w, false) ? "true" : "false"),
+        escapeJSONStrings(w->xdgTag().value_or("")), escapeJSONStrings(w->xdgDescription().value_or("")), escapeJSONStrings(NContentType::toString(w->getContentType())));
+}
+
+// checks the streaming serializer against the legacy one, and reports the cost of both for all windows
+static std::string benchJSON(eHyprCtlOutputFormat format, std::string request) {
+    constexpr size_t ITERATIONS = 100;
+
+    std::string      escapeTest;
+    for (int i = 0; i < 256; ++i) {
+        escapeTest += sc<char>(i);
+    }
+    escapeTest += "\"quoted\" back\\slash ünïcödé";
+
+    if (std::format("{}", jsonEscaped(escapeTest)) != escapeJSONStrings(escapeTest))
+        return "error: jsonEscaped doesn't match escapeJSONStrings";
+
+    std::string legacy = "[";
+    for (const auto& w : g_pCompositor->m_windows) {
+        legacy += legacyWindowJSON(w);
+    }
+    if (legacy.back() == ',')
+        legacy.pop_back();
+    legacy += "]";
+
+    if (legacy != g_pHyprCtl->getReply("ja/clients"))
+        return "error: clients output differs from the legacy serializer";
+
+    const auto TIME = [](auto&& fn) {
+        const auto BEGIN = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < ITERATIONS; ++i) {
+            fn();
+        }
+        return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - BEGIN).count() / ITERATIONS;
+    };
+
+    const auto CURRENT = TIME([] { return g_pHyprCtl->getReply("ja/clients"); });
+    const auto LEGACY  = TIME([] {
+        std::string out = "[";
+        for (const auto& w : g_pCompositor->m_windows) {
+            out += legacyWindowJSON(w);
+        }
+        return out;
+    });
+
+    return std::format("ok: {} windows, {} bytes, current {:.1f}us, legacy {:.1f}us per call", g_pCompositor->m_windows.size(), legacy.size(), CURRENT, LEGACY);
+}
+
+// the synchronous logger this replaced, writing to /dev/null instead of the log file
+static void legacyLog(std::ofstream& ofs, std::string& rollingLog, const std::string& msg) {
+    static std::mutex           logMutex;
+    std::lock_guard<std::mutex> guard(logMutex);
+
+    static auto                 current_zone = std::chrono::current_zone();
+    const auto                  zt           = std::chrono::zoned_time{current_zone, std::chrono::system_clock::now()};
+    const auto                  hms          = std::chrono::hh_mm_ss{zt.get_local_time() - std::chrono::floor<std::chrono::days>(zt.get_local_time())};
+    const auto                  str          = std::format("[TRACE] [{}] {}", hms, msg);
+
+    rollingLog += str + "\n";
+    if (rollingLog.size() > ROLLING_LOG_SIZE)
+        rollingLog = rollingLog.substr(rollingLog.size() - ROLLING_LOG_SIZE);
+
+    ofs << str << "\n";
+    ofs.flush();
+}
+
+// reports the per call cost of trace logging, and checks the rolling log caught up with it
+static std::string benchLog(eHyprCtlOutputFormat format, std::string request) {
+    constexpr size_t ITERATIONS = 2000;
+
+    const auto       TIME = [](auto&& fn) {
+        const auto BEGIN = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < ITERATIONS; ++i) {
+            fn(i);
+        }
+        return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - BEGIN).count() / ITERATIONS;
+    };
+
+    const bool WASTRACE = Debug::m_trace;
+
+    Debug::m_trace      = false;
+    const auto DISABLED = TIME([](size_t i) { Debug::log(TRACE, "plugintestlogbench {}", i); });
+    Debug::m_trace      = true;
+    const auto ENABLED  = TIME([](size_t i) { Debug::log(TRACE, "plugintestlogbench {}", i); });
+    Debug::m_trace      = WASTRACE;
+
+    std::ofstream devNull("/dev/null");
+    std::string   rollingLog;
+    const auto    LEGACY = TIME([&](size_t i) { legacyLog(devNull, rollingLog, std::format("plugintestlogbench {}", i)); });
+
+    if (!Debug::rollingLog().contains(std::format("plugintestlogbench {}\n", ITERATIONS - 1)))
+        return "error: rolling log is missing the last line";
+
+    if (Debug::rollingLog().size() > ROLLING_LOG_SIZE)
+        return "error: rolling log is over its size";
+
+    // what the crash reporter uses, with nothing holding the writer's lock it has to catch up too
+    Debug::log(LOG, "plugintestlogbench crash tail");
+    if (!Debug::rollingLogNoWait().contains("plugintestlogbench crash tail\n"))
+        return "error: rolling log for crashes is missing the last line";
+
+    return std::format("ok: trace off {:.1f}ns, trace on {:.1f}ns, legacy {:.1f}ns per call", DISABLED, ENABLED, LEGACY);
+}
+
+static size_t nopCalls = 0;
+
+static SDispatchResult nop(std::string in) {
+    nopCalls++;
+    return {};
+}
+
+// replays a keystroke trace against generated configs of growing size, and checks the right binds fired
+static std::string benchKeybinds(eHyprCtlOutputFormat format, std::string request) {
+    constexpr size_t         TRACE_LENGTH = 5000;
+
+    std::vector<std::string> keys;
+    for (char c = 'a'; c <= 'z'; ++c) {
+        keys.emplace_back(1, c);
+    }
+    for (char c = '0'; c <= '9'; ++c) {
+        keys.emplace_back(1, c);
+    }
+    for (int i = 1; i <= 24; ++i) {
+        keys.emplace_back(std::format("F{}", i));
+    }
+    keys.insert(keys.end(), {"space", "Return", "Tab", "Escape"});
+
+    // every combination of these, so 16 * 64 possible binds
+    constexpr std::array<uint32_t, 4> MODS = {HL_MODIFIER_SHIFT, HL_MODIFIER_CTRL, HL_MODIFIER_ALT, HL_MODIFIER_META};
+
+    const auto                        SAVED  = g_pKeybindManager->m_keybinds;
+    std::string                       result = "ok:";
+
+    for (const size_t BINDS : {10, 100, 1000}) {
+        g_pKeybindManager->clearKeybinds();
+        for (size_t i = 0; i < BINDS; ++i) {
+            uint32_t modmask = 0;
+            for (size_t m = 0; m < MODS.size(); ++m) {
+                if ((i / keys.size()) & (1 << m))
+                    modmask |= MODS[m];
+            }
+
+            g_pKeybindManager->addKeybind(SKeybind{.key = keys[i % keys.size()], .modmask = modmask, .handler = "plugin:test:nop"});
+        }
+
+        // same pseudo random trace for every size, a fraction of it hits no bind at all
+        uint32_t seed     = 42;
+        size_t   expected = 0;
+        nopCalls          = 0;
+
+        const auto BEGIN = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < TRACE_LENGTH; ++i) {
+            seed              = seed * 1664525 + 1013904223;
+            const size_t BIND = (seed >> 8) % 1024;
+            uint32_t     mods = 0;
+            for (size_t m = 0; m < MODS.size(); ++m) {
+                if ((BIND / keys.size()) & (1 << m))
+                    mods |= MODS[m];
+            }
+
+            const auto KEY = SPressedKeyWithMods{
+                .keysym             = xkb_keysym_from_name(keys[BIND % keys.size()].c_str(), XKB_KEYSYM_NO_FLAGS),
+                .modmaskAtPressTime = mods,
+            };
+
+            g_pKeybindManager->handleKeybinds(mods, KEY, true, nullptr);
+            g_pKeybindManager->handleKeybinds(mods, KEY, false, nullptr);
+
+            expected += BIND < BINDS;
+        }
+        const auto NS = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - BEGIN).count() / (TRACE_LENGTH * 2);
+
+        if (nopCalls != expected) {
+            result = std::format("error: {} binds fired {} times, expected {}", BINDS, nopCalls, expected);
+            break;
+        }
+
+        result += std::format(" {} binds {:.1f}ns,", BINDS, NS);
+    }
+
+    // some plugins push binds straight into m_keybinds, after the index was built. Those have to fire too.
+    const auto A = SPressedKeyWithMods{.keysym = XKB_KEY_a};
+    g_pKeybindManager->clearKeybinds();
+    g_pKeybindManager->handleKeybinds(0, A, true, nullptr);
+    g_pKeybindManager->m_keybinds.emplace_back(makeShared<SKeybind>(SKeybind{.key = "a", .handler = "plugin:test:nop"}));
+    nopCalls = 0;
+    g_pKeybindManager->handleKeybinds(0, A, true, nullptr);
+    g_pKeybindManager->handleKeybinds(0, A, false, nullptr);
+
+    if (nopCalls != 1 && result.starts_with("ok"))
+        result = "error: a bind added without addKeybind didn't fire";
+
+    g_pKeybindManager->clearKeybinds();
+    g_pKeybindManager->m_keybinds = SAVED;
+
+    if (result.starts_with("ok"))
+        result.back() = ' ';
+
+    return result + "per key event";
+}
+
+// focus switches with 500 rules over 200 windows. The active window stands in for all of them by cycling its class.
+static std::string benchRules(eHyprCtlOutputFormat format, std::string request) {
+    constexpr size_t RULES   = 500;
+    constexpr size_t WINDOWS = 200;
+
+    const auto       PWINDOW = Desktop::focusState()->window();
+    if (!PWINDOW)
+        return "error: no window";
+
+    // every tenth rule only applies to the focused window
+    for (size_t i = 0; i < RULES; ++i) {
+        auto rule = makeShared<Desktop::Rule::CWindowRule>("plugintestrulebench");
+        rule->registerMatch(Desktop::Rule::RULE_PROP_CLASS, std::format("^benchwindow{}$", i % WINDOWS));
+
+        if (i % 10 == 0) {
+            rule->registerMatch(Desktop::Rule::RULE_PROP_FOCUS, "1");
+            rule->addEffect(Desktop::Rule::WINDOW_RULE_EFFECT_BORDER_SIZE, std::to_string(i % 7));
+        } else {
+            rule->addEffect(Desktop::Rule::WINDOW_RULE_EFFECT_OPACITY, "0.9 0.8");
+            rule->addEffect(Desktop::Rule::WINDOW_RULE_EFFECT_ROUNDING, std::to_string(i % 20));
+            if (i % 5 == 0)
+                rule->addEffect(Desktop::Rule::WINDOW_RULE_EFFECT_BORDER_SIZE, "2");
+        }
+
+        Desktop::Rule::ruleEngine()->registerRule(std::move(rule));
+    }
+
+    const auto  CLASS      = PWINDOW->m_class;
+    const auto& APPLICATOR = PWINDOW->m_ruleApplicator;
+    std::string error;
+    double      focusNS = 0, fullNS = 0;
+
+    for (size_t i = 0; i < WINDOWS; ++i) {
+        PWINDOW->m_class = std::format("benchwindow{}", i);
+        APPLICATOR->propertiesChanged(Desktop::Rule::RULE_PROP_CLASS);
+
+        // a focus switch rechecks the window losing focus and the one gaining it
+        auto begin = std::chrono::steady_clock::now();
+        APPLICATOR->propertiesChanged(Desktop::Rule::RULE_PROP_FOCUS);
+        APPLICATOR->propertiesChanged(Desktop::Rule::RULE_PROP_FOCUS);
+        focusNS += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - begin).count();
+
+        const auto BORDER   = APPLICATOR->borderSize().valueOrDefault();
+        const auto ROUNDING = APPLICATOR->rounding().valueOrDefault();
+
+        begin = std::chrono::steady_clock::now();
+        APPLICATOR->propertiesChanged(Desktop::Rule::RULE_PROP_ALL);
+        fullNS += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - begin).count();
+
+        // rechecking only what depends on focus has to end up where rechecking everything does
+        if (BORDER != APPLICATOR->borderSize().valueOrDefault() || ROUNDING != APPLICATOR->rounding().valueOrDefault()) {
+            error = std::format("error: benchwindow{} ended with border {} rounding {}, expected {} and {}", i, BORDER, ROUNDING, APPLICATOR->borderSize().valueOrDefault(),
+                                APPLICATOR->rounding().valueOrDefault());
+            break;
+        }
+    }
+
+    PWINDOW->m_class = CLASS;
+    Desktop::Rule::ruleEngine()->unregisterRule("plugintestrulebench");
+    APPLICATOR->propertiesChanged(Desktop::Rule::RULE_PROP_ALL);
+
+    if (!error.empty())
+        return error;
+
+    return std::format("ok: {} rules, {} windows: focus switch {:.1f}us, full recheck {:.1f}us", RULES, WINDOWS, focusNS / WINDOWS / 1000.0, fullNS / WINDOWS / 1000.0);
+}
+
+static std::string benchHitTest(eHyprCtlOutputFormat format, std::string request) {
+    constexpr size_t STEPS = 64;
+
+    const auto       PMONITOR = Desktop::focusState()->monitor();
+    if (!PMONITOR)
+        return "error: no monitor";
+
+    // a pointer sweeping the monitor row by row, back and forth
+    std::vector<Vector2D> trace;
+    for (size_t y = 0; y < STEPS; ++y) {
+        for (size_t x = 0; x < STEPS; ++x) {
+            const auto COL = y % 2 == 0 ? x : STEPS - 1 - x;
+            trace.emplace_back(PMONITOR->m_position + PMONITOR->m_size * Vector2D{(COL + 0.5) / STEPS, (y + 0.5) / STEPS});
+        }
+    }
+
+    const auto INDEX  = Desktop::hitTestIndex();
+    const auto BEFORE = INDEX->stats();
+    size_t     hits   = 0;
+
+    const auto BEGIN = std::chrono::steady_clock::now();
+    for (const auto& POS : trace) {
+        if (g_pCompositor->vectorToWindowUnified(POS, RESERVED_EXTENTS | INPUT_EXTENTS | ALLOW_FLOATING))
+            hits++;
+    }
+    const auto NS = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - BEGIN).count();
+
+    const auto AFTER = INDEX->stats();
+
+    // the index may only leave out windows that can't be under the point
+    for (const auto& POS : trace) {
+        const auto CANDIDATES = INDEX->candidatesAt(POS, POS);
+
+        for (const auto& w : g_pCompositor->m_windows) {
+            if (!w->m_isMapped || w->isHidden())
+                continue;
+
+            const auto BOX = w->getWindowBoxUnified(RESERVED_EXTENTS | INPUT_EXTENTS);
+            if ((BOX.containsPoint(POS) || CBox{w->m_position, w->m_size}.containsPoint(POS)) && std::ranges::find(CANDIDATES, w) == CANDIDATES.end())
+                return std::format("error: {} is under {} but not a candidate", w, POS);
+        }
+    }
+
+    const auto QUERIES = AFTER.queries - BEFORE.queries;
+
+    return std::format("ok: {} windows, {} points, {} hits: {:.2f}us per lookup, {:.1f} candidates per lookup, {} rebuilds", g_pCompositor->m_windows.size(), trace.size(),
+                       hits, NS / trace.size() / 1000.0, QUERIES ? sc<double>(AFTER.candidates - BEFORE.candidates) / QUERIES : 0.0, AFTER.rebuilds - BEFORE.rebuilds);
+}
+
+static std::string hitTestAfterWarp(eHyprCtlOutputFormat format, std::string request) {
+    // the topmost floating window, so nothing else can be in the way where it lands
+    PHLWINDOW window;
+    for (const auto& w : g_pCompositor->m_windows) {
+        if (w->m_isMapped && !w->isHidden() && w->m_isFloating)
+            window = w;
+    }
+
+    if (!window)
+        return "error: no floating window";
+
+    const auto PMONITOR = window->m_monitor.lock();
+    const auto OLDPOS   = window->m_realPosition->value();
+    const auto SIZE     = window->m_realSize->value();
+
+    // build the grid with the window where it is
+    g_pCompositor->vectorToWindowUnified(OLDPOS + SIZE / 2.0, RESERVED_EXTENTS | INPUT_EXTENTS | ALLOW_FLOATING);
+
+    // gestures warp like this without the layout or decorations hearing about it
+    const auto TARGET = PMONITOR->m_position + PMONITOR->m_size - SIZE - Vector2D{10, 10};
+    window->m_realPosition->setValueAndWarp(TARGET);
+
+    const auto FOUND = g_pCompositor->vectorToWindowUnified(TARGET + SIZE / 2.0, RESERVED_EXTENTS | INPUT_EXTENTS | ALLOW_FLOATING);
+
+    window->m_realPosition->setValueAndWarp(OLDPOS);
+
+    if (FOUND != window)
+        return std::format("error: warped {} to {}, the point over it found {}", window, TARGET, FOUND);
+
+    return "ok";
+}
+
+static std::string benchMotion(eHyprCtlOutputFormat format, std::string request) {
+    constexpr size_t EVENTS = 1000;
+
+    const auto       BEFORE = g_pInputManager->m_motionStats;
+    const auto       BEGIN  = std::chrono::steady_clock::now();
+
+    // a high polling rate mouse wiggling in small circles
+    for (size_t i = 0; i < EVENTS; ++i) {
+        const double ANGLE = sc<double>(i) * 2.0 * std::numbers::pi / 100.0;
+        const auto   DELTA = Vector2D{std::cos(ANGLE), std::sin(ANGLE)} * 2.0;
+        g_mouse->m_pointerEvents.motion.emit(IPointer::SMotionEvent{.timeMs = sc<uint32_t>(i), .delta = DELTA, .unaccel = DELTA, .mouse = true, .device = g_mouse});
+    }
+
+    const auto NS = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - BEGIN).count();
+
+    // a full pass at the final position has to agree with what the held back motion told the client
+    const auto SENT = g_pSeatManager->m_lastLocalCoords;
+    g_pInputManager->flushCoalescedMotion();
+
+    if (SENT.distance(g_pSeatManager->m_lastLocalCoords) > 0.01)
+        return std::format("error: coalesced motion sent {}, a full pass sent {}", SENT, g_pSeatManager->m_lastLocalCoords);
+
+    const auto AFTER = g_pInputManager->m_motionStats;
+
+    return std::format("ok: {} motion events received, {} focus evaluations, {:.2f}us per event", AFTER.received - BEFORE.received, AFTER.evaluated - BEFORE.evaluated,
+                       NS / EVENTS / 1000.0);
+}
+
+static std::string benchBlur(eHyprCtlOutputFormat format, std::string request) {
+    constexpr int ITERATIONS = 20;
+
+    const auto    PMONITOR = Desktop::focusState()->monitor();
+    if (!PMONITOR)
+        return "error: no monitor";
+
+    static auto PBLURPASSES  = CConfigValue<Hyprlang::INT>("decoration:blur:passes");
+    const auto  PASSESBEFORE = *PBLURPASSES;
+
+    g_pHyprRenderer->makeEGLCurrent();
+
+    CFramebuffer out;
+    out.alloc(PMONITOR->m_pixelSize.x, PMONITOR->m_pixelSize.y, PMONITOR->m_output->state->state().drmFormat);
+
+    CRegion damage{CBox{{}, PMONITOR->m_pixelSize}};
+    g_pHyprOpenGL->begin(PMONITOR, damage, &out);
+
+    CScopeGuard x([&] {
+        g_pHyprOpenGL->end();
+        out.release();
+        g_pConfigManager->parseKeyword("decoration:blur:passes", std::to_string(PASSESBEFORE));
+    });
+
+    std::string result = std::format("ok: {}x{}:", PMONITOR->m_pixelSize.x, PMONITOR->m_pixelSize.y);
+
+    for (int passes = 1; passes <= 8; ++passes) {
+        g_pConfigManager->parseKeyword("decoration:blur:passes", std::to_string(passes));
+
+        // warm up, so the mips get allocated outside of the timed part
+        CRegion blurDamage = damage;
+        g_pHyprOpenGL->blurMainFramebufferWithDamage(1.F, &blurDamage);
+        glFinish();
+
+        const auto BEGIN = std::chrono::steady_clock::now();
+        for (int i = 0; i < ITERATIONS; ++i) {
+            blurDamage = damage;
+            g_pHyprOpenGL->blurMainFramebufferWithDamage(1.F, &blurDamage);
+        }
+        glFinish();
+        const auto MS = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - BEGIN).count();
+
+        const auto& MIP      = g_pHyprOpenGL->m_renderData.pCurrentMonData->blurMipFBs[passes - 1];
+        const auto  EXPECTED = Vector2D{std::ceil(PMONITOR->m_pixelSize.x / (1 << passes)), std::ceil(PMONITOR->m_pixelSize.y / (1 << passes))};
+        if (MIP.m_size != EXPECTED)
+            return std::format("error: blur level {} is {}, expected {}", passes, MIP.m_size, EXPECTED);
+
+        result += std::format(" {} passes {:.3f}ms", passes, MS / ITERATIONS);
+    }
+
+    return result;
+}
+
+static std::string benchDamage(eHyprCtlOutputFormat format, std::string request) {
+    constexpr int ITERATIONS = 200;
+    constexpr int CELLS      = 8;
+    constexpr int CELL_SIZE  = 64;
+    constexpr int BOARD_SIZE = CELLS * CELL_SIZE;
+
+    const auto    PMONITOR = Desktop::focusState()->monitor();
+    if (!PMONITOR)
+        return "error: no monitor";
+
+    static auto PTHRESHOLD      = CConfigValue<Hyprlang::INT>("render:damage_batch_threshold");
+    const auto  THRESHOLDBEFORE = *PTHRESHOLD;
+
+    // a checkerboard, about as fragmented as damage gets
+    CRegion damage;
+    for (int y = 0; y < CELLS; ++y) {
+        for (int x = 0; x < CELLS; ++x) {
+            if ((x + y) % 2 == 0)
+                damage.add(CBox{x * CELL_SIZE, y * CELL_SIZE, CELL_SIZE, CELL_SIZE});
+        }
+    }
+
+    const CBox BOX = {CELL_SIZE / 2, CELL_SIZE / 2, BOARD_SIZE - CELL_SIZE, BOARD_SIZE - CELL_SIZE};
+
+    g_pHyprRenderer->makeEGLCurrent();
+
+    CFramebuffer out;
+    out.alloc(PMONITOR->m_pixelSize.x, PMONITOR->m_pixelSize.y, PMONITOR->m_output->state->state().drmFormat);
+
+    g_pHyprOpenGL->begin(PMONITOR, CRegion{CBox{{}, PMONITOR->m_pixelSize}}, &out);
+
+    CScopeGuard x([&] {
+        g_pHyprOpenGL->end();
+        out.release();
+        g_pConfigManager->parseKeyword("render:damage_batch_threshold", std::to_string(THRESHOLDBEFORE));
+    });
+
+    std::string                         result = std::format("ok: {} rects:", damage.getRects().size());
+    std::array<std::vector<uint8_t>, 2> pixels;
+
+    for (int batched = 0; batched <= 1; ++batched) {
+        g_pConfigManager->parseKeyword("render:damage_batch_threshold", batched ? "1" : "0");
+
+        g_pHyprOpenGL->clear(CHyprColor{0, 0, 0, 0});
+        glFinish();
+
+        const auto BEFORE = g_pHyprOpenGL->m_damageDrawStats;
+        const auto BEGIN  = std::chrono::steady_clock::now();
+        for (int i = 0; i < ITERATIONS; ++i) {
+            g_pHyprOpenGL->renderRect(BOX, CHyprColor{0.2, 0.4, 0.6, 0.8}, {.damage = &damage, .round = 20});
+        }
+        const auto US    = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - BEGIN).count();
+        const auto AFTER = g_pHyprOpenGL->m_damageDrawStats;
+
+        pixels[batched].resize(sc<size_t>(BOARD_SIZE) * BOARD_SIZE * 4);
+        glReadPixels(0, 0, BOARD_SIZE, BOARD_SIZE, GL_RGBA, GL_UNSIGNED_BYTE, pixels[batched].data());
+
+        result += std::format(" {}: {} draw calls, {:.2f}us submit per element", batched ? "batched" : "scissored", (AFTER.draws - BEFORE.draws) / ITERATIONS, US / ITERATIONS);
+    }
+
+    // both ways have to cover exactly the same pixels
+    for (size_t i = 0; i < pixels[0].size(); ++i) {
+        if (std::abs(sc<int>(pixels[0][i]) - sc<int>(pixels[1][i])) > 1)
+            return std::format("error: batched and scissored draws differ at pixel {}", i / 4);
+    }
+
+    return result;
+}
+
+static std::string benchShaderCache(eHyprCtlOutputFormat format, std::string request) {
+    auto& cache = *g_pHyprOpenGL->m_programCache;
+    if (!cache.enabled())
+        return "ok: disabled, nothing to check";
+
+    g_pHyprRenderer->makeEGLCurrent();
+
+    // sources no other run has cached
+    const auto RUN  = std::chrono::steady_clock::now().time_since_epoch().count();
+    const auto VERT = std::format("#version 300 es\n// plugintestshadercache {}\nin vec2 pos;\nvoid main() {{ gl_Position = vec4(pos, 0.0, 1.0); }}\n", RUN);
+    const auto FRAG = [RUN](float red) {
+        return std::format("#version 300 es\n// plugintestshadercache {}\nprecision highp float;\nout vec4 color;\nvoid main() {{ color = vec4({:.1f}, 0.0, 0.0, 1.0); }}\n", RUN, red);
+    };
+
+    const auto CREATE = [&](const std::string& frag, double& ms) {
+        const auto BEGIN = std::chrono::steady_clock::now();
+        const auto PROG  = g_pHyprOpenGL->createProgram(VERT, frag, true, true);
+        ms               = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - BEGIN).count();
+        if (PROG)
+            glDeleteProgram(PROG);
+        return PROG != 0;
+    };
+
+    const auto PATH  = cache.pathFor(cache.keyFor(VERT, FRAG(1.F)));
+    const auto OTHER = cache.pathFor(cache.keyFor(VERT, FRAG(0.F)));
+
+    CScopeGuard x([&] {
+        std::error_code ec;
+        std::filesystem::remove(PATH, ec);
+        std::filesystem::remove(OTHER, ec);
+    });
+
+    double coldMs = 0, warmMs = 0, ms = 0;
+
+    // cold: compiled and stored
+    auto before = cache.m_stats;
+    if (!CREATE(FRAG(1.F), coldMs) || cache.m_stats.misses != before.misses + 1 || !std::filesystem::exists(PATH))
+        return "error: a new program wasn't compiled and stored";
+
+    // warm, what the next start does: loaded back from disk and not compiled
+    before = cache.m_stats;
+    if (!CREATE(FRAG(1.F), warmMs) || cache.m_stats.hits != before.hits + 1 || cache.m_stats.misses != before.misses)
+        return "error: a stored program wasn't loaded back";
+
+    // a binary stored for other sources, has to be dropped and compiled again
+    if (!CREATE(FRAG(0.F), ms))
+        return "error: the second test program didn't compile";
+
+    std::error_code ec;
+    std::filesystem::copy_file(OTHER, PATH, std::filesystem::copy_options::overwrite_existing, ec);
+    if (ec)
+        return std::format("error: couldn't copy {}: {}", OTHER, ec.message());
+
+    before = cache.m_stats;
+    if (!CREATE(FRAG(1.F), ms) || cache.m_stats.rejected != before.rejected + 1 || cache.m_stats.misses != before.misses + 1)
+        return "error: a binary of other sources wasn't rejected, or nothing was compiled instead";
+
+    // and a truncated one, the compiled replacement stored above has to be rejected the same way
+    std::filesystem::resize_file(PATH, std::filesystem::file_size(PATH, ec) / 2, ec);
+    if (ec)
+        return std::format("error: couldn't truncate {}: {}", PATH, ec.message());
+
+    before = cache.m_stats;
+    if (!CREATE(FRAG(1.F), ms) || cache.m_stats.rejected != before.rejected + 1 || cache.m_stats.misses != before.misses + 1)
+        return "error: a truncated binary wasn't rejected, or nothing was compiled instead";
+
+    before = cache.m_stats;
+    if (!CREATE(FRAG(1.F), ms) || cache.m_stats.hits != before.hits + 1)
+        return "error: the program compiled after a rejection wasn't stored again";
+
+    // pruning keeps other drivers' entries until they age out
+    const auto ROOT    = std::filesystem::path{cache.m_dir}.parent_path();
+    const auto SIBLING = ROOT / "plugintestshadercache";
+    const auto ENTRY   = SIBLING / "0000000000000000.bin";
+
+    CScopeGuard y([&] {
+        std::error_code removeEc;
+        std::filesystem::remove_all(SIBLING, removeEc);
+    });
+
+    std::filesystem::create_directories(SIBLING, ec);
+    std::ofstream{ENTRY} << "plugintestshadercache";
+
+    cache.prune(ROOT.string());
+    if (!std::filesystem::exists(ENTRY))
+        return "error: pruning removed another driver's entry";
+
+    std::filesystem::last_write_time(ENTRY, std::filesystem::file_time_type::clock::now() - std::chrono::days{60}, ec);
+
+    cache.prune(ROOT.string());
+    if (std::filesystem::exists(ENTRY) || std::filesystem::exists(SIBLING))
+        return "error: pruning kept an entry unused for two months";
+
+    if (!std::filesystem::exists(PATH))
+        return "error: pruning removed a fresh entry";
+
+    return std::format("ok: cold {:.3f}ms, warm {:.3f}ms", coldMs, warmMs);
+}
+
+static std::string benchShaders(eHyprCtlOutputFormat format, std::string request) {
+    constexpr int ITERATIONS = 50;
+    constexpr int SIZE       = 1024;
+
+    const auto    PMONITOR = Desktop::focusState()->monitor();
+    if (!PMONITOR)
+        return "error: no monitor";
+
+    g_pHyprRenderer->makeEGLCurrent();
+
+    // something that isn't flat, so no driver can take shortcuts
+    std::vector<uint8_t> data(sc<size_t>(SIZE) * SIZE * 4);
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = sc<uint8_t>((i * 7) ^ (i >> 9));
+    }
+
+    const auto TEXRGBX = makeShared<CTexture>(DRM_FORMAT_XRGB8888, data.data(), SIZE * 4, Vector2D{SIZE, SIZE});
+    const auto TEXRGBA = makeShared<CTexture>(DRM_FORMAT_ARGB8888, data.data(), SIZE * 4, Vector2D{SIZE, SIZE});
+
+    CFramebuffer out;
+    out.alloc(PMONITOR->m_pixelSize.x, PMONITOR->m_pixelSize.y, PMONITOR->m_output->state->state().drmFormat);
+
+    const CRegion DAMAGE = CBox{{}, PMONITOR->m_pixelSize};
+    const CBox    BOX    = {0, 0, SIZE, SIZE};
+
+    g_pHyprOpenGL->begin(PMONITOR, DAMAGE, &out);
+
+    const auto VARIANTSBEFORE = g_pHyprOpenGL->m_useSurfaceVariants;
+    const auto TFBEFORE       = PMONITOR->m_imageDescription.transferFunction;
+
+    CScopeGuard x([&] {
+        g_pHyprOpenGL->end();
+        out.release();
+        g_pHyprOpenGL->m_useSurfaceVariants           = VARIANTSBEFORE;
+        PMONITOR->m_imageDescription.transferFunction = TFBEFORE;
+    });
+
+    struct SCase {
+        const char*  name;
+        SP<CTexture> tex;
+        int          round = 0;
+        bool         pq    = false;
+    };
+
+    const std::array<SCase, 3> CASES = {
+        SCase{.name = "opaque rgbx", .tex = TEXRGBX},
+        SCase{.name = "rounded rgba", .tex = TEXRGBA, .round = 40},
+        SCase{.name = "cm srgb->pq", .tex = TEXRGBA, .pq = true},
+    };
+
+    std::string result = "ok:";
+
+    for (const auto& c : CASES) {
+        if (c.pq && !g_pHyprOpenGL->m_cmSupported) {
+            result += std::format(" {}: skipped, no CM;", c.name);
+            continue;
+        }
+
+        PMONITOR->m_imageDescription.transferFunction = c.pq ? NColorManagement::CM_TRANSFER_FUNCTION_ST2084_PQ : TFBEFORE;
+
+        std::array<double, 2>               us;
+        std::array<std::vector<uint8_t>, 2> pixels;
+
+        for (int variants = 0; variants <= 1; ++variants) {
+            g_pHyprOpenGL->m_useSurfaceVariants = variants;
+
+            // first draw compiles the variant, keep that out of the timing
+            g_pHyprOpenGL->clear(CHyprColor{0, 0, 0, 0});
+            g_pHyprOpenGL->renderTexture(c.tex, BOX, {.damage = &DAMAGE, .round = c.round});
+            glFinish();
+
+            const auto BEGIN = std::chrono::steady_clock::now();
+            for (int i = 0; i < ITERATIONS; ++i) {
+                g_pHyprOpenGL->renderTexture(c.tex, BOX, {.damage = &DAMAGE, .round = c.round});
+            }
+            glFinish();
+            us[variants] = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - BEGIN).count() / ITERATIONS;
+
+            g_pHyprOpenGL->clear(CHyprColor{0, 0, 0, 0});
+            g_pHyprOpenGL->renderTexture(c.tex, BOX, {.damage = &DAMAGE, .round = c.round});
+            pixels[variants].resize(sc<size_t>(SIZE) * SIZE * 4);
+            glReadPixels(0, 0, SIZE, SIZE, GL_RGBA, GL_UNSIGNED_BYTE, pixels[variants].data());
+        }
+
+        // a variant has to render exactly what the generic shader does
+        for (size_t i = 0; i < pixels[0].size(); ++i) {
+            if (std::abs(sc<int>(pixels[0][i]) - sc<int>(pixels[1][i])) > 1)
+                return std::format("error: {}: variant and generic shader differ at pixel {}", c.name, i / 4);
+        }
+
+        result += std::format(" {}: generic {:.1f}us, variant {:.1f}us per draw;", c.name, us[0], us[1]);
+    }
+
+    result += std::format(" {} variants", g_pHyprOpenGL->m_shaders->m_shSurfaceVariants.size());
+
+    return result;
+}
+
+static std::string testDeadline(eHyprCtlOutputFormat format, std::string request) {
+    const auto PMONITOR = Desktop::focusState()->monitor();
+    if (!PMONITOR || !PMONITOR->m_frameScheduler)
+        return "error: no monitor";
+
+    auto&       scheduler = *PMONITOR->m_frameScheduler;
+    const auto  BEFORE    = scheduler.m_deadline;
+    const auto  BACKOFF   = scheduler.m_deadlineBackoff;
+    const auto  PRESENTED = scheduler.m_lastPresented;
+
+    static auto PMARGIN = CConfigValue<Hyprlang::FLOAT>("render:render_deadline_margin");
+
+    CScopeGuard x([&] {
+        scheduler.m_deadline        = BEFORE;
+        scheduler.m_deadlineBackoff = BACKOFF;
+        scheduler.m_lastPresented   = PRESENTED;
+    });
+
+    scheduler.m_deadline        = {};
+    scheduler.m_deadlineBackoff = 0;
+
+    // synthetic render load: a jittery mean, with an occasional spike
+    uint32_t   seed = 1;
+    const auto LOAD = [&](float mean) {
+        for (int i = 0; i < 300; ++i) {
+            seed           = seed * 1664525 + 1013904223;
+            const float MS = mean + ((seed >> 16) % 1000) / 1000.F - 0.5F + (i % 50 == 0 ? mean : 0.F);
+            scheduler.addRenderTimeSample(MS);
+        }
+    };
+
+    LOAD(6.F);
+    if (scheduler.m_deadline.estimateMs < 5.5F || scheduler.m_deadline.estimateMs > 8.F)
+        return std::format("error: estimate {:.2f}ms didn't converge to a 6ms load", scheduler.m_deadline.estimateMs);
+
+    LOAD(3.F);
+    if (scheduler.m_deadline.estimateMs < 2.5F || scheduler.m_deadline.estimateMs > 4.5F)
+        return std::format("error: estimate {:.2f}ms didn't settle to a 3ms load", scheduler.m_deadline.estimateMs);
+
+    // right after a vblank, the render should be held for whatever the estimate and margin don't need
+    scheduler.m_lastPresented = Time::steadyNow();
+    const auto  DELAY         = scheduler.deadlineDelayMs();
+    const float EXPECTED      = 1000.F / PMONITOR->m_refreshRate - scheduler.m_deadline.estimateMs - *PMARGIN;
+    if (std::abs(DELAY - EXPECTED) > 0.5F)
+        return std::format("error: delay {:.2f}ms, expected {:.2f}ms", DELAY, EXPECTED);
+
+    // a miss renders right away
+    scheduler.m_deadlineBackoff = 1;
+    if (scheduler.deadlineDelayMs() != 0.F)
+        return "error: render held back after a miss";
+
+    return std::format("ok: estimate {:.2f}ms, delay {:.2f}ms", scheduler.m_deadline.estimateMs, DELAY);
+}
+
+static std::string benchLayout(eHyprCtlOutputFormat format, std::string request) {
+    constexpr int ITERATIONS = 50;
+
+    const auto    PWINDOW = Desktop::focusState()->window();
+    if (!PWINDOW || PWINDOW->m_isFloating)
+        return "error: no tiled window focused";
+
+    const auto   PMONITOR = PWINDOW->m_monitor.lock();
+    const auto   LAYOUT   = g_pLayoutManager->getCurrentLayout();
+
+    const double AREA = PMONITOR->m_pixelSize.x * PMONITOR->m_pixelSize.y;
+
+    // runs fn ITERATIONS times, returns the time per run and the share of the monitor the first run damaged
+    const auto MEASURE = [&](auto&& fn) -> std::pair<double, double> {
+        CRegion pending = PMONITOR->m_damage.m_current;
+        PMONITOR->m_damage.m_current.clear();
+
+        CScopeGuard x([&] { PMONITOR->m_damage.m_current.add(pending); });
+
+        fn();
+
+        double damaged = 0;
+        for (const auto& r : PMONITOR->m_damage.m_current.getRects()) {
+            damaged += sc<double>(r.x2 - r.x1) * (r.y2 - r.y1);
+        }
+
+        const auto BEGIN = std::chrono::steady_clock::now();
+        for (int i = 1; i < ITERATIONS; ++i) {
+            fn();
+        }
+        const auto US = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - BEGIN).count();
+
+        return {US / (ITERATIONS - 1), damaged / AREA * 100.0};
+    };
+
+    // a split ratio moving back and forth
+    bool       grow  = true;
+    const auto RATIO = MEASURE([&] {
+        LAYOUT->alterSplitRatio(PWINDOW, grow ? 0.1F : -0.1F);
+        grow = !grow;
+    });
+    if (!grow)
+        LAYOUT->alterSplitRatio(PWINDOW, -0.1F);
+
+    // e.g. a size hint of one window changing
+    const auto WINDOW = MEASURE([&] { LAYOUT->recalculateWindow(PWINDOW); });
+
+    // nothing changed at all
+    const auto MONITOR = MEASURE([&] { LAYOUT->recalculateMonitor(PMONITOR->m_id); });
+
+    if (MONITOR.second > 0)
+        return std::format("error: recalculating an unchanged monitor damaged {:.1f}% of it", MONITOR.second);
+
+    // skipping unchanged windows has to end up where placing every window again does
+    std::vector<std::pair<PHLWINDOW, CBox>> goals;
+    for (const auto& w : g_pCompositor->m_windows) {
+        if (!w->m_isMapped || w->m_isFloating || w->m_workspace != PWINDOW->m_workspace)
+            continue;
+
+        goals.emplace_back(w, CBox{w->m_realPosition->goal(), w->m_realSize->goal()});
+    }
+
+    LAYOUT->invalidateTiledState();
+    LAYOUT->recalculateMonitor(PMONITOR->m_id);
+
+    for (const auto& [w, box] : goals) {
+        if (CBox{w->m_realPosition->goal(), w->m_realSize->goal()} != box)
+            return std::format("error: {} was at {} {}, a full recalculation put it at {} {}", w, box.pos(), box.size(), w->m_realPosition->goal(), w->m_realSize->goal());
+    }
+
+    return std::format("ok: {} {} tiled windows: split ratio {:.1f}us {:.1f}% damaged, window {:.1f}us {:.1f}% damaged, monitor {:.1f}us", goals.size(), LAYOUT->getLayoutName(),
+                       RATIO.first, RATIO.second, WINDOW.first, WINDOW.second, MONITOR.first);
+}
+
+static std::string benchLayoutLookup(eHyprCtlOutputFormat format, std::string request) {
+    constexpr int ITERATIONS = 200;
+
+    const auto    PWINDOW = Desktop::focusState()->window();
+    if (!PWINDOW || PWINDOW->m_isFloating)
+        return "error: no tiled window focused";
+
+    const auto               LAYOUT = g_pLayoutManager->getCurrentLayout();
+
+    std::vector<WORKSPACEID> workspaces;
+    for (const auto& w : g_pCompositor->m_windows) {
+        if (w->m_isMapped && !w->m_isFloating)
+            workspaces.emplace_back(w->workspaceID());
+    }
+
+    const auto TILED = workspaces.size();
+    std::ranges::sort(workspaces);
+    workspaces.erase(std::ranges::unique(workspaces).begin(), workspaces.end());
+
+    // a drag-resize, one small delta per mouse motion
+    bool grow  = true;
+    auto begin = std::chrono::steady_clock::now();
+    for (int i = 0; i < ITERATIONS; ++i) {
+        LAYOUT->resizeActiveWindow(grow ? Vector2D{2, 2} : Vector2D{-2, -2}, CORNER_NONE, PWINDOW);
+        grow = !grow;
+    }
+    const auto RESIZEUS = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - begin).count() / ITERATIONS;
+
+    // a window opening, as closing and opening the focused one again
+    begin = std::chrono::steady_clock::now();
+    for (int i = 0; i < ITERATIONS; ++i) {
+        LAYOUT->onWindowRemovedTiling(PWINDOW);
+        LAYOUT->onWindowCreatedTiling(PWINDOW);
+    }
+    const auto OPENUS = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - begin).count() / ITERATIONS;
+
+    // the lookup indices have to survive all that churn
+    for (const auto& w : g_pCompositor->m_windows) {
+        if (w->m_isMapped && !w->m_isFloating && !LAYOUT->isWindowTiled(w))
+            return std::format("error: {} has no layout node", w);
+    }
+
+    return std::format("ok: {} {} tiled windows on {} workspaces: drag-resize {:.1f}us, open {:.1f}us", TILED, LAYOUT->getLayoutName(), workspaces.size(), RESIZEUS, OPENUS);
+}
+
+static std::string benchGroupbar(eHyprCtlOutputFormat format, std::string request) {
+    constexpr int FRAMES = 60;
+
+    const auto    PWINDOW = Desktop::focusState()->window();
+    if (!PWINDOW || PWINDOW->m_groupData.pNextWindow.expired())
+        return "error: no grouped window focused";
+
+    IHyprWindowDecoration* groupbar = nullptr;
+    for (const auto& d : PWINDOW->m_windowDecorations) {
+        if (d->getDecorationType() == DECORATION_GROUPBAR)
+            groupbar = d.get();
+    }
+
+    if (!groupbar)
+        return "error: focused window has no groupbar";
+
+    const auto PMONITOR = PWINDOW->m_monitor.lock();
+
+    g_pHyprRenderer->makeEGLCurrent();
+    titleTexCache().clear();
+
+    // draw only queues pass elements, and those aren't ours to render
+    const auto DRAW = [&](int frames) {
+        const auto BEFORE = titleTexCache().stats().renders;
+        for (int i = 0; i < frames; ++i) {
+            groupbar->draw(PMONITOR, 1.F);
+            g_pHyprRenderer->m_renderPass.clear();
+        }
+        return titleTexCache().stats().renders - BEFORE;
+    };
+
+    const auto FIRST  = DRAW(1);
+    const auto BEGIN  = std::chrono::steady_clock::now();
+    const auto LATER  = DRAW(FRAMES);
+    const auto US     = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - BEGIN).count() / FRAMES;
+    const auto GROUPN = PWINDOW->getGroupSize();
+
+    if (LATER > 0)
+        return std::format("error: {} titles rendered again over {} unchanged frames", LATER, FRAMES);
+
+    return std::format("ok: {} grouped windows: {} renderText on the first frame, {:.2f} per frame after, {:.1f}us per frame", GROUPN, FIRST, sc<double>(LATER) / FRAMES, US);
+}
+
+static uint64_t totalAlpha(const SP<CTexture>& tex) {
+    GLint prevFb = 0;
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &prevFb);
+
+    GLuint fb = 0;
+    glGenFramebuffers(1, &fb);
+    glBindFramebuffer(GL_FRAMEBUFFER, fb);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, tex->m_texID, 0);
+
+    std::vector<uint8_t> pixels(sc<size_t>(tex->m_size.x * tex->m_size.y * 4));
+    glReadPixels(0, 0, tex->m_size.x, tex->m_size.y, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+
+    glBindFramebuffer(GL_FRAMEBUFFER, prevFb);
+    glDeleteFramebuffers(1, &fb);
+
+    uint64_t alpha = 0;
+    for (size_t i = 3; i < pixels.size(); i += 4) {
+        alpha += pixels[i];
+    }
+    return alpha;
+}
+
+static std::string benchText(eHyprCtlOutputFormat format, std::string request) {
+    constexpr int STRINGS = 1000;
+    constexpr int REPEATS = 100;
+    constexpr int PT      = 12;
+
+    static auto   FONT = CConfigValue<std::string>("misc:font_family");
+
+    // all distinct, nothing can come from a cache the first time around
+    std::vector<std::string> strings;
+    for (int i = 0; i < STRINGS; ++i) {
+        strings.emplace_back(std::format("window {} - title", i));
+    }
+
+    g_pHyprRenderer->makeEGLCurrent();
+
+    const auto MSSINCE = [](const auto& from) {
+        glFinish();
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - from).count();
+    };
+
+    auto&                     renderer = *g_pHyprOpenGL->m_textRenderer;
+    const auto&               STATS    = renderer.m_stats;
+    std::vector<SP<CTexture>> rasterized, drawn;
+
+    // every string rasterized whole, like it was before the atlas
+    const auto START = STATS;
+    auto       begin = std::chrono::steady_clock::now();
+    for (const auto& s : strings) {
+        rasterized.emplace_back(renderer.renderWithCairo({.text = s, .font = *FONT, .pt = PT}, Colors::WHITE));
+    }
+    const auto CAIROMS = MSSINCE(begin);
+
+    const auto BEFORE = STATS;
+
+    begin = std::chrono::steady_clock::now();
+    for (const auto& s : strings) {
+        drawn.emplace_back(g_pHyprOpenGL->renderText(s, Colors::WHITE, PT));
+    }
+    const auto ATLASMS = MSSINCE(begin);
+
+    // same size, and about the same ink. positions can be a pixel off from cairo's, so the alpha won't match exactly
+    for (size_t i = 0; i < drawn.size(); ++i) {
+        if (drawn[i]->m_size != rasterized[i]->m_size)
+            return std::format("error: \"{}\" came out {} from the atlas, {} from cairo", strings[i], drawn[i]->m_size, rasterized[i]->m_size);
+
+        const auto ATLASALPHA = sc<double>(totalAlpha(drawn[i]));
+        const auto CAIROALPHA = sc<double>(totalAlpha(rasterized[i]));
+        if (std::abs(ATLASALPHA - CAIROALPHA) > CAIROALPHA * 0.1)
+            return std::format("error: \"{}\" has {} alpha from the atlas, {} from cairo", strings[i], ATLASALPHA, CAIROALPHA);
+    }
+
+    const auto FROMATLAS  = STATS.atlasStrings - BEFORE.atlasStrings;
+    const auto GLYPHS     = STATS.glyphMisses - BEFORE.glyphMisses;
+    const auto CAIROBYTES = BEFORE.surfaceBytes - START.surfaceBytes;
+    const auto ATLASBYTES = STATS.surfaceBytes - BEFORE.surfaceBytes;
+
+    // the most recent strings again, these should need neither shaping nor new glyphs
+    const auto AGAIN = STATS;
+    begin            = std::chrono::steady_clock::now();
+    for (int i = STRINGS - REPEATS; i < STRINGS; ++i) {
+        g_pHyprOpenGL->renderText(strings[i], Colors::WHITE, PT);
+    }
+    const auto REPEATMS = MSSINCE(begin);
+
+    return std::format("ok: {} strings, {} from the atlas, {} glyphs rasterized, {} repeats shaped {} and rasterized {}; cairo {:.2f}ms {:.1f}MiB, atlas {:.2f}ms {:.1f}MiB, repeats {:.2f}ms",
+                       STRINGS, FROMATLAS, GLYPHS, REPEATS, STATS.shapeMisses - AGAIN.shapeMisses, STATS.glyphMisses - AGAIN.glyphMisses, CAIROMS, CAIROBYTES / 1048576.0, ATLASMS,
+                       ATLASBYTES / 1048576.0, REPEATMS);
+}
+
+static std::string benchShmUpload(eHyprCtlOutputFormat format, std::string request) {
+    constexpr int      W       = 3840;
+    constexpr int      H       = 2160;
+    constexpr int      STRIDE  = W * 4;
+    constexpr int      COMMITS = 30;
+    constexpr uint32_t FMT     = DRM_FORMAT_XRGB8888;
+
+    static auto        PASYNC      = CConfigValue<Hyprlang::INT>("render:async_shm_upload");
+    const auto         ASYNCBEFORE = *PASYNC;
+
+    g_pHyprRenderer->makeEGLCurrent();
+
+    std::vector<uint8_t> pixels(sc<size_t>(STRIDE) * H, 0);
+    const auto           TEX = makeShared<CTexture>(FMT, pixels.data(), STRIDE, Vector2D{W, H});
+
+    GLuint               fb = 0;
+    glGenFramebuffers(1, &fb);
+
+    CScopeGuard x([&] {
+        glDeleteFramebuffers(1, &fb);
+        g_pConfigManager->parseKeyword("render:async_shm_upload", std::to_string(ASYNCBEFORE));
+    });
+
+    std::string result = std::format("ok: {}x{} shm, main thread per commit:", W, H);
+
+    // a full frame, like a software rendered video, and a terminal-sized corner
+    const std::array<std::pair<const char*, CRegion>, 2> DAMAGES = {{{"full", CRegion{CBox{0, 0, W, H}}}, {"partial", CRegion{CBox{100, 100, 800, 600}}}}};
+
+    for (const auto& [name, damage] : DAMAGES) {
+        for (int async = 0; async <= 1; ++async) {
+            g_pConfigManager->parseKeyword("render:async_shm_upload", async ? "1" : "0");
+
+            const auto BEFORE = g_pHyprOpenGL->m_shmUploader->m_stats;
+            double     ms     = 0;
+
+            for (int i = 0; i < COMMITS; ++i) {
+                std::ranges::fill(pixels, sc<uint8_t>(i * 8 + async));
+
+                // nothing waits for the gpu in between, when it can't keep up the ring runs dry and commits go direct
+                const auto BEGIN = std::chrono::steady_clock::now();
+                TEX->update(FMT, pixels.data(), STRIDE, damage);
+                ms += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - BEGIN).count();
+            }
+
+            // whatever path it took, the last commit has to have landed
+            const auto             BOX = damage.getExtents();
+            std::array<uint8_t, 4> px  = {};
+            glBindFramebuffer(GL_FRAMEBUFFER, fb);
+            glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, TEX->m_texID, 0);
+            glReadPixels(sc<int>(BOX.x + BOX.w / 2), sc<int>(BOX.y + BOX.h / 2), 1, 1, GL_RGBA, GL_UNSIGNED_BYTE, px.data());
+            glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+            if (px[0] != pixels[0] || px[1] != pixels[1] || px[2] != pixels[2])
+                return std::format("error: {} {} upload: read back {},{},{}, expected {}", name, async ? "async" : "sync", px[0], px[1], px[2], pixels[0]);
+
+            const auto& STATS = g_pHyprOpenGL->m_shmUploader->m_stats;
+            result += std::format(" {} {} {:.3f}ms", name, async ? "async" : "sync", ms / COMMITS);
+            if (async)
+                result += std::format(" ({} through the ring, {} direct)", STATS.uploads - BEFORE.uploads, STATS.fallbacks - BEFORE.fallbacks);
+            result += ",";
+        }
+    }
+
+    result.pop_back();
+    return result;
+}
+
+static std::string surfaceStateStats(eHyprCtlOutputFormat format, std::string request) {
+    size_t allocated = 0, reused = 0;
+
+    for (const auto& surf : PROTO::compositor->m_surfaces) {
+        allocated += surf->m_stateQueue.m_stats.allocated;
+        reused    += surf->m_stateQueue.m_stats.reused;
+    }
+
+    return std::format("ok: {} surfaces, {} states queued, {} allocated", PROTO::compositor->m_surfaces.size(), allocated + reused, allocated);
+}
+
+// CWLSurfaceResource::breadthfirst as it was before the flattened tree cache: vectors per level, recursing every call
+static void legacyBreadthfirst(const std::vector<SP<CWLSurfaceResource>>& nodes, const std::function<void(SP<CWLSurfaceResource>, const Vector2D&)>& fn) {
+    std::vector<SP<CWLSurfaceResource>> nodes2;
+    nodes2.reserve(nodes.size() * 2);
+
+    for (auto const& n : nodes) {
+        std::erase_if(n->m_subsurfaces, [](const auto& e) { return e.expired(); });
+        for (auto const& c : n->m_subsurfaces) {
+            if (c->m_zIndex >= 0)
+                break;
+            if (c->m_surface.expired())
+                continue;
+            nodes2.push_back(c->m_surface.lock());
+        }
+    }
+
+    if (!nodes2.empty())
+        legacyBreadthfirst(nodes2, fn);
+
+    nodes2.clear();
+
+    for (auto const& n : nodes) {
+        Vector2D offset = {};
+        if (n->m_role->role() == SURFACE_ROLE_SUBSURFACE)
+            offset = sc<CSubsurfaceRole*>(n->m_role.get())->m_subsurface->posRelativeToParent();
+
+        fn(n, offset);
+    }
+
+    for (auto const& n : nodes) {
+        for (auto const& c : n->m_subsurfaces) {
+            if (c->m_zIndex < 0 || c->m_surface.expired())
+                continue;
+            nodes2.push_back(c->m_surface.lock());
+        }
+    }
+
+    if (!nodes2.empty())
+        legacyBreadthfirst(nodes2, fn);
+}
+
+static std::string benchSurfaceTree(eHyprCtlOutputFormat format, std::string request) {
+    constexpr int ITERATIONS = 10000;
+
+    PHLWINDOW     window;
+    for (const auto& w : g_pCompositor->m_windows) {
+        if (w->m_title.starts_with("commit-bench"))
+            window = w;
+    }
+
+    if (!window || !window->m_wlSurface || !window->m_wlSurface->resource())
+        return "error: no commit-bench window";
+
+    const auto ROOT = window->m_wlSurface->resource();
+
+    // same surfaces, same order, same offsets
+    std::vector<std::pair<CWLSurfaceResource*, Vector2D>> legacy, cached;
+    legacyBreadthfirst({ROOT}, [&legacy](SP<CWLSurfaceResource> s, const Vector2D& offset) { legacy.emplace_back(s.get(), offset); });
+    ROOT->breadthfirst([](SP<CWLSurfaceResource> s, const Vector2D& offset, void* d) { sc<decltype(cached)*>(d)->emplace_back(s.get(), offset); }, &cached);
+
+    if (legacy != cached)
+        return std::format("error: breadthfirst visited {} surfaces, used to visit {} in a different order", cached.size(), legacy.size());
+
+    // a change at the bottom of the tree drops the root's list, other trees keep theirs
+    SP<CWLSurfaceResource> other;
+    for (const auto& w : g_pCompositor->m_windows) {
+        if (w != window && w->m_wlSurface && w->m_wlSurface->resource())
+            other = w->m_wlSurface->resource();
+    }
+
+    const auto NOOP = [](const SP<CWLSurfaceResource>& s, const Vector2D& offset) { ; };
+    if (other)
+        other->forEachSurface(NOOP);
+
+    const auto ROOTGENERATION  = ROOT->m_flatTreeGeneration;
+    const auto OTHERGENERATION = other ? other->m_flatTreeGeneration : 0;
+
+    cached.back().first->invalidateTree();
+
+    ROOT->forEachSurface(NOOP);
+    if (ROOT->m_flatTreeGeneration == ROOTGENERATION)
+        return "error: invalidating a subsurface kept the root's cached tree";
+
+    if (other) {
+        other->forEachSurface(NOOP);
+        if (other->m_flatTreeGeneration != OTHERGENERATION)
+            return "error: invalidating one surface tree dropped another's";
+    }
+
+    const auto MSSINCE = [](const auto& from) { return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - from).count(); };
+
+    size_t     visited = 0;
+    auto       begin   = std::chrono::steady_clock::now();
+    for (int i = 0; i < ITERATIONS; ++i) {
+        legacyBreadthfirst({ROOT}, [&visited](SP<CWLSurfaceResource> s, const Vector2D& offset) { visited++; });
+    }
+    const auto LEGACYUS = MSSINCE(begin) / ITERATIONS;
+
+    begin = std::chrono::steady_clock::now();
+    for (int i = 0; i < ITERATIONS; ++i) {
+        ROOT->forEachSurface([&visited](const SP<CWLSurfaceResource>& s, const Vector2D& offset) { visited++; });
+    }
+    const auto CACHEDUS = MSSINCE(begin) / ITERATIONS;
+
+    // a miss has to test every surface
+    const auto OUTSIDE = ROOT->extends().size() + Vector2D{1, 1};
+    begin              = std::chrono::steady_clock::now();
+    for (int i = 0; i < ITERATIONS; ++i) {
+        ROOT->at(OUTSIDE);
+    }
+    const auto ATUS = MSSINCE(begin) / ITERATIONS;
+
+    return std::format("ok: {} surfaces: legacy breadthfirst {:.2f}us, cached {:.2f}us, at() {:.2f}us", cached.size(), LEGACYUS, CACHEDUS, ATUS);
+}
+
 APICALL EXPORT PLUGIN_DESCRIPTION_INFO PLUGIN_INIT(HANDLE handle) {
     PHANDLE = handle;
 
@@ -286,6 +1616,31 @@ APICALL EXPORT PLUGIN_DESCRIPTION_INFO PLUGIN_INIT(HANDLE handle) {
     HyprlandAPI::addDispatcherV2(PHANDLE, "plugin:test:keybind", ::keybind);
     HyprlandAPI::addDispatcherV2(PHANDLE, "plugin:test:add_rule", ::addRule);
     HyprlandAPI::addDispatcherV2(PHANDLE, "plugin:test:check_rule", ::checkRule);
+    HyprlandAPI::addDispatcherV2(PHANDLE, "plugin:test:nop", ::nop);
+
+    for (size_t i = 0; i < PLUGIN_HYPRCTL_COMMANDS; ++i) {
+        HyprlandAPI::registerHyprCtlCommand(PHANDLE, SHyprCtlCommand{.name = std::format("plugintestcmd{:03}", i), .exact = i % 2 == 0, .fn = ::pluginCommand});
+    }
+    HyprlandAPI::registerHyprCtlCommand(PHANDLE, SHyprCtlCommand{.name = "plugintestbench", .exact = true, .fn = ::benchCommands});
+    HyprlandAPI::registerHyprCtlCommand(PHANDLE, SHyprCtlCommand{.name = "plugintestjsonbench", .exact = true, .fn = ::benchJSON});
+    HyprlandAPI::registerHyprCtlCommand(PHANDLE, SHyprCtlCommand{.name = "plugintestlogbench", .exact = true, .fn = ::benchLog});
+    HyprlandAPI::registerHyprCtlCommand(PHANDLE, SHyprCtlCommand{.name = "plugintestkeybindbench", .exact = true, .fn = ::benchKeybinds});
+    HyprlandAPI::registerHyprCtlCommand(PHANDLE, SHyprCtlCommand{.name = "plugintestrulebench", .exact = true, .fn = ::benchRules});
+    HyprlandAPI::registerHyprCtlCommand(PHANDLE, SHyprCtlCommand{.name = "plugintesthittestbench", .exact = true, .fn = ::benchHitTest});
+    HyprlandAPI::registerHyprCtlCommand(PHANDLE, SHyprCtlCommand{.name = "plugintesthittestwarp", .exact = true, .fn = ::hitTestAfterWarp});
+    HyprlandAPI::registerHyprCtlCommand(PHANDLE, SHyprCtlCommand{.name = "plugintestmotionbench", .exact = true, .fn = ::benchMotion});
+    HyprlandAPI::registerHyprCtlCommand(PHANDLE, SHyprCtlCommand{.name = "plugintestblurbench", .exact = true, .fn = ::benchBlur});
+    HyprlandAPI::registerHyprCtlCommand(PHANDLE, SHyprCtlCommand{.name = "plugintestdamagebench", .exact = true, .fn = ::benchDamage});
+    HyprlandAPI::registerHyprCtlCommand(PHANDLE, SHyprCtlCommand{.name = "plugintestshadercache", .exact = true, .fn = ::benchShaderCache});
+    HyprlandAPI::registerHyprCtlCommand(PHANDLE, SHyprCtlCommand{.name = "plugintestshaderbench", .exact = true, .fn = ::benchShaders});
+    HyprlandAPI::registerHyprCtlCommand(PHANDLE, SHyprCtlCommand{.name = "plugintestdeadline", .exact = true, .fn = ::testDeadline});
+    HyprlandAPI::registerHyprCtlCommand(PHANDLE, SHyprCtlCommand{.name = "plugintestlayoutbench", .exact = true, .fn = ::benchLayout});
+    HyprlandAPI::registerHyprCtlCommand(PHANDLE, SHyprCtlCommand{.name = "plugintestlayoutlookupbench", .exact = true, .fn = ::benchLayoutLookup});
+    HyprlandAPI::registerHyprCtlCommand(PHANDLE, SHyprCtlCommand{.name = "plugintestgroupbarbench", .exact = true, .fn = ::benchGroupbar});
+    HyprlandAPI::registerHyprCtlCommand(PHANDLE, SHyprCtlCommand{.name = "plugintesttextbench", .exact = true, .fn = ::benchText});
+    HyprlandAPI::registerHyprCtlCommand(PHANDLE, SHyprCtlCommand{.name = "plugintestshmuploadbench", .exact = true, .fn = ::benchShmUpload});
+    HyprlandAPI::registerHyprCtlCommand(PHANDLE, SHyprCtlCommand{.name = "plugintestsurfacestatestats", .exact = true, .fn = ::surfaceStateStats});
+    HyprlandAPI::registerHyprCtlCommand(PHANDLE, SHyprCtlCommand{.name = "plugintestsurfacetreebench", .exact = true, .fn = ::benchSurfaceTree});
 
     // init mouse
     g_mouse = CTestMouse::create(false);
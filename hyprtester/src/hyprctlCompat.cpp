@@ -79,6 +79,30 @@ std::vector<SInstanceData> instances() {
     return result;
 }
 
+int connectToSocket(const std::string& socketName) {
+    const auto SERVERSOCKET = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+
+    if (SERVERSOCKET < 0)
+        return -1;
+
+    auto t = timeval{.tv_sec = 5, .tv_usec = 0};
+    setsockopt(SERVERSOCKET, SOL_SOCKET, SO_RCVTIMEO, &t, sizeof(struct timeval));
+
+    sockaddr_un serverAddress = {0};
+    serverAddress.sun_family  = AF_UNIX;
+
+    std::string socketPath = getRuntimeDir() + "/" + HIS + "/" + socketName;
+
+    strncpy(serverAddress.sun_path, socketPath.c_str(), sizeof(serverAddress.sun_path) - 1);
+
+    if (connect(SERVERSOCKET, rc<sockaddr*>(&serverAddress), SUN_LEN(&serverAddress)) < 0) {
+        close(SERVERSOCKET);
+        return -1;
+    }
+
+    return SERVERSOCKET;
+}
+
 std::string getFromSocket(const std::string& cmd) {
     const auto SERVERSOCKET = socket(AF_UNIX, SOCK_STREAM, 0);
 
@@ -13,4 +13,5 @@ struct SInstanceData {
 };
 
 std::vector<SInstanceData> instances();
-std::string                getFromSocket(const std::string& cmd);
\ No newline at end of file
+std::string                getFromSocket(const std::string& cmd);
+int                        connectToSocket(const std::string& socketName = ".socket.sock");
\ No newline at end of file
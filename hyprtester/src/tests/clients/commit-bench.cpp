@@ -0,0 +1,63 @@
+#include "../../shared.hpp"
+#include "../../hyprctlCompat.hpp"
+#include "../shared.hpp"
+#include "tests.hpp"
+#include "build.hpp"
+
+#include <hyprutils/os/Process.hpp>
+
+#include <csignal>
+#include <cstdio>
+#include <thread>
+
+using namespace Hyprutils::OS;
+using namespace Hyprutils::Memory;
+
+static int  ret = 0;
+
+static bool test() {
+    constexpr int SUBSURFACES = 8;
+    constexpr int ROUNDS      = 200;
+    constexpr int COMMITS     = ROUNDS * (SUBSURFACES + 1);
+
+    NLog::log("{}Testing surface state pooling", Colors::GREEN);
+
+    CProcess client(binaryDir + "/commit-bench", std::vector<std::string>{std::to_string(SUBSURFACES), std::to_string(ROUNDS)});
+    client.addEnv("WAYLAND_DISPLAY", WLDISPLAY);
+    client.runAsync();
+
+    // the client retitles itself once it's done committing
+    int         counter = 0;
+    std::string clients;
+    while (!(clients = getFromSocket("/clients")).contains("commit-bench done")) {
+        counter++;
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+        if (counter > 100) {
+            NLog::log("{}Timed out waiting for commit-bench to finish", Colors::RED);
+            kill(client.pid(), SIGKILL);
+            Tests::killAllWindows();
+            return false;
+        }
+    }
+
+    const auto TITLE = clients.substr(clients.find("commit-bench done"));
+    NLog::log("{}{}", Colors::YELLOW, TITLE.substr(0, TITLE.find('\n')));
+
+    const auto STATS = Tests::runBench("/plugintestsurfacestatestats");
+
+    size_t     surfaces = 0, queued = 0, allocated = 0;
+    if (STATS && sscanf(STATS->c_str(), "ok: %zu surfaces, %zu states queued, %zu allocated", &surfaces, &queued, &allocated) == 3) {
+        EXPECT(queued >= COMMITS, true);
+        // a handful per surface, not one per commit
+        EXPECT(allocated <= surfaces * 4, true);
+    } else
+        ret = 1;
+
+    kill(client.pid(), SIGKILL);
+    Tests::killAllWindows();
+
+    return !ret;
+}
+
+REGISTER_CLIENT_TEST_FN(test);
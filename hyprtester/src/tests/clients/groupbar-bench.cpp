@@ -0,0 +1,67 @@
+#include "../../shared.hpp"
+#include "../../hyprctlCompat.hpp"
+#include "../shared.hpp"
+#include "tests.hpp"
+#include "build.hpp"
+
+#include <hyprutils/os/Process.hpp>
+
+#include <csignal>
+#include <cstdio>
+
+using namespace Hyprutils::OS;
+using namespace Hyprutils::Memory;
+
+static int  ret = 0;
+
+static bool test() {
+    constexpr int GROUPED = 10;
+
+    NLog::log("{}Testing groupbar title caching", Colors::GREEN);
+
+    OK(getFromSocket("/keyword group:groupbar:enabled 1"));
+    OK(getFromSocket("/keyword group:groupbar:render_titles 1"));
+    OK(getFromSocket("/keyword group:auto_group 1"));
+
+    // one window to group, the rest open into it
+    CProcess first(binaryDir + "/tiled-windows", std::vector<std::string>{"1"});
+    first.addEnv("WAYLAND_DISPLAY", WLDISPLAY);
+    first.runAsync();
+
+    Tests::waitUntilWindowsN(1);
+    if (Tests::windowCount() != 1) {
+        kill(first.pid(), SIGKILL);
+        return false;
+    }
+
+    OK(getFromSocket("/dispatch togglegroup"));
+
+    CProcess rest(binaryDir + "/tiled-windows", std::vector<std::string>{std::to_string(GROUPED - 1), "1"});
+    rest.addEnv("WAYLAND_DISPLAY", WLDISPLAY);
+    rest.runAsync();
+
+    Tests::waitUntilWindowsN(GROUPED);
+    if (Tests::windowCount() == GROUPED) {
+        // the plugin fails the bench if titles are rendered again on unchanged frames
+        const auto BENCH   = Tests::runBench("/plugintestgroupbarbench");
+        int        grouped = 0, firstFrame = 0;
+        if (BENCH && sscanf(BENCH->c_str(), "ok: %d grouped windows: %d renderText on the first frame", &grouped, &firstFrame) == 2) {
+            EXPECT(grouped, GROUPED);
+            // one title per tab, each rendered once
+            EXPECT(firstFrame, GROUPED);
+        } else
+            ret = 1;
+    } else
+        ret = 1;
+
+    kill(first.pid(), SIGKILL);
+    kill(rest.pid(), SIGKILL);
+    Tests::killAllWindows();
+
+    NLog::log("{}Reloading the config", Colors::YELLOW);
+    OK(getFromSocket("/reload"));
+
+    return !ret;
+}
+
+REGISTER_CLIENT_TEST_FN(test);
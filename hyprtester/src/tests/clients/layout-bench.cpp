@@ -0,0 +1,118 @@
+#include "../../shared.hpp"
+#include "../../hyprctlCompat.hpp"
+#include "../shared.hpp"
+#include "tests.hpp"
+#include "build.hpp"
+
+#include <hyprutils/os/Process.hpp>
+
+#include <csignal>
+#include <thread>
+
+using namespace Hyprutils::OS;
+using namespace Hyprutils::Memory;
+
+static int  ret = 0;
+
+static bool benchWith(int count) {
+    CProcess client(binaryDir + "/tiled-windows", std::vector<std::string>{std::to_string(count)});
+    client.addEnv("WAYLAND_DISPLAY", WLDISPLAY);
+    client.runAsync();
+
+    // wait for all of them to map
+    int counter = 0;
+    while (Tests::windowCount() < count) {
+        counter++;
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+        if (counter > 100) {
+            NLog::log("{}Timed out waiting for {} tiled-windows to map, got {}", Colors::RED, count, Tests::windowCount());
+            kill(client.pid(), SIGKILL);
+            return false;
+        }
+    }
+
+    for (const auto& layout : {"dwindle", "master"}) {
+        OK(getFromSocket(std::format("/keyword general:layout {}", layout)));
+        OK(getFromSocket("/dispatch focuswindow title:^tiled-windows 0$"));
+
+        // positions and damage were checked against a full recalculation by the plugin
+        const auto BENCH = Tests::runBench("/plugintestlayoutbench");
+        if (!BENCH) {
+            ret = 1;
+            continue;
+        }
+
+        EXPECT_CONTAINS(*BENCH, std::format("{} {} tiled windows", count, layout));
+    }
+
+    kill(client.pid(), SIGKILL);
+    Tests::killAllWindows();
+
+    return true;
+}
+
+static bool benchLookup() {
+    constexpr int WINDOWS    = 500;
+    constexpr int WORKSPACES = 50;
+
+    CProcess      client(binaryDir + "/tiled-windows", std::vector<std::string>{std::to_string(WINDOWS)});
+    client.addEnv("WAYLAND_DISPLAY", WLDISPLAY);
+    client.runAsync();
+
+    int counter = 0;
+    while (Tests::windowCount() < WINDOWS) {
+        counter++;
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+        if (counter > 300) {
+            NLog::log("{}Timed out waiting for {} tiled-windows to map, got {}", Colors::RED, WINDOWS, Tests::windowCount());
+            kill(client.pid(), SIGKILL);
+            return false;
+        }
+    }
+
+    for (int i = 0; i < WINDOWS; ++i) {
+        OK(getFromSocket(std::format("/dispatch movetoworkspacesilent {},title:^tiled-windows {}$", i % WORKSPACES + 1, i)));
+    }
+
+    for (const auto& layout : {"dwindle", "master"}) {
+        OK(getFromSocket(std::format("/keyword general:layout {}", layout)));
+        OK(getFromSocket("/dispatch focuswindow title:^tiled-windows 0$"));
+
+        const auto BENCH = Tests::runBench("/plugintestlayoutlookupbench");
+        if (!BENCH) {
+            ret = 1;
+            continue;
+        }
+
+        EXPECT_CONTAINS(*BENCH, std::format("{} {} tiled windows on {} workspaces", WINDOWS, layout, WORKSPACES));
+    }
+
+    kill(client.pid(), SIGKILL);
+    Tests::killAllWindows();
+
+    return true;
+}
+
+static bool test() {
+    NLog::log("{}Testing incremental layout recalculation", Colors::GREEN);
+
+    for (const int COUNT : {2, 20, 100}) {
+        if (!benchWith(COUNT)) {
+            ret = 1;
+            break;
+        }
+    }
+
+    NLog::log("{}Testing layout node lookups across many workspaces", Colors::GREEN);
+    if (!ret && !benchLookup())
+        ret = 1;
+
+    NLog::log("{}Reloading the config", Colors::YELLOW);
+    OK(getFromSocket("/reload"));
+
+    return !ret;
+}
+
+REGISTER_CLIENT_TEST_FN(test);
@@ -0,0 +1,63 @@
+#include "../../shared.hpp"
+#include "../../hyprctlCompat.hpp"
+#include "../shared.hpp"
+#include "tests.hpp"
+#include "build.hpp"
+
+#include <hyprutils/os/Process.hpp>
+
+#include <csignal>
+#include <cstdio>
+#include <thread>
+
+using namespace Hyprutils::OS;
+using namespace Hyprutils::Memory;
+
+static int  ret = 0;
+
+static bool benchWith(int subsurfaces) {
+    CProcess client(binaryDir + "/commit-bench", std::vector<std::string>{std::to_string(subsurfaces), "1"});
+    client.addEnv("WAYLAND_DISPLAY", WLDISPLAY);
+    client.runAsync();
+
+    int counter = 0;
+    while (!getFromSocket("/clients").contains("commit-bench done")) {
+        counter++;
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+        if (counter > 50) {
+            NLog::log("{}Timed out waiting for commit-bench with {} subsurfaces", Colors::RED, subsurfaces);
+            kill(client.pid(), SIGKILL);
+            Tests::killAllWindows();
+            return false;
+        }
+    }
+
+    // the plugin checks the cached traversal visits what breadthfirst used to, in the same order
+    const auto BENCH    = Tests::runBench("/plugintestsurfacetreebench");
+    int        surfaces = 0;
+    if (BENCH && sscanf(BENCH->c_str(), "ok: %d surfaces", &surfaces) == 1) {
+        EXPECT(surfaces, subsurfaces + 1);
+    } else
+        ret = 1;
+
+    kill(client.pid(), SIGKILL);
+    Tests::killAllWindows();
+
+    return true;
+}
+
+static bool test() {
+    NLog::log("{}Testing cached surface tree traversal", Colors::GREEN);
+
+    for (const int COUNT : {1, 10, 50}) {
+        if (!benchWith(COUNT)) {
+            ret = 1;
+            break;
+        }
+    }
+
+    return !ret;
+}
+
+REGISTER_CLIENT_TEST_FN(test);
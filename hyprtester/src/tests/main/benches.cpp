@@ -0,0 +1,149 @@
+#include "tests.hpp"
+#include "../../shared.hpp"
+#include "../../hyprctlCompat.hpp"
+#include "../shared.hpp"
+#include <cstdio>
+#include <format>
+
+static int ret = 0;
+
+static bool testBlurBench() {
+    NLog::log("{}Benchmarking blur", Colors::GREEN);
+
+    OK(getFromSocket("/dispatch focusmonitor HEADLESS-2"));
+
+    for (const auto& SIZE : {"1280x720", "1920x1080", "2560x1440"}) {
+        EXPECT_CONTAINS(getFromSocket(std::format("/keyword monitor HEADLESS-2,{}@60,0x0,1.0", SIZE)), "ok")
+
+        const auto BENCH = Tests::runBench("/plugintestblurbench");
+        if (!BENCH) {
+            ret = 1;
+            continue;
+        }
+
+        // it ran on the new mode, and every level of the mip chain came out the right size
+        EXPECT_STARTS_WITH(*BENCH, std::format("ok: {}:", SIZE));
+        EXPECT(Tests::countOccurrences(*BENCH, " passes "), 8);
+    }
+
+    EXPECT_CONTAINS(getFromSocket("/keyword monitor HEADLESS-2,1920x1080x60.00000,0x0,1.0"), "ok")
+
+    return true;
+}
+
+static bool testDamageBench() {
+    NLog::log("{}Benchmarking batched damage draws", Colors::GREEN);
+
+    const auto BENCH = Tests::runBench("/plugintestdamagebench");
+    if (!BENCH) {
+        ret = 1;
+        return false;
+    }
+
+    // same pixels either way, checked by the plugin. scissoring draws once per rect, batching once per element
+    size_t rects = 0, scissored = 0, batched = 0;
+    if (sscanf(BENCH->c_str(), "ok: %zu rects: scissored: %zu draw calls, %*fus submit per element batched: %zu draw calls", &rects, &scissored, &batched) != 3) {
+        NLog::log("{}Couldn't parse the damage bench result", Colors::RED);
+        ret = 1;
+        TESTS_FAILED++;
+        return false;
+    }
+
+    EXPECT(scissored > 1, true);
+    EXPECT(scissored <= rects, true);
+    EXPECT(batched, 1UL);
+
+    return true;
+}
+
+static bool testShaderBench() {
+    NLog::log("{}Benchmarking specialized surface shaders", Colors::GREEN);
+
+    const auto BENCH = Tests::runBench("/plugintestshaderbench");
+    if (!BENCH) {
+        ret = 1;
+        return false;
+    }
+
+    // every case drew the same pixels with its variant, checked by the plugin, and the variants were built
+    EXPECT_CONTAINS(*BENCH, "opaque rgbx: generic");
+    EXPECT_CONTAINS(*BENCH, "rounded rgba: generic");
+
+    const auto POS      = BENCH->rfind(';');
+    size_t     variants = 0;
+    EXPECT(POS != std::string::npos && sscanf(BENCH->c_str() + POS, "; %zu variants", &variants) == 1, true);
+    EXPECT(variants >= 2, true);
+
+    return true;
+}
+
+static bool testTextBench() {
+    NLog::log("{}Benchmarking text rendering", Colors::GREEN);
+
+    const auto BENCH = Tests::runBench("/plugintesttextbench");
+    if (!BENCH) {
+        ret = 1;
+        return false;
+    }
+
+    // the plugin already compared every string against cairo, here it's about what the atlas saved
+    int    strings = 0, repeats = 0;
+    size_t fromAtlas = 0, glyphs = 0, shapedAgain = 0, rasterizedAgain = 0;
+    if (sscanf(BENCH->c_str(), "ok: %d strings, %zu from the atlas, %zu glyphs rasterized, %d repeats shaped %zu and rasterized %zu", &strings, &fromAtlas, &glyphs, &repeats,
+               &shapedAgain, &rasterizedAgain) != 6) {
+        NLog::log("{}Couldn't parse the text bench result", Colors::RED);
+        ret = 1;
+        TESTS_FAILED++;
+        return false;
+    }
+
+    EXPECT(fromAtlas, sc<size_t>(strings));
+    // the strings only differ in their digits, each glyph is rasterized once and not per string
+    EXPECT(glyphs > 0 && glyphs < 64, true);
+    EXPECT(shapedAgain, 0UL);
+    EXPECT(rasterizedAgain, 0UL);
+
+    return true;
+}
+
+static bool testShmUploadBench() {
+    NLog::log("{}Benchmarking shm texture uploads", Colors::GREEN);
+
+    const auto BENCH = Tests::runBench("/plugintestshmuploadbench");
+    if (!BENCH) {
+        ret = 1;
+        return false;
+    }
+
+    // how many go direct depends on how fast the gpu is, but every commit takes one path and the first few always find a free slot
+    for (const auto& DAMAGE : {"full", "partial"}) {
+        const auto POS   = BENCH->find(std::format("{} async", DAMAGE));
+        const auto PAREN = POS == std::string::npos ? POS : BENCH->find('(', POS);
+        int        ring = 0, direct = 0;
+        if (PAREN == std::string::npos || sscanf(BENCH->c_str() + PAREN, "(%d through the ring, %d direct)", &ring, &direct) != 2) {
+            NLog::log("{}Failed: {}no {} async ring counts in the bench output", Colors::RED, Colors::RESET, DAMAGE);
+            ret = 1;
+            TESTS_FAILED++;
+            continue;
+        }
+
+        EXPECT(ring + direct, 30);
+        EXPECT(ring >= 3, true);
+    }
+
+    return true;
+}
+
+static bool test() {
+    NLog::log("{}Running renderer benches", Colors::GREEN);
+
+    testBlurBench();
+    testDamageBench();
+    testShaderBench();
+    testTextBench();
+    testShmUploadBench();
+
+    return !ret;
+}
+
+REGISTER_TEST_FN(test)
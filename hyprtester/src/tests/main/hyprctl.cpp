@@ -2,6 +2,7 @@
 #include "../../shared.hpp"
 #include "../../hyprctlCompat.hpp"
 #include <cstdint>
+#include <cstdio>
 #include <print>
 #include <string>
 #include <thread>
@@ -163,6 +164,132 @@ static bool testGetprop() {
     return true;
 }
 
+static bool testClientsJSON() {
+    NLog::log("{}Testing hyprctl clients json against the legacy serializer", Colors::GREEN);
+
+    for (int i = 0; i < 3; ++i) {
+        if (!Tests::spawnKitty()) {
+            NLog::log("{}Error: kitty did not spawn", Colors::RED);
+            return false;
+        }
+    }
+
+    // group two of them, so grouped data is covered too
+    getFromSocket("/dispatch togglegroup");
+    getFromSocket("/dispatch moveintogroup l");
+
+    // the plugin compares the output against the legacy serializer byte for byte
+    const auto BENCH   = Tests::runBench("/plugintestjsonbench");
+    int        windows = 0;
+    if (BENCH && sscanf(BENCH->c_str(), "ok: %d windows", &windows) == 1) {
+        EXPECT(windows >= 3, true);
+    } else
+        ret = 1;
+
+    Tests::killAllWindows();
+    EXPECT(Tests::windowCount(), 0);
+
+    return true;
+}
+
+static bool testRollingLog() {
+    NLog::log("{}Testing hyprctl rollinglog", Colors::GREEN);
+
+    // the test plugin logs through the async writer, then checks the tail caught up
+    if (!Tests::runBench("/plugintestlogbench"))
+        ret = 1;
+
+    const auto ROLLINGLOG = getFromSocket("/rollinglog");
+    EXPECT_CONTAINS(ROLLINGLOG, "plugintestlogbench");
+    EXPECT(ROLLINGLOG.size() <= 4096, true);
+
+    return true;
+}
+
+static size_t regexCacheHits() {
+    const auto STATS = getFromSocket("/regexcache");
+
+    try {
+        return std::stoull(STATS.substr(STATS.find("hits: ") + 6));
+    } catch (...) { return 0; }
+}
+
+static bool testRegexCache() {
+    NLog::log("{}Testing hyprctl regexcache", Colors::GREEN);
+
+    // no window matches, but the selector still gets compiled once and reused after
+    getFromSocket("/dispatch focuswindow class:^regexcachetest$");
+    const auto HITS = regexCacheHits();
+
+    for (int i = 0; i < 10; ++i) {
+        getFromSocket("/dispatch focuswindow class:^regexcachetest$");
+    }
+
+    EXPECT(regexCacheHits() >= HITS + 10, true);
+
+    // address: and pid: selectors don't use a regex, so they don't touch the cache
+    const auto STATS = getFromSocket("/regexcache");
+    getFromSocket("/dispatch focuswindow address:0x1");
+    getFromSocket("/dispatch focuswindow pid:1");
+    EXPECT(getFromSocket("/regexcache"), STATS);
+
+    EXPECT_CONTAINS(getFromSocket("j/regexcache"), "\"capacity\"");
+
+    return true;
+}
+
+static bool testShaderCache() {
+    NLog::log("{}Testing the shader cache", Colors::GREEN);
+
+    const auto INFO = getFromSocket("/systeminfo");
+    EXPECT_CONTAINS(INFO, "Shader cache: ");
+
+    if (const auto POS = INFO.find("Shader cache: "); POS != std::string::npos)
+        NLog::log("{}{}", Colors::YELLOW, INFO.substr(POS, INFO.find('\n', POS) - POS));
+
+    // the plugin checks warm starts load what a cold one stored, and that binaries not matching their sources or cut short get compiled again
+    if (!Tests::runBench("/plugintestshadercache"))
+        ret = 1;
+
+    return true;
+}
+
+static bool testPerf() {
+    NLog::log("{}Testing hyprctl perf", Colors::GREEN);
+
+    // make sure there's been a frame to measure
+    getFromSocket("/dispatch workspace 1");
+
+    const auto PERF = getFromSocket("j/perf");
+    EXPECT_CONTAINS(PERF, R"("monitor": "HEADLESS-)");
+    EXPECT_CONTAINS(PERF, R"("renderMs": {"count": )");
+    EXPECT_CONTAINS(PERF, R"("discardedElements": )");
+    EXPECT_CONTAINS(PERF, R"("inputOverBudget": )");
+
+    CProcess jqProc("bash", {"-c", "hyprctl -j perf | jq"});
+    jqProc.addEnv("HYPRLAND_INSTANCE_SIGNATURE", HIS);
+    jqProc.runSync();
+    EXPECT(jqProc.exitCode(), 0);
+
+    EXPECT_CONTAINS(getFromSocket("/perf"), "renderMs: p50 ");
+
+    return true;
+}
+
+static bool testRenderDeadline() {
+    NLog::log("{}Testing the render deadline scheduler", Colors::GREEN);
+
+    EXPECT_CONTAINS(getFromSocket("j/monitors"), R"("renderDeadline": {)");
+
+    // the plugin feeds the scheduler fake frame times and checks where the estimate and delay settle
+    getFromSocket("/keyword render:render_deadline 1");
+    if (!Tests::runBench("/plugintestdeadline"))
+        ret = 1;
+    getFromSocket("/keyword render:render_deadline 0");
+
+    return true;
+}
+
 static bool test() {
     NLog::log("{}Testing hyprctl", Colors::GREEN);
 
@@ -176,6 +303,12 @@ static bool test() {
 
     testGetprop();
     testDevicesActiveLayoutIndex();
+    testClientsJSON();
+    testRollingLog();
+    testRegexCache();
+    testShaderCache();
+    testRenderDeadline();
+    testPerf();
     getFromSocket("/reload");
 
     return !ret;
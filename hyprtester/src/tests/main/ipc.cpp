@@ -0,0 +1,325 @@
+#include "tests.hpp"
+#include "../../shared.hpp"
+#include "../../hyprctlCompat.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <format>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <hyprutils/os/FileDescriptor.hpp>
+#include <hyprutils/memory/Casts.hpp>
+#include "../shared.hpp"
+
+static int ret = 0;
+
+using namespace Hyprutils::OS;
+using namespace Hyprutils::Memory;
+
+constexpr int STRESS_CLIENTS  = 16;
+constexpr int STRESS_REQUESTS = 100;
+
+// reads until n NUL-terminated replies arrived, or the read times out
+static std::vector<std::string> readFramedReplies(int fd, size_t n) {
+    std::vector<std::string> replies;
+    std::string              buf;
+    char                     readBuf[8192];
+
+    while (replies.size() < n) {
+        const auto SIZE = read(fd, readBuf, sizeof(readBuf));
+        if (SIZE <= 0)
+            break;
+
+        buf.append(readBuf, SIZE);
+
+        for (size_t end = buf.find('\0'); end != std::string::npos; end = buf.find('\0')) {
+            replies.emplace_back(buf.substr(0, end));
+            buf.erase(0, end + 1);
+        }
+    }
+
+    return replies;
+}
+
+static bool testStalledClient() {
+    NLog::log("{}Testing a stalled client doesn't block hyprctl", Colors::GREEN);
+
+    // connects, but never sends anything
+    CFileDescriptor stalled{connectToSocket()};
+    EXPECT(stalled.isValid(), true);
+
+    const auto BEGIN = std::chrono::steady_clock::now();
+    const auto REPLY = getFromSocket("/splash");
+    const auto MS    = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - BEGIN).count();
+
+    EXPECT(REPLY.empty(), false);
+    EXPECT(MS < 1000, true);
+
+    // it doesn't get to hold its connection forever either, reading ends in EOF once it's dropped
+    pollfd pfd = {.fd = stalled.get(), .events = POLLIN};
+    EXPECT(poll(&pfd, 1, 7000), 1);
+
+    char buf[16];
+    EXPECT(read(stalled.get(), buf, sizeof(buf)), 0);
+
+    return true;
+}
+
+static bool testPipelining() {
+    NLog::log("{}Testing pipelined requests on one connection", Colors::GREEN);
+
+    CFileDescriptor conn{connectToSocket()};
+    EXPECT(conn.isValid(), true);
+
+    const std::string REQUESTS = std::string{"/dispatch workspace 1"} + '\0' + "/nonexistentrequest" + '\0' + "/dispatch workspace 1" + '\0';
+    EXPECT(write(conn.get(), REQUESTS.data(), REQUESTS.size()), sc<ssize_t>(REQUESTS.size()));
+
+    auto replies = readFramedReplies(conn.get(), 3);
+    EXPECT(replies.size(), 3UL);
+    if (replies.size() != 3)
+        return false;
+
+    EXPECT(replies[0], "ok");
+    EXPECT(replies[1], "unknown request");
+    EXPECT(replies[2], "ok");
+
+    // the connection stays open for more
+    const std::string MORE = std::string{"j/activeworkspace"} + '\0';
+    EXPECT(write(conn.get(), MORE.data(), MORE.size()), sc<ssize_t>(MORE.size()));
+
+    replies = readFramedReplies(conn.get(), 1);
+    EXPECT(replies.size(), 1UL);
+    if (!replies.empty())
+        EXPECT_CONTAINS(replies[0], "\"id\": 1");
+
+    return true;
+}
+
+static bool testCommandLookup() {
+    NLog::log("{}Testing hyprctl command lookup", Colors::GREEN);
+
+    // registered by the test plugin, even ones are exact
+    EXPECT(getFromSocket("/plugintestcmd042"), "plugin:plugintestcmd042");
+    EXPECT(getFromSocket("/plugintestcmd042 arg"), "unknown request");
+    EXPECT(getFromSocket("/plugintestcmd043 arg"), "plugin:plugintestcmd043 arg");
+
+    // the plugin checks every command resolves to itself through the index
+    if (!Tests::runBench("/plugintestbench"))
+        ret = 1;
+
+    return true;
+}
+
+static bool testStress() {
+    NLog::log("{}Stressing hyprctl with {} concurrent clients", Colors::GREEN, STRESS_CLIENTS);
+
+    std::vector<std::vector<double>> latencies(STRESS_CLIENTS);
+    std::atomic<int>                 failures = 0;
+    std::vector<std::thread>         threads;
+
+    for (int i = 0; i < STRESS_CLIENTS; ++i) {
+        threads.emplace_back([i, &latencies, &failures] {
+            // half of the clients use one persistent connection, the other half reconnect every time
+            const bool      PERSISTENT = i % 2 == 0;
+            CFileDescriptor conn;
+
+            if (PERSISTENT)
+                conn = CFileDescriptor{connectToSocket()};
+
+            const std::string FRAMED = std::string{"j/activeworkspace"} + '\0';
+
+            for (int r = 0; r < STRESS_REQUESTS; ++r) {
+                const auto  BEGIN = std::chrono::steady_clock::now();
+                std::string reply;
+
+                if (PERSISTENT) {
+                    if (write(conn.get(), FRAMED.data(), FRAMED.size()) == sc<ssize_t>(FRAMED.size())) {
+                        const auto REPLIES = readFramedReplies(conn.get(), 1);
+                        if (!REPLIES.empty())
+                            reply = REPLIES.front();
+                    }
+                } else
+                    reply = getFromSocket("j/activeworkspace");
+
+                latencies[i].emplace_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - BEGIN).count());
+
+                if (!reply.contains("\"id\""))
+                    failures++;
+            }
+        });
+    }
+
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    std::vector<double> all;
+    for (const auto& l : latencies) {
+        all.insert(all.end(), l.begin(), l.end());
+    }
+
+    std::ranges::sort(all);
+
+    const auto PERCENTILE = [&all](double p) { return all.empty() ? 0.0 : all[std::min(all.size() - 1, sc<size_t>(p * all.size()))]; };
+
+    NLog::log("{}hyprctl latency over {} requests: p50 {:.3f}ms, p99 {:.3f}ms, max {:.3f}ms", Colors::YELLOW, all.size(), PERCENTILE(0.5), PERCENTILE(0.99),
+              all.empty() ? 0.0 : all.back());
+
+    EXPECT(failures.load(), 0);
+    EXPECT(all.size(), sc<size_t>(STRESS_CLIENTS * STRESS_REQUESTS));
+
+    return true;
+}
+
+static bool testSlowEventConsumer() {
+    NLog::log("{}Testing a stalled socket2 client doesn't hold back others", Colors::GREEN);
+
+    constexpr int RENAMES = 400;
+
+    OK(getFromSocket("/keyword misc:socket2_max_backlog 16"));
+
+    // never reads anything
+    CFileDescriptor stalled{connectToSocket(".socket2.sock")};
+    CFileDescriptor reader{connectToSocket(".socket2.sock")};
+    EXPECT(stalled.isValid(), true);
+    EXPECT(reader.isValid(), true);
+
+    std::atomic<int> received = 0;
+    std::thread      readerThread([&reader, &received] {
+        std::string buf;
+        char        readBuf[8192];
+
+        while (received < RENAMES) {
+            const auto SIZE = read(reader.get(), readBuf, sizeof(readBuf));
+            if (SIZE <= 0)
+                break;
+
+            buf.append(readBuf, SIZE);
+
+            for (size_t end = buf.find('\n'); end != std::string::npos; end = buf.find('\n')) {
+                if (buf.starts_with("renameworkspace>>"))
+                    received++;
+                buf.erase(0, end + 1);
+            }
+        }
+    });
+
+    // long names so the stalled client's socket buffer fills up quickly
+    std::string requests;
+    for (int i = 0; i < RENAMES; ++i) {
+        requests += std::format("/dispatch renameworkspace 1 {}{}", i, std::string(900, 'x')) + '\0';
+    }
+
+    CFileDescriptor conn{connectToSocket()};
+    EXPECT(write(conn.get(), requests.data(), requests.size()), sc<ssize_t>(requests.size()));
+    EXPECT(readFramedReplies(conn.get(), RENAMES).size(), sc<size_t>(RENAMES));
+
+    readerThread.join();
+    EXPECT(received.load(), RENAMES);
+
+    // the stalled client got dropped: draining it ends in EOF instead of a timeout
+    char    readBuf[8192];
+    ssize_t size = 0;
+    while ((size = read(stalled.get(), readBuf, sizeof(readBuf))) > 0) {
+        ;
+    }
+    EXPECT(size, 0);
+
+    OK(getFromSocket("/dispatch renameworkspace 1 1"));
+    OK(getFromSocket("/reload"));
+
+    return true;
+}
+
+static bool testEventSubscription() {
+    NLog::log("{}Testing socket2 subscriptions", Colors::GREEN);
+
+    CFileDescriptor subscriber{connectToSocket(".socket2.sock")};
+    EXPECT(subscriber.isValid(), true);
+
+    const std::string SUBSCRIBE = "subscribe renameworkspace,custom*\n";
+    EXPECT(write(subscriber.get(), SUBSCRIBE.data(), SUBSCRIBE.size()), sc<ssize_t>(SUBSCRIBE.size()));
+
+    // like socat -u, nothing more to say but still listening
+    EXPECT(shutdown(subscriber.get(), SHUT_WR), 0);
+
+    // give the compositor a moment to read the subscription
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    OK(getFromSocket("/dispatch workspace 2"));
+    OK(getFromSocket("/dispatch workspace 1"));
+    OK(getFromSocket("/dispatch event hello"));
+    OK(getFromSocket("/dispatch renameworkspace 1 subscribed"));
+    OK(getFromSocket("/dispatch renameworkspace 1 1"));
+
+    std::string buf;
+    char        readBuf[1024];
+    while (std::ranges::count(buf, '\n') < 3) {
+        const auto SIZE = read(subscriber.get(), readBuf, sizeof(readBuf));
+        if (SIZE <= 0)
+            break;
+
+        buf.append(readBuf, SIZE);
+    }
+
+    EXPECT(buf, "custom>>hello\nrenameworkspace>>1,subscribed\nrenameworkspace>>1,1\n");
+
+    return true;
+}
+
+static bool testLogFollow() {
+    NLog::log("{}Testing rollinglog -f", Colors::GREEN);
+
+    CFileDescriptor follower{connectToSocket()};
+    EXPECT(follower.isValid(), true);
+
+    const std::string REQUEST = "f/rollinglog";
+    EXPECT(write(follower.get(), REQUEST.data(), REQUEST.size()), sc<ssize_t>(REQUEST.size()));
+
+    std::string buf;
+    char        readBuf[8192];
+
+    const auto  READUNTIL = [&](const std::string& needle) {
+        while (!buf.contains(needle)) {
+            const auto SIZE = read(follower.get(), readBuf, sizeof(readBuf));
+            if (SIZE <= 0)
+                return false;
+
+            buf.append(readBuf, SIZE);
+        }
+
+        return true;
+    };
+
+    EXPECT(READUNTIL("Following log to socket"), true);
+
+    // anything logged now should show up right away, not after a polling interval
+    const auto BEGIN = std::chrono::steady_clock::now();
+    OK(getFromSocket("/dispatch event logfollowtest"));
+    EXPECT(READUNTIL("logfollowtest"), true);
+    const auto MS = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - BEGIN).count();
+
+    NLog::log("{}followed log line arrived after {}ms", Colors::YELLOW, MS);
+    EXPECT(MS < 100, true);
+
+    return true;
+}
+
+static bool test() {
+    NLog::log("{}Testing the hyprctl socket", Colors::GREEN);
+
+    testStalledClient();
+    testPipelining();
+    testCommandLookup();
+    testStress();
+    testSlowEventConsumer();
+    testEventSubscription();
+    testLogFollow();
+
+    return !ret;
+}
+
+REGISTER_TEST_FN(test);
@@ -482,6 +482,21 @@ static void testSubmapUniversal() {
     EXPECT(getFromSocket("/keyword unbind SUPER,Y"), "ok");
 }
 
+static void testKeybindIndex() {
+    NLog::log("{}Testing the keybind index", Colors::GREEN);
+
+    // unbinding has to drop the bind from the index too
+    EXPECT(checkFlag(), false);
+    EXPECT(getFromSocket("/keyword bind SUPER,Y,exec,touch " + flagFile), "ok");
+    EXPECT(getFromSocket("/keyword unbind SUPER,Y"), "ok");
+    OK(getFromSocket("/dispatch plugin:test:keybind 1,7,29"));
+    OK(getFromSocket("/dispatch plugin:test:keybind 0,7,29"));
+    EXPECT(attemptCheckFlag(20, 10), false);
+
+    if (!Tests::runBench("/plugintestkeybindbench"))
+        ret = 1;
+}
+
 static bool test() {
     NLog::log("{}Testing keybinds", Colors::GREEN);
 
@@ -503,6 +518,7 @@ static bool test() {
     testShortcutRepeatKeyRelease();
     testSubmap();
     testSubmapUniversal();
+    testKeybindIndex();
 
     clearFlag();
     return !ret;
@@ -1,6 +1,7 @@
 #include <cmath>
 #include <chrono>
 #include <cstdlib>
+#include <cstdio>
 #include <cstring>
 #include <filesystem>
 #include <thread>
@@ -196,6 +197,100 @@ static void testGroupRules() {
     Tests::killAllWindows();
 }
 
+static void testFocusRules() {
+    NLog::log("{}Testing focus dependent window rules", Colors::YELLOW);
+
+    OK(getFromSocket("/keyword general:border_size 8"));
+    OK(getFromSocket("/keyword windowrule match:class kitty_A, border_size 3"));
+    OK(getFromSocket("/keyword windowrule match:class kitty_A, match:focus 1, border_size 5"));
+
+    if (!Tests::spawnKitty("kitty_A") || !Tests::spawnKitty("kitty_B")) {
+        ret = 1;
+        return;
+    }
+
+    // losing focus has to bring back what the other rule set
+    EXPECT_CONTAINS(getFromSocket("/getprop class:kitty_A border_size"), "3");
+    OK(getFromSocket("/dispatch focuswindow class:kitty_A"));
+    EXPECT_CONTAINS(getFromSocket("/getprop class:kitty_A border_size"), "5");
+    OK(getFromSocket("/dispatch focuswindow class:kitty_B"));
+    EXPECT_CONTAINS(getFromSocket("/getprop class:kitty_A border_size"), "3");
+    EXPECT_CONTAINS(getFromSocket("/getprop class:kitty_B border_size"), "8");
+
+    if (!Tests::runBench("/plugintestrulebench"))
+        ret = 1;
+
+    OK(getFromSocket("/reload"));
+    Tests::killAllWindows();
+}
+
+static void testHitTest() {
+    NLog::log("{}Testing pointer hit-testing with more and more windows", Colors::YELLOW);
+
+    for (int i = 0; i < 8; ++i) {
+        if (!Tests::spawnKitty(std::format("kitty_hit{}", i))) {
+            ret = 1;
+            return;
+        }
+
+        // every other one floats, so the floating passes see some work too
+        if (i % 2 == 1) {
+            OK(getFromSocket(std::format("/dispatch setfloating class:kitty_hit{}", i)));
+            OK(getFromSocket(std::format("/dispatch movewindowpixel exact {} {},class:kitty_hit{}", 100 + (i * 50), 100 + (i * 30), i)));
+        }
+
+        // the plugin checks every point against a scan of all windows
+        if (i == 0 || i == 3 || i == 7) {
+            const auto BENCH   = Tests::runBench("/plugintesthittestbench");
+            int        windows = 0, points = 0, hits = 0;
+            if (BENCH && sscanf(BENCH->c_str(), "ok: %d windows, %d points, %d hits", &windows, &points, &hits) == 3) {
+                EXPECT(windows >= i + 1, true);
+                // the first window is tiled over the whole monitor, only the gaps can miss
+                EXPECT(hits > points / 2, true);
+            } else
+                ret = 1;
+        }
+    }
+
+    // a window moved without a layout recalc still has to be found where it is now
+    EXPECT(getFromSocket("/plugintesthittestwarp"), "ok");
+
+    Tests::killAllWindows();
+}
+
+static size_t motionEvaluations(const std::string& bench) {
+    // "ok: N motion events received, M focus evaluations, ..."
+    const auto POS = bench.find("received, ");
+    return POS == std::string::npos ? 0 : std::stoul(bench.substr(POS + 10));
+}
+
+static void testMotionCoalescing() {
+    NLog::log("{}Testing pointer motion coalescing", Colors::YELLOW);
+
+    if (!Tests::spawnKitty("kitty_motion")) {
+        ret = 1;
+        return;
+    }
+
+    OK(getFromSocket("/dispatch movecursor 960 540"));
+
+    const auto FULL = Tests::runBench("/plugintestmotionbench");
+
+    OK(getFromSocket("/keyword input:motion_coalesce 1"));
+
+    const auto COALESCED = Tests::runBench("/plugintestmotionbench");
+
+    if (FULL && COALESCED) {
+        // all of it arrived within one interval, so it's a handful of evaluations instead of one per event
+        EXPECT(motionEvaluations(*COALESCED) < motionEvaluations(*FULL), true);
+        EXPECT(motionEvaluations(*COALESCED) < 10, true);
+    } else
+        ret = 1;
+
+    OK(getFromSocket("/reload"));
+    Tests::killAllWindows();
+}
+
 static bool isActiveWindow(const std::string& class_, char fullscreen, bool log = true) {
     std::string activeWin     = getFromSocket("/activewindow");
     auto        winClass      = getWindowAttribute(activeWin, "class:");
@@ -668,6 +763,9 @@ static bool test() {
     Tests::killAllWindows();
 
     testGroupRules();
+    testFocusRules();
+    testHitTest();
+    testMotionCoalescing();
 
     NLog::log("{}Reloading config", Colors::YELLOW);
     OK(getFromSocket("/reload"));
@@ -105,3 +105,17 @@ std::string Tests::execAndGet(const std::string& cmd) {
 
     return proc.stdOut();
 }
+
+std::optional<std::string> Tests::runBench(const std::string& cmd) {
+    const auto RESULT = getFromSocket(cmd);
+
+    if (!RESULT.starts_with("ok")) {
+        NLog::log("{}Failed: {}{} reported {}", Colors::RED, Colors::RESET, cmd, RESULT);
+        TESTS_FAILED++;
+        return std::nullopt;
+    }
+
+    NLog::log("{}{}", Colors::YELLOW, RESULT);
+    TESTS_PASSED++;
+    return RESULT;
+}
@@ -3,6 +3,8 @@
 #include <hyprutils/os/Process.hpp>
 #include <hyprutils/memory/WeakPtr.hpp>
 #include <sys/types.h>
+#include <optional>
+#include <string>
 
 #include "../Log.hpp"
 
@@ -15,4 +17,7 @@ namespace Tests {
     bool                                                       killAllWindows();
     void                                                       waitUntilWindowsN(int n);
     std::string                                                execAndGet(const std::string& cmd);
+
+    // runs a bench of the test plugin. benches check their results before reporting "ok: <what was measured>", anything else is a failed test and nullopt
+    std::optional<std::string> runBench(const std::string& cmd);
 };
@@ -5,7 +5,9 @@
 #include "debug/Log.hpp"
 #include "desktop/DesktopTypes.hpp"
 #include "desktop/state/FocusState.hpp"
+#include "desktop/state/HitTestIndex.hpp"
 #include "helpers/Splashes.hpp"
+#include "helpers/RegexCache.hpp"
 #include "config/ConfigValue.hpp"
 #include "config/ConfigWatcher.hpp"
 #include "managers/CursorManager.hpp"
@@ -65,6 +67,7 @@
 #include "hyprerror/HyprError.hpp"
 #include "debug/HyprNotificationOverlay.hpp"
 #include "debug/HyprDebugOverlay.hpp"
+#include "debug/Telemetry.hpp"
 #include "helpers/MonitorFrameScheduler.hpp"
 #include "i18n/Engine.hpp"
 
@@ -606,6 +609,7 @@ void CCompositor::cleanup() {
     g_pANRManager.reset();
     g_pConfigWatcher.reset();
     g_pAsyncResourceGatherer.reset();
+    g_pTelemetry.reset();
 
     if (m_aqBackend)
         m_aqBackend.reset();
@@ -625,6 +629,9 @@ void CCompositor::initManagers(eManagersInitStage stage) {
             Debug::log(LOG, "Creating the EventLoopManager!");
             g_pEventLoopManager = makeUnique<CEventLoopManager>(m_wlDisplay, m_wlEventLoop);
 
+            Debug::log(LOG, "Creating the Telemetry!");
+            g_pTelemetry = makeUnique<CTelemetry>();
+
             Debug::log(LOG, "Creating the HookSystem!");
             g_pHookSystem = makeUnique<CHookSystemManager>();
 
@@ -893,9 +900,12 @@ PHLWINDOW CCompositor::vectorToWindowUnified(const Vector2D& pos, uint8_t proper
         return *PMODALPARENTBLOCKING && w->m_xdgSurface && w->m_xdgSurface->m_toplevel && w->m_xdgSurface->m_toplevel->anyChildModal();
     };
 
+    // only windows whose boxes can contain pos or the pointer, in the same z-order as m_windows
+    const auto CANDIDATES = Desktop::hitTestIndex()->candidatesAt(pos, g_pPointerManager->position());
+
     // pinned windows on top of floating regardless
     if (properties & ALLOW_FLOATING) {
-        for (auto const& w : m_windows | std::views::reverse) {
+        for (auto const& w : CANDIDATES | std::views::reverse) {
             if (ONLY_PRIORITY && !w->priorityFocus())
                 continue;
 
@@ -916,7 +926,7 @@ PHLWINDOW CCompositor::vectorToWindowUnified(const Vector2D& pos, uint8_t proper
 
     auto windowForWorkspace = [&](bool special) -> PHLWINDOW {
         auto floating = [&](bool aboveFullscreen) -> PHLWINDOW {
-            for (auto const& w : m_windows | std::views::reverse) {
+            for (auto const& w : CANDIDATES | std::views::reverse) {
 
                 if (special && !w->onSpecialWorkspace()) // because special floating may creep up into regular
                     continue;
@@ -987,7 +997,7 @@ PHLWINDOW CCompositor::vectorToWindowUnified(const Vector2D& pos, uint8_t proper
             return found;
 
         // for windows, we need to check their extensions too, first.
-        for (auto const& w : m_windows) {
+        for (auto const& w : CANDIDATES) {
             if (ONLY_PRIORITY && !w->priorityFocus())
                 continue;
 
@@ -1004,7 +1014,7 @@ PHLWINDOW CCompositor::vectorToWindowUnified(const Vector2D& pos, uint8_t proper
             }
         }
 
-        for (auto const& w : m_windows) {
+        for (auto const& w : CANDIDATES) {
             if (ONLY_PRIORITY && !w->priorityFocus())
                 continue;
 
@@ -1140,7 +1150,12 @@ SP<CWLSurfaceResource> CCompositor::vectorToLayerSurface(const Vector2D& pos, st
             (aboveLockscreen && ls->m_ruleApplicator->aboveLock().valueOrDefault() != 2))
             continue;
 
-        auto [surf, local] = ls->m_layerSurface->m_surface->at(pos - ls->m_geometry.pos(), true);
+        // without subsurfaces, nothing can be hit outside of the surface itself
+        const auto& SURFACE = ls->m_layerSurface->m_surface;
+        if (SURFACE->m_subsurfaces.empty() && !CBox{ls->m_geometry.pos(), SURFACE->m_current.size}.containsPoint(pos))
+            continue;
+
+        auto [surf, local] = SURFACE->at(pos - ls->m_geometry.pos(), true);
 
         if (surf) {
             if (surf->m_current.input.empty())
@@ -1233,6 +1248,8 @@ void CCompositor::changeWindowZOrder(PHLWINDOW pWindow, bool top) {
 
         if (pw->m_isMapped)
             g_pHyprRenderer->damageMonitor(pw->m_monitor.lock());
+
+        Desktop::hitTestIndex()->invalidate();
     };
 
     if (!pWindow->m_isX11)
@@ -2238,39 +2255,40 @@ PHLWINDOW CCompositor::getWindowByRegex(const std::string& regexp_) {
         matchCheck = regexp.substr(4);
     }
 
+    // compiled once for all windows, and kept around for the next call with the same selector. address: and pid: don't match a regex.
+    SP<re2::RE2> regex;
+    if (mode != MODE_ADDRESS && mode != MODE_PID)
+        regex = regexCache()->get(regexCheck);
+
     for (auto const& w : g_pCompositor->m_windows) {
         if (!w->m_isMapped || (w->isHidden() && !g_pLayoutManager->getCurrentLayout()->isWindowReachable(w)))
             continue;
 
         switch (mode) {
             case MODE_CLASS_REGEX: {
-                const auto windowClass = w->m_class;
-                if (!RE2::FullMatch(windowClass, regexCheck))
+                if (!RE2::FullMatch(w->m_class, *regex))
                     continue;
                 break;
             }
             case MODE_INITIAL_CLASS_REGEX: {
-                const auto initialWindowClass = w->m_initialClass;
-                if (!RE2::FullMatch(initialWindowClass, regexCheck))
+                if (!RE2::FullMatch(w->m_initialClass, *regex))
                     continue;
                 break;
             }
             case MODE_TITLE_REGEX: {
-                const auto windowTitle = w->m_title;
-                if (!RE2::FullMatch(windowTitle, regexCheck))
+                if (!RE2::FullMatch(w->m_title, *regex))
                     continue;
                 break;
             }
             case MODE_INITIAL_TITLE_REGEX: {
-                const auto initialWindowTitle = w->m_initialTitle;
-                if (!RE2::FullMatch(initialWindowTitle, regexCheck))
+                if (!RE2::FullMatch(w->m_initialTitle, *regex))
                     continue;
                 break;
             }
             case MODE_TAG_REGEX: {
                 bool tagMatched = false;
                 for (auto const& t : w->m_ruleApplicator->m_tagKeeper.getTags()) {
-                    if (RE2::FullMatch(t, regexCheck)) {
+                    if (RE2::FullMatch(t, *regex)) {
                         tagMatched = true;
                         break;
                     }
@@ -545,6 +545,19 @@ inline static const std::vector<SConfigOptionDescription> CONFIG_OPTIONS = {
         .type        = CONFIG_OPTION_FLOAT,
         .data        = SConfigOptionDescription::SFloatData{},
     },
+    SConfigOptionDescription{
+        .value       = "input:motion_coalesce",
+        .description = "Refocus and move dragged windows once per motion_coalesce_interval instead of on every pointer motion event. Clients still get every motion event, "
+                       "but focus, enter/leave and mouseMove hooks can lag behind by one interval. Helps with high polling rate mice.",
+        .type        = CONFIG_OPTION_BOOL,
+        .data        = SConfigOptionDescription::SBoolData{false},
+    },
+    SConfigOptionDescription{
+        .value       = "input:motion_coalesce_interval",
+        .description = "How often coalesced pointer motion is processed, in ms. 0 means once per frame of the monitor under the cursor.",
+        .type        = CONFIG_OPTION_INT,
+        .data        = SConfigOptionDescription::SRangeData{0, 0, 100},
+    },
     SConfigOptionDescription{
         .value       = "input:focus_on_close",
         .description = "Controls the window focus behavior when a window is closed. When set to 0, focus will shift to the next window candidate. When set to 1, focus will shift "
@@ -1357,6 +1370,12 @@ inline static const std::vector<SConfigOptionDescription> CONFIG_OPTIONS = {
         .type        = CONFIG_OPTION_BOOL,
         .data        = SConfigOptionDescription::SBoolData{false},
     },
+    SConfigOptionDescription{
+        .value       = "misc:socket2_max_backlog",
+        .description = "how many KiB of unread events a socket2 client may fall behind before it gets disconnected",
+        .type        = CONFIG_OPTION_INT,
+        .data        = SConfigOptionDescription::SRangeData{64, 4, 16384},
+    },
 
     /*
      * binds:
@@ -1561,6 +1580,30 @@ inline static const std::vector<SConfigOptionDescription> CONFIG_OPTIONS = {
         .type        = CONFIG_OPTION_CHOICE,
         .data        = SConfigOptionDescription::SChoiceData{0, "srgb,gamma22,gamma22force"},
     },
+    SConfigOptionDescription{
+        .value       = "render:damage_batch_threshold",
+        .description = "when an element is damaged in at least this many rectangles, draw all of them in one draw call instead of one scissored draw per rectangle. 0 - never",
+        .type        = CONFIG_OPTION_INT,
+        .data        = SConfigOptionDescription::SRangeData{4, 0, 64},
+    },
+    SConfigOptionDescription{
+        .value       = "render:render_deadline",
+        .description = "start rendering as late as possible before the next vblank, based on how long recent frames took to render. Lowers input latency.",
+        .type        = CONFIG_OPTION_BOOL,
+        .data        = SConfigOptionDescription::SBoolData{false},
+    },
+    SConfigOptionDescription{
+        .value       = "render:render_deadline_margin",
+        .description = "with render_deadline, how much time (in ms) to leave between the expected end of a render and the vblank",
+        .type        = CONFIG_OPTION_FLOAT,
+        .data        = SConfigOptionDescription::SFloatData{1.5, 0, 10},
+    },
+    SConfigOptionDescription{
+        .value       = "render:async_shm_upload",
+        .description = "upload shm buffers through pixel buffer objects, so the copy into the texture doesn't block the compositor",
+        .type        = CONFIG_OPTION_BOOL,
+        .data        = SConfigOptionDescription::SBoolData{true},
+    },
 
     /*
      * cursor:
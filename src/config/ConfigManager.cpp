@@ -504,6 +504,7 @@ CConfigManager::CConfigManager() {
     registerConfigVar("misc:screencopy_force_8b", Hyprlang::INT{1});
     registerConfigVar("misc:disable_scale_notification", Hyprlang::INT{0});
     registerConfigVar("misc:size_limits_tiled", Hyprlang::INT{0});
+    registerConfigVar("misc:socket2_max_backlog", Hyprlang::INT{64});
 
     registerConfigVar("group:insert_after_current", Hyprlang::INT{1});
     registerConfigVar("group:focus_removed_window", Hyprlang::INT{1});
@@ -630,6 +631,8 @@ CConfigManager::CConfigManager() {
 
     registerConfigVar("input:follow_mouse", Hyprlang::INT{1});
     registerConfigVar("input:follow_mouse_threshold", Hyprlang::FLOAT{0});
+    registerConfigVar("input:motion_coalesce", Hyprlang::INT{0});
+    registerConfigVar("input:motion_coalesce_interval", Hyprlang::INT{0});
     registerConfigVar("input:focus_on_close", Hyprlang::INT{0});
     registerConfigVar("input:mouse_refocus", Hyprlang::INT{1});
     registerConfigVar("input:special_fallthrough", Hyprlang::INT{0});
@@ -763,6 +766,10 @@ CConfigManager::CConfigManager() {
     registerConfigVar("render:new_render_scheduling", Hyprlang::INT{0});
     registerConfigVar("render:non_shader_cm", Hyprlang::INT{3});
     registerConfigVar("render:cm_sdr_eotf", Hyprlang::INT{0});
+    registerConfigVar("render:damage_batch_threshold", Hyprlang::INT{4});
+    registerConfigVar("render:render_deadline", Hyprlang::INT{0});
+    registerConfigVar("render:render_deadline_margin", Hyprlang::FLOAT{1.5});
+    registerConfigVar("render:async_shm_upload", Hyprlang::INT{1});
 
     registerConfigVar("ecosystem:no_update_news", Hyprlang::INT{0});
     registerConfigVar("ecosystem:no_donation_nag", Hyprlang::INT{0});
@@ -885,13 +892,19 @@ CConfigManager::CConfigManager() {
             "https://wiki.hypr.land/Configuring/Variables/#debug");
     }
 
-    Debug::m_disableLogs = rc<int64_t* const*>(m_config->getConfigValuePtr("debug:disable_logs")->getDataStaticPtr());
     Debug::m_disableTime = rc<int64_t* const*>(m_config->getConfigValuePtr("debug:disable_time")->getDataStaticPtr());
+    updateLogOptions();
 
     if (g_pEventLoopManager && ERR.has_value())
         g_pEventLoopManager->doLater([ERR] { g_pHyprError->queueCreate(ERR.value(), CHyprColor{1.0, 0.1, 0.1, 1.0}); });
 }
 
+void CConfigManager::updateLogOptions() {
+    // copied, the log writer thread can't read config values while they're being parsed
+    Debug::m_disableLogs = std::any_cast<Hyprlang::INT>(m_config->getConfigValue("debug:disable_logs"));
+    Debug::m_coloredLogs = std::any_cast<Hyprlang::INT>(m_config->getConfigValue("debug:colored_stdout_logs"));
+}
+
 void CConfigManager::reloadRuleConfigs() {
     // FIXME: this should also remove old values if they are removed
 
@@ -1287,6 +1300,8 @@ void CConfigManager::postConfigReload(const Hyprlang::CParseResult& result) {
         w->uncacheWindowDecos();
     }
 
+    g_pLayoutManager->getCurrentLayout()->invalidateTiledState();
+
     static auto PZOOMFACTOR = CConfigValue<Hyprlang::FLOAT>("cursor:zoom_factor");
     for (auto const& m : g_pCompositor->m_monitors) {
         *(m->m_cursorZoom) = *PZOOMFACTOR;
@@ -1375,7 +1390,7 @@ void CConfigManager::postConfigReload(const Hyprlang::CParseResult& result) {
     if (Debug::m_disableStdout && m_isFirstLaunch)
         Debug::log(LOG, "Disabling stdout logs! Check the log for further logs.");
 
-    Debug::m_coloredLogs = rc<int64_t* const*>(m_config->getConfigValuePtr("debug:colored_stdout_logs")->getDataStaticPtr());
+    updateLogOptions();
 
     for (auto const& m : g_pCompositor->m_monitors) {
         // mark blur dirty
@@ -1423,11 +1438,15 @@ std::string CConfigManager::parseKeyword(const std::string& COMMAND, const std::
     const auto RET = m_config->parseDynamic(COMMAND.c_str(), VALUE.c_str());
 
     // invalidate layouts if they changed
+    g_pLayoutManager->getCurrentLayout()->invalidateTiledState();
     if (COMMAND == "monitor" || COMMAND.contains("gaps_") || COMMAND.starts_with("dwindle:") || COMMAND.starts_with("master:")) {
         for (auto const& m : g_pCompositor->m_monitors)
             g_pLayoutManager->getCurrentLayout()->recalculateMonitor(m->m_id);
     }
 
+    if (COMMAND.starts_with("debug:"))
+        updateLogOptions();
+
     // Update window border colors
     g_pCompositor->updateAllWindowsAnimatedDecorationValues();
 
@@ -2525,7 +2544,7 @@ std::optional<std::string> CConfigManager::handleUnbind(const std::string& comma
     const auto ARGS = CVarList(value);
 
     if (ARGS.size() == 1 && ARGS[0] == "all") {
-        g_pKeybindManager->m_keybinds.clear();
+        g_pKeybindManager->clearKeybinds();
         g_pKeybindManager->m_activeKeybinds.clear();
         g_pKeybindManager->m_lastLongPressKeybind.reset();
         return {};
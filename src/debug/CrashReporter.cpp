@@ -243,5 +243,6 @@ void NCrashReporter::createAndSaveCrash(int sig) {
 
     finalCrashReport += "\n\nLog tail:\n";
 
-    finalCrashReport += std::string_view(Debug::m_rollingLog).substr(Debug::m_rollingLog.find('\n') + 1);
+    const auto LOGTAIL = Debug::rollingLogNoWait();
+    finalCrashReport += std::string_view(LOGTAIL).substr(LOGTAIL.find('\n') + 1);
 }
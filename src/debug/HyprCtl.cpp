@@ -15,7 +15,6 @@
 #include <sys/utsname.h>
 #include <sys/un.h>
 #include <unistd.h>
-#include <sys/poll.h>
 #include <filesystem>
 #include <ranges>
 #include <sys/eventfd.h>
@@ -40,12 +39,14 @@ using namespace Hyprutils::OS;
 #include "../devices/ITouch.hpp"
 #include "../devices/Tablet.hpp"
 #include "../protocols/GlobalShortcuts.hpp"
-#include "debug/RollingLogFollow.hpp"
 #include "config/ConfigManager.hpp"
 #include "helpers/MiscFunctions.hpp"
+#include "helpers/RegexCache.hpp"
 #include "../desktop/LayerSurface.hpp"
 #include "../desktop/rule/Engine.hpp"
 #include "../desktop/state/FocusState.hpp"
+#include "../helpers/MonitorFrameScheduler.hpp"
+#include "Telemetry.hpp"
 #include "../version.h"
 
 #include "../Compositor.hpp"
@@ -199,13 +200,20 @@ std::string CHyprCtl::getTearingBlockedReason(Hyprutils::Memory::CSharedPointer<
 }
 
 std::string CHyprCtl::getMonitorData(Hyprutils::Memory::CSharedPointer<CMonitor> m, eHyprCtlOutputFormat format) {
-    std::string result;
+    CJSONWriter out;
+    appendMonitorData(out, m, format);
+    return out.take();
+}
+
+void CHyprCtl::appendMonitorData(CJSONWriter& out, Hyprutils::Memory::CSharedPointer<CMonitor> m, eHyprCtlOutputFormat format) {
     if (!m->m_output || m->m_id == -1)
-        return "";
+        return;
+
+    const auto DEADLINE = m->m_frameScheduler ? m->m_frameScheduler->m_deadline : CMonitorFrameScheduler::SDeadlineStats{};
 
     if (format == eHyprCtlOutputFormat::FORMAT_JSON) {
 
-        result += std::format(
+        out.format(
             R"#({{
     "id": {},
     "name": "{}",
@@ -248,29 +256,36 @@ std::string CHyprCtl::getMonitorData(Hyprutils::Memory::CSharedPointer<CMonitor>
     "sdrBrightness": {:.2f},
     "sdrSaturation": {:.2f},
     "sdrMinLuminance": {:.2f},
-    "sdrMaxLuminance": {}
+    "sdrMaxLuminance": {},
+    "renderDeadline": {{
+        "estimateMs": {:.2f},
+        "delayMs": {:.2f},
+        "misses": {}
+    }}
 }},)#",
 
-            m->m_id, escapeJSONStrings(m->m_name), escapeJSONStrings(m->m_shortDescription), escapeJSONStrings(m->m_output->make), escapeJSONStrings(m->m_output->model),
-            escapeJSONStrings(m->m_output->serial), sc<int>(m->m_pixelSize.x), sc<int>(m->m_pixelSize.y), sc<int>(m->m_output->physicalSize.x),
-            sc<int>(m->m_output->physicalSize.y), m->m_refreshRate, sc<int>(m->m_position.x), sc<int>(m->m_position.y), m->activeWorkspaceID(),
-            (!m->m_activeWorkspace ? "" : escapeJSONStrings(m->m_activeWorkspace->m_name)), m->activeSpecialWorkspaceID(),
-            escapeJSONStrings(m->m_activeSpecialWorkspace ? m->m_activeSpecialWorkspace->m_name : ""), sc<int>(m->m_reservedTopLeft.x), sc<int>(m->m_reservedTopLeft.y),
+            m->m_id, jsonEscaped(m->m_name), jsonEscaped(m->m_shortDescription), jsonEscaped(m->m_output->make), jsonEscaped(m->m_output->model),
+            jsonEscaped(m->m_output->serial), sc<int>(m->m_pixelSize.x), sc<int>(m->m_pixelSize.y), sc<int>(m->m_output->physicalSize.x), sc<int>(m->m_output->physicalSize.y),
+            m->m_refreshRate, sc<int>(m->m_position.x), sc<int>(m->m_position.y), m->activeWorkspaceID(),
+            jsonEscaped(m->m_activeWorkspace ? std::string_view{m->m_activeWorkspace->m_name} : ""), m->activeSpecialWorkspaceID(),
+            jsonEscaped(m->m_activeSpecialWorkspace ? std::string_view{m->m_activeSpecialWorkspace->m_name} : ""), sc<int>(m->m_reservedTopLeft.x), sc<int>(m->m_reservedTopLeft.y),
             sc<int>(m->m_reservedBottomRight.x), sc<int>(m->m_reservedBottomRight.y), m->m_scale, sc<int>(m->m_transform),
             (m == Desktop::focusState()->monitor() ? "true" : "false"), (m->m_dpmsStatus ? "true" : "false"), (m->m_output->state->state().adaptiveSync ? "true" : "false"),
             rc<uint64_t>(m->m_solitaryClient.get()), getSolitaryBlockedReason(m, format), (m->m_tearingState.activelyTearing ? "true" : "false"),
             getTearingBlockedReason(m, format), rc<uint64_t>(m->m_lastScanout.get()), getDSBlockedReason(m, format), (m->m_enabled ? "false" : "true"),
             formatToString(m->m_output->state->state().drmFormat), m->m_mirrorOf ? std::format("{}", m->m_mirrorOf->m_id) : "none", availableModesForOutput(m, format),
-            (NCMType::toString(m->m_cmType)), (m->m_sdrBrightness), (m->m_sdrSaturation), (m->m_sdrMinLuminance), (m->m_sdrMaxLuminance));
+            (NCMType::toString(m->m_cmType)), (m->m_sdrBrightness), (m->m_sdrSaturation), (m->m_sdrMinLuminance), (m->m_sdrMaxLuminance), DEADLINE.estimateMs,
+            DEADLINE.delayMs, DEADLINE.misses);
 
     } else {
-        result += std::format(
+        out.format(
             "Monitor {} (ID {}):\n\t{}x{}@{:.5f} at {}x{}\n\tdescription: {}\n\tmake: {}\n\tmodel: {}\n\tphysical size (mm): {}x{}\n\tserial: {}\n\tactive workspace: {} ({})\n\t"
             "special workspace: {} ({})\n\treserved: {} {} {} {}\n\tscale: {:.2f}\n\ttransform: {}\n\tfocused: {}\n\t"
             "dpmsStatus: {}\n\tvrr: {}\n\tsolitary: {:x}\n\tsolitaryBlockedBy: {}\n\tactivelyTearing: {}\n\ttearingBlockedBy: {}\n\tdirectScanoutTo: "
             "{:x}\n\tdirectScanoutBlockedBy: {}\n\tdisabled: "
             "{}\n\tcurrentFormat: {}\n\tmirrorOf: "
-            "{}\n\tavailableModes: {}\n\tcolorManagementPreset: {}\n\tsdrBrightness: {:.2f}\n\tsdrSaturation: {:.2f}\n\tsdrMinLuminance: {:.2f}\n\tsdrMaxLuminance: {}\n\n",
+            "{}\n\tavailableModes: {}\n\tcolorManagementPreset: {}\n\tsdrBrightness: {:.2f}\n\tsdrSaturation: {:.2f}\n\tsdrMinLuminance: {:.2f}\n\tsdrMaxLuminance: {}\n\t"
+            "renderDeadline: estimate {:.2f}ms, delay {:.2f}ms, misses {}\n\n",
             m->m_name, m->m_id, sc<int>(m->m_pixelSize.x), sc<int>(m->m_pixelSize.y), m->m_refreshRate, sc<int>(m->m_position.x), sc<int>(m->m_position.y), m->m_shortDescription,
             m->m_output->make, m->m_output->model, sc<int>(m->m_output->physicalSize.x), sc<int>(m->m_output->physicalSize.y), m->m_output->serial, m->activeWorkspaceID(),
             (!m->m_activeWorkspace ? "" : m->m_activeWorkspace->m_name), m->activeSpecialWorkspaceID(), (m->m_activeSpecialWorkspace ? m->m_activeSpecialWorkspace->m_name : ""),
@@ -279,10 +294,8 @@ std::string CHyprCtl::getMonitorData(Hyprutils::Memory::CSharedPointer<CMonitor>
             rc<uint64_t>(m->m_solitaryClient.get()), getSolitaryBlockedReason(m, format), m->m_tearingState.activelyTearing, getTearingBlockedReason(m, format),
             rc<uint64_t>(m->m_lastScanout.get()), getDSBlockedReason(m, format), !m->m_enabled, formatToString(m->m_output->state->state().drmFormat),
             m->m_mirrorOf ? std::format("{}", m->m_mirrorOf->m_id) : "none", availableModesForOutput(m, format), (NCMType::toString(m->m_cmType)), (m->m_sdrBrightness),
-            (m->m_sdrSaturation), (m->m_sdrMinLuminance), (m->m_sdrMaxLuminance));
+            (m->m_sdrSaturation), (m->m_sdrMinLuminance), (m->m_sdrMaxLuminance), DEADLINE.estimateMs, DEADLINE.delayMs, DEADLINE.misses);
     }
-
-    return result;
 }
 
 static std::string monitorsRequest(eHyprCtlOutputFormat format, std::string request) {
@@ -295,64 +308,75 @@ static std::string monitorsRequest(eHyprCtlOutputFormat format, std::string requ
     if (vars.size() == 2 && vars[1] == "all")
         allMonitors = true;
 
-    std::string result = "";
+    CJSONWriter out;
     if (format == eHyprCtlOutputFormat::FORMAT_JSON) {
-        result += "[";
+        out.append("[");
 
         for (auto const& m : allMonitors ? g_pCompositor->m_realMonitors : g_pCompositor->m_monitors) {
-            result += CHyprCtl::getMonitorData(m, format);
+            CHyprCtl::appendMonitorData(out, m, format);
         }
 
-        trimTrailingComma(result);
+        out.trimTrailingComma();
 
-        result += "]";
+        out.append("]");
     } else {
         for (auto const& m : allMonitors ? g_pCompositor->m_realMonitors : g_pCompositor->m_monitors) {
             if (!m->m_output || m->m_id == -1)
                 continue;
 
-            result += CHyprCtl::getMonitorData(m, format);
+            CHyprCtl::appendMonitorData(out, m, format);
         }
     }
 
-    return result;
+    return out.take();
 }
 
-static std::string getTagsData(PHLWINDOW w, eHyprCtlOutputFormat format) {
-    const auto tags = w->m_ruleApplicator->m_tagKeeper.getTags();
+static void appendTagsData(CJSONWriter& out, PHLWINDOW w, eHyprCtlOutputFormat format) {
+    const bool isJson = format == eHyprCtlOutputFormat::FORMAT_JSON;
+    bool       first  = true;
+
+    for (const auto& tag : w->m_ruleApplicator->m_tagKeeper.getTags()) {
+        if (!first)
+            out.append(", ");
+        first = false;
 
-    if (format == eHyprCtlOutputFormat::FORMAT_JSON)
-        return std::ranges::fold_left(tags, std::string(),
-                                      [](const std::string& a, const std::string& b) { return a.empty() ? std::format("\"{}\"", b) : std::format("{}, \"{}\"", a, b); });
-    else
-        return std::ranges::fold_left(tags, std::string(), [](const std::string& a, const std::string& b) { return a.empty() ? b : a + ", " + b; });
+        if (isJson)
+            out.format("\"{}\"", tag);
+        else
+            out.append(tag);
+    }
 }
 
-static std::string getGroupedData(PHLWINDOW w, eHyprCtlOutputFormat format) {
+static void appendGroupedData(CJSONWriter& out, PHLWINDOW w, eHyprCtlOutputFormat format) {
     const bool isJson = format == eHyprCtlOutputFormat::FORMAT_JSON;
-    if (w->m_groupData.pNextWindow.expired())
-        return isJson ? "" : "0";
-
-    std::ostringstream result;
+    if (w->m_groupData.pNextWindow.expired()) {
+        if (!isJson)
+            out.append("0");
+        return;
+    }
 
-    PHLWINDOW          head = w->getGroupHead();
-    PHLWINDOW          curr = head;
+    PHLWINDOW head = w->getGroupHead();
+    PHLWINDOW curr = head;
     while (true) {
         if (isJson)
-            result << std::format("\"0x{:x}\"", rc<uintptr_t>(curr.get()));
+            out.format("\"0x{:x}\"", rc<uintptr_t>(curr.get()));
         else
-            result << std::format("{:x}", rc<uintptr_t>(curr.get()));
+            out.format("{:x}", rc<uintptr_t>(curr.get()));
         curr = curr->m_groupData.pNextWindow.lock();
         // We've wrapped around to the start, break out without trailing comma
         if (curr == head)
             break;
-        result << (isJson ? ", " : ",");
+        out.append(isJson ? ", " : ",");
     }
-
-    return result.str();
 }
 
 std::string CHyprCtl::getWindowData(PHLWINDOW w, eHyprCtlOutputFormat format) {
+    CJSONWriter out;
+    appendWindowData(out, w, format);
+    return out.take();
+}
+
+void CHyprCtl::appendWindowData(CJSONWriter& out, PHLWINDOW w, eHyprCtlOutputFormat format) {
     auto getFocusHistoryID = [](PHLWINDOW wnd) -> int {
         for (size_t i = 0; i < Desktop::focusState()->windowHistory().size(); ++i) {
             if (Desktop::focusState()->windowHistory()[i].lock() == wnd)
@@ -361,8 +385,10 @@ std::string CHyprCtl::getWindowData(PHLWINDOW w, eHyprCtlOutputFormat format) {
         return -1;
     };
 
+    const std::string_view WORKSPACENAME = w->m_workspace ? std::string_view{w->m_workspace->m_name} : "";
+
     if (format == eHyprCtlOutputFormat::FORMAT_JSON) {
-        return std::format(
+        out.format(
             R"#({{
     "address": "0x{:x}",
     "mapped": {},
@@ -385,8 +411,22 @@ std::string CHyprCtl::getWindowData(PHLWINDOW w, eHyprCtlOutputFormat format) {
     "pinned": {},
     "fullscreen": {},
     "fullscreenClient": {},
-    "grouped": [{}],
-    "tags": [{}],
+    "grouped": [)#",
+            rc<uintptr_t>(w.get()), (w->m_isMapped ? "true" : "false"), (w->isHidden() ? "true" : "false"), sc<int>(w->m_realPosition->goal().x),
+            sc<int>(w->m_realPosition->goal().y), sc<int>(w->m_realSize->goal().x), sc<int>(w->m_realSize->goal().y), w->m_workspace ? w->workspaceID() : WORKSPACE_INVALID,
+            jsonEscaped(WORKSPACENAME), (sc<int>(w->m_isFloating) == 1 ? "true" : "false"), (w->m_isPseudotiled ? "true" : "false"), w->monitorID(), jsonEscaped(w->m_class),
+            jsonEscaped(w->m_title), jsonEscaped(w->m_initialClass), jsonEscaped(w->m_initialTitle), w->getPID(), (sc<int>(w->m_isX11) == 1 ? "true" : "false"),
+            (w->m_pinned ? "true" : "false"), sc<uint8_t>(w->m_fullscreenState.internal), sc<uint8_t>(w->m_fullscreenState.client));
+
+        appendGroupedData(out, w, format);
+        out.append("],\n    \"tags\": [");
+        appendTagsData(out, w, format);
+
+        const auto XDGTAG         = w->xdgTag();
+        const auto XDGDESCRIPTION = w->xdgDescription();
+
+        out.format(
+            R"#(],
     "swallowing": "0x{:x}",
     "focusHistoryID": {},
     "inhibitingIdle": {},
@@ -394,64 +434,70 @@ std::string CHyprCtl::getWindowData(PHLWINDOW w, eHyprCtlOutputFormat format) {
     "xdgDescription": "{}",
     "contentType": "{}"
 }},)#",
-            rc<uintptr_t>(w.get()), (w->m_isMapped ? "true" : "false"), (w->isHidden() ? "true" : "false"), sc<int>(w->m_realPosition->goal().x),
-            sc<int>(w->m_realPosition->goal().y), sc<int>(w->m_realSize->goal().x), sc<int>(w->m_realSize->goal().y), w->m_workspace ? w->workspaceID() : WORKSPACE_INVALID,
-            escapeJSONStrings(!w->m_workspace ? "" : w->m_workspace->m_name), (sc<int>(w->m_isFloating) == 1 ? "true" : "false"), (w->m_isPseudotiled ? "true" : "false"),
-            w->monitorID(), escapeJSONStrings(w->m_class), escapeJSONStrings(w->m_title), escapeJSONStrings(w->m_initialClass), escapeJSONStrings(w->m_initialTitle), w->getPID(),
-            (sc<int>(w->m_isX11) == 1 ? "true" : "false"), (w->m_pinned ? "true" : "false"), sc<uint8_t>(w->m_fullscreenState.internal), sc<uint8_t>(w->m_fullscreenState.client),
-            getGroupedData(w, format), getTagsData(w, format), rc<uintptr_t>(w->m_swallowed.get()), getFocusHistoryID(w),
-            (g_pInputManager->isWindowInhibiting(w, false) ? "true" : "false"), escapeJSONStrings(w->xdgTag().value_or("")), escapeJSONStrings(w->xdgDescription().value_or("")),
-            escapeJSONStrings(NContentType::toString(w->getContentType())));
+            rc<uintptr_t>(w->m_swallowed.get()), getFocusHistoryID(w), (g_pInputManager->isWindowInhibiting(w, false) ? "true" : "false"),
+            jsonEscaped(XDGTAG ? std::string_view{*XDGTAG} : ""), jsonEscaped(XDGDESCRIPTION ? std::string_view{*XDGDESCRIPTION} : ""),
+            jsonEscaped(NContentType::toString(w->getContentType())));
     } else {
-        return std::format(
-            "Window {:x} -> {}:\n\tmapped: {}\n\thidden: {}\n\tat: {},{}\n\tsize: {},{}\n\tworkspace: {} ({})\n\tfloating: {}\n\tpseudo: {}\n\tmonitor: {}\n\tclass: {}\n\ttitle: "
-            "{}\n\tinitialClass: {}\n\tinitialTitle: {}\n\tpid: "
-            "{}\n\txwayland: {}\n\tpinned: "
-            "{}\n\tfullscreen: {}\n\tfullscreenClient: {}\n\tgrouped: {}\n\ttags: {}\n\tswallowing: {:x}\n\tfocusHistoryID: {}\n\tinhibitingIdle: {}\n\txdgTag: "
-            "{}\n\txdgDescription: {}\n\tcontentType: {}\n\n",
-            rc<uintptr_t>(w.get()), w->m_title, sc<int>(w->m_isMapped), sc<int>(w->isHidden()), sc<int>(w->m_realPosition->goal().x), sc<int>(w->m_realPosition->goal().y),
-            sc<int>(w->m_realSize->goal().x), sc<int>(w->m_realSize->goal().y), w->m_workspace ? w->workspaceID() : WORKSPACE_INVALID,
-            (!w->m_workspace ? "" : w->m_workspace->m_name), sc<int>(w->m_isFloating), sc<int>(w->m_isPseudotiled), w->monitorID(), w->m_class, w->m_title, w->m_initialClass,
-            w->m_initialTitle, w->getPID(), sc<int>(w->m_isX11), sc<int>(w->m_pinned), sc<uint8_t>(w->m_fullscreenState.internal), sc<uint8_t>(w->m_fullscreenState.client),
-            getGroupedData(w, format), getTagsData(w, format), rc<uintptr_t>(w->m_swallowed.get()), getFocusHistoryID(w), sc<int>(g_pInputManager->isWindowInhibiting(w, false)),
-            w->xdgTag().value_or(""), w->xdgDescription().value_or(""), NContentType::toString(w->getContentType()));
+        out.format("Window {:x} -> {}:\n\tmapped: {}\n\thidden: {}\n\tat: {},{}\n\tsize: {},{}\n\tworkspace: {} ({})\n\tfloating: {}\n\tpseudo: {}\n\tmonitor: {}\n\tclass: {}\n\ttitle: "
+                   "{}\n\tinitialClass: {}\n\tinitialTitle: {}\n\tpid: "
+                   "{}\n\txwayland: {}\n\tpinned: "
+                   "{}\n\tfullscreen: {}\n\tfullscreenClient: {}\n\tgrouped: ",
+                   rc<uintptr_t>(w.get()), w->m_title, sc<int>(w->m_isMapped), sc<int>(w->isHidden()), sc<int>(w->m_realPosition->goal().x), sc<int>(w->m_realPosition->goal().y),
+                   sc<int>(w->m_realSize->goal().x), sc<int>(w->m_realSize->goal().y), w->m_workspace ? w->workspaceID() : WORKSPACE_INVALID, WORKSPACENAME,
+                   sc<int>(w->m_isFloating), sc<int>(w->m_isPseudotiled), w->monitorID(), w->m_class, w->m_title, w->m_initialClass, w->m_initialTitle, w->getPID(),
+                   sc<int>(w->m_isX11), sc<int>(w->m_pinned), sc<uint8_t>(w->m_fullscreenState.internal), sc<uint8_t>(w->m_fullscreenState.client));
+
+        appendGroupedData(out, w, format);
+        out.append("\n\ttags: ");
+        appendTagsData(out, w, format);
+
+        out.format("\n\tswallowing: {:x}\n\tfocusHistoryID: {}\n\tinhibitingIdle: {}\n\txdgTag: "
+                   "{}\n\txdgDescription: {}\n\tcontentType: {}\n\n",
+                   rc<uintptr_t>(w->m_swallowed.get()), getFocusHistoryID(w), sc<int>(g_pInputManager->isWindowInhibiting(w, false)), w->xdgTag().value_or(""),
+                   w->xdgDescription().value_or(""), NContentType::toString(w->getContentType()));
     }
 }
 
 static std::string clientsRequest(eHyprCtlOutputFormat format, std::string request) {
-    std::string result = "";
+    CJSONWriter out;
     if (format == eHyprCtlOutputFormat::FORMAT_JSON) {
-        result += "[";
+        out.append("[");
 
         for (auto const& w : g_pCompositor->m_windows) {
             if (!w->m_isMapped && !g_pHyprCtl->m_currentRequestParams.all)
                 continue;
 
-            result += CHyprCtl::getWindowData(w, format);
+            CHyprCtl::appendWindowData(out, w, format);
         }
 
-        trimTrailingComma(result);
+        out.trimTrailingComma();
 
-        result += "]";
+        out.append("]");
     } else {
         for (auto const& w : g_pCompositor->m_windows) {
             if (!w->m_isMapped && !g_pHyprCtl->m_currentRequestParams.all)
                 continue;
 
-            result += CHyprCtl::getWindowData(w, format);
+            CHyprCtl::appendWindowData(out, w, format);
         }
 
-        if (result.empty())
+        if (out.empty())
             return "no open windows";
     }
-    return result;
+    return out.take();
 }
 
 std::string CHyprCtl::getWorkspaceData(PHLWORKSPACE w, eHyprCtlOutputFormat format) {
+    CJSONWriter out;
+    appendWorkspaceData(out, w, format);
+    return out.take();
+}
+
+void CHyprCtl::appendWorkspaceData(CJSONWriter& out, PHLWORKSPACE w, eHyprCtlOutputFormat format) {
     const auto PLASTW   = w->getLastFocusedWindow();
     const auto PMONITOR = w->m_monitor.lock();
     if (format == eHyprCtlOutputFormat::FORMAT_JSON) {
-        return std::format(R"#({{
+        out.format(R"#({{
     "id": {},
     "name": "{}",
     "monitor": "{}",
@@ -462,11 +508,11 @@ std::string CHyprCtl::getWorkspaceData(PHLWORKSPACE w, eHyprCtlOutputFormat form
     "lastwindowtitle": "{}",
     "ispersistent": {}
 }})#",
-                           w->m_id, escapeJSONStrings(w->m_name), escapeJSONStrings(PMONITOR ? PMONITOR->m_name : "?"),
-                           escapeJSONStrings(PMONITOR ? std::to_string(PMONITOR->m_id) : "null"), w->getWindows(), w->m_hasFullscreenWindow ? "true" : "false",
-                           rc<uintptr_t>(PLASTW.get()), PLASTW ? escapeJSONStrings(PLASTW->m_title) : "", w->isPersistent() ? "true" : "false");
+                   w->m_id, jsonEscaped(w->m_name), jsonEscaped(PMONITOR ? std::string_view{PMONITOR->m_name} : "?"),
+                   PMONITOR ? std::to_string(PMONITOR->m_id) : "null", w->getWindows(), w->m_hasFullscreenWindow ? "true" : "false", rc<uintptr_t>(PLASTW.get()),
+                   jsonEscaped(PLASTW ? std::string_view{PLASTW->m_title} : ""), w->isPersistent() ? "true" : "false");
     } else {
-        return std::format(
+        out.format(
             "workspace ID {} ({}) on monitor {}:\n\tmonitorID: {}\n\twindows: {}\n\thasfullscreen: {}\n\tlastwindow: 0x{:x}\n\tlastwindowtitle: {}\n\tispersistent: {}\n\n",
             w->m_id, w->m_name, PMONITOR ? PMONITOR->m_name : "?", PMONITOR ? std::to_string(PMONITOR->m_id) : "null", w->getWindows(), sc<int>(w->m_hasFullscreenWindow),
             rc<uintptr_t>(PLASTW.get()), PLASTW ? PLASTW->m_title : "", sc<int>(w->isPersistent()));
@@ -538,24 +584,24 @@ static std::string activeWorkspaceRequest(eHyprCtlOutputFormat format, std::stri
 }
 
 static std::string workspacesRequest(eHyprCtlOutputFormat format, std::string request) {
-    std::string result = "";
+    CJSONWriter out;
 
     if (format == eHyprCtlOutputFormat::FORMAT_JSON) {
-        result += "[";
+        out.append("[");
         for (auto const& w : g_pCompositor->getWorkspaces()) {
-            result += CHyprCtl::getWorkspaceData(w.lock(), format);
-            result += ",";
+            CHyprCtl::appendWorkspaceData(out, w.lock(), format);
+            out.append(",");
         }
 
-        trimTrailingComma(result);
-        result += "]";
+        out.trimTrailingComma();
+        out.append("]");
     } else {
         for (auto const& w : g_pCompositor->getWorkspaces()) {
-            result += CHyprCtl::getWorkspaceData(w.lock(), format);
+            CHyprCtl::appendWorkspaceData(out, w.lock(), format);
         }
     }
 
-    return result;
+    return out.take();
 }
 
 static std::string workspaceRulesRequest(eHyprCtlOutputFormat format, std::string request) {
@@ -593,27 +639,27 @@ static std::string activeWindowRequest(eHyprCtlOutputFormat format, std::string
 }
 
 static std::string layersRequest(eHyprCtlOutputFormat format, std::string request) {
-    std::string result = "";
+    CJSONWriter out;
 
     if (format == eHyprCtlOutputFormat::FORMAT_JSON) {
-        result += "{\n";
+        out.append("{\n");
 
         for (auto const& mon : g_pCompositor->m_monitors) {
-            result += std::format(
+            out.format(
                 R"#("{}": {{
     "levels": {{
 )#",
-                escapeJSONStrings(mon->m_name));
+                jsonEscaped(mon->m_name));
 
             int layerLevel = 0;
             for (auto const& level : mon->m_layerSurfaceLayers) {
-                result += std::format(
+                out.format(
                     R"#(
         "{}": [
 )#",
                     layerLevel);
                 for (auto const& layer : level) {
-                    result += std::format(
+                    out.format(
                         R"#(                {{
                     "address": "0x{:x}",
                     "x": {},
@@ -624,48 +670,48 @@ static std::string layersRequest(eHyprCtlOutputFormat format, std::string reques
                     "pid": {}
                 }},)#",
                         rc<uintptr_t>(layer.get()), layer->m_geometry.x, layer->m_geometry.y, layer->m_geometry.width, layer->m_geometry.height,
-                        escapeJSONStrings(layer->m_namespace), layer->getPID());
+                        jsonEscaped(layer->m_namespace), layer->getPID());
                 }
 
-                trimTrailingComma(result);
+                out.trimTrailingComma();
 
                 if (!level.empty())
-                    result += "\n        ";
+                    out.append("\n        ");
 
-                result += "],";
+                out.append("],");
 
                 layerLevel++;
             }
 
-            trimTrailingComma(result);
+            out.trimTrailingComma();
 
-            result += "\n    }\n},";
+            out.append("\n    }\n},");
         }
 
-        trimTrailingComma(result);
+        out.trimTrailingComma();
 
-        result += "\n}\n";
+        out.append("\n}\n");
 
     } else {
         for (auto const& mon : g_pCompositor->m_monitors) {
-            result += std::format("Monitor {}:\n", mon->m_name);
+            out.format("Monitor {}:\n", mon->m_name);
             int                                     layerLevel = 0;
             static const std::array<std::string, 4> levelNames = {"background", "bottom", "top", "overlay"};
             for (auto const& level : mon->m_layerSurfaceLayers) {
-                result += std::format("\tLayer level {} ({}):\n", layerLevel, levelNames[layerLevel]);
+                out.format("\tLayer level {} ({}):\n", layerLevel, levelNames[layerLevel]);
 
                 for (auto const& layer : level) {
-                    result += std::format("\t\tLayer {:x}: xywh: {} {} {} {}, namespace: {}, pid: {}\n", rc<uintptr_t>(layer.get()), layer->m_geometry.x, layer->m_geometry.y,
-                                          layer->m_geometry.width, layer->m_geometry.height, layer->m_namespace, layer->getPID());
+                    out.format("\t\tLayer {:x}: xywh: {} {} {} {}, namespace: {}, pid: {}\n", rc<uintptr_t>(layer.get()), layer->m_geometry.x, layer->m_geometry.y,
+                               layer->m_geometry.width, layer->m_geometry.height, layer->m_namespace, layer->getPID());
                 }
 
                 layerLevel++;
             }
-            result += "\n\n";
+            out.append("\n\n");
         }
     }
 
-    return result;
+    return out.take();
 }
 
 static std::string layoutsRequest(eHyprCtlOutputFormat format, std::string request) {
@@ -714,7 +760,7 @@ static std::string configErrorsRequest(eHyprCtlOutputFormat format, std::string
 }
 
 static std::string devicesRequest(eHyprCtlOutputFormat format, std::string request) {
-    std::string result = "";
+    CJSONWriter out;
 
     auto        getModState = [](SP<IKeyboard> keyboard, const char* xkbModName) -> bool {
         auto IDX = xkb_keymap_mod_get_index(keyboard->m_xkbKeymap, xkbModName);
@@ -726,30 +772,30 @@ static std::string devicesRequest(eHyprCtlOutputFormat format, std::string reque
     };
 
     if (format == eHyprCtlOutputFormat::FORMAT_JSON) {
-        result += "{\n";
-        result += "\"mice\": [\n";
+        out.append("{\n");
+        out.append("\"mice\": [\n");
 
         for (auto const& m : g_pInputManager->m_pointers) {
-            result += std::format(
+            out.format(
                 R"#(    {{
         "address": "0x{:x}",
         "name": "{}",
         "defaultSpeed": {:.5f},
         "scrollFactor": {:.2f}
     }},)#",
-                rc<uintptr_t>(m.get()), escapeJSONStrings(m->m_hlName),
+                rc<uintptr_t>(m.get()), jsonEscaped(m->m_hlName),
                 m->aq() && m->aq()->getLibinputHandle() ? libinput_device_config_accel_get_default_speed(m->aq()->getLibinputHandle()) : 0.f, m->m_scrollFactor.value_or(-1));
         }
 
-        trimTrailingComma(result);
-        result += "\n],\n";
+        out.trimTrailingComma();
+        out.append("\n],\n");
 
-        result += "\"keyboards\": [\n";
+        out.append("\"keyboards\": [\n");
         for (auto const& k : g_pInputManager->m_keyboards) {
             const auto INDEX_OPT = k->getActiveLayoutIndex();
             const auto KI        = INDEX_OPT.has_value() ? std::to_string(INDEX_OPT.value()) : "none";
             const auto KM        = k->getActiveLayout();
-            result += std::format(
+            out.format(
                 R"#(    {{
         "address": "0x{:x}",
         "name": "{}",
@@ -764,18 +810,18 @@ static std::string devicesRequest(eHyprCtlOutputFormat format, std::string reque
         "numLock": {},
         "main": {}
     }},)#",
-                rc<uintptr_t>(k.get()), escapeJSONStrings(k->m_hlName), escapeJSONStrings(k->m_currentRules.rules), escapeJSONStrings(k->m_currentRules.model),
-                escapeJSONStrings(k->m_currentRules.layout), escapeJSONStrings(k->m_currentRules.variant), escapeJSONStrings(k->m_currentRules.options), KI, escapeJSONStrings(KM),
+                rc<uintptr_t>(k.get()), jsonEscaped(k->m_hlName), jsonEscaped(k->m_currentRules.rules), jsonEscaped(k->m_currentRules.model), jsonEscaped(k->m_currentRules.layout),
+                jsonEscaped(k->m_currentRules.variant), jsonEscaped(k->m_currentRules.options), KI, jsonEscaped(KM),
                 (getModState(k, XKB_MOD_NAME_CAPS) ? "true" : "false"), (getModState(k, XKB_MOD_NAME_NUM) ? "true" : "false"), (k->m_active ? "true" : "false"));
         }
 
-        trimTrailingComma(result);
-        result += "\n],\n";
+        out.trimTrailingComma();
+        out.append("\n],\n");
 
-        result += "\"tablets\": [\n";
+        out.append("\"tablets\": [\n");
 
         for (auto const& d : g_pInputManager->m_tabletPads) {
-            result += std::format(
+            out.format(
                 R"#(    {{
         "address": "0x{:x}",
         "type": "tabletPad",
@@ -784,20 +830,20 @@ static std::string devicesRequest(eHyprCtlOutputFormat format, std::string reque
             "name": "{}"
         }}
     }},)#",
-                rc<uintptr_t>(d.get()), rc<uintptr_t>(d->m_parent.get()), escapeJSONStrings(d->m_parent ? d->m_parent->m_hlName : ""));
+                rc<uintptr_t>(d.get()), rc<uintptr_t>(d->m_parent.get()), jsonEscaped(d->m_parent ? std::string_view{d->m_parent->m_hlName} : ""));
         }
 
         for (auto const& d : g_pInputManager->m_tablets) {
-            result += std::format(
+            out.format(
                 R"#(    {{
         "address": "0x{:x}",
         "name": "{}"
     }},)#",
-                rc<uintptr_t>(d.get()), escapeJSONStrings(d->m_hlName));
+                rc<uintptr_t>(d.get()), jsonEscaped(d->m_hlName));
         }
 
         for (auto const& d : g_pInputManager->m_tabletTools) {
-            result += std::format(
+            out.format(
                 R"#(    {{
         "address": "0x{:x}",
         "type": "tabletTool",
@@ -805,91 +851,90 @@ static std::string devicesRequest(eHyprCtlOutputFormat format, std::string reque
                 rc<uintptr_t>(d.get()));
         }
 
-        trimTrailingComma(result);
-        result += "\n],\n";
+        out.trimTrailingComma();
+        out.append("\n],\n");
 
-        result += "\"touch\": [\n";
+        out.append("\"touch\": [\n");
 
         for (auto const& d : g_pInputManager->m_touches) {
-            result += std::format(
+            out.format(
                 R"#(    {{
         "address": "0x{:x}",
         "name": "{}"
     }},)#",
-                rc<uintptr_t>(d.get()), escapeJSONStrings(d->m_hlName));
+                rc<uintptr_t>(d.get()), jsonEscaped(d->m_hlName));
         }
 
-        trimTrailingComma(result);
-        result += "\n],\n";
+        out.trimTrailingComma();
+        out.append("\n],\n");
 
-        result += "\"switches\": [\n";
+        out.append("\"switches\": [\n");
 
         for (auto const& d : g_pInputManager->m_switches) {
-            result += std::format(
+            out.format(
                 R"#(    {{
         "address": "0x{:x}",
         "name": "{}"
     }},)#",
-                rc<uintptr_t>(&d), escapeJSONStrings(d.pDevice ? d.pDevice->getName() : ""));
+                rc<uintptr_t>(&d), jsonEscaped(d.pDevice ? d.pDevice->getName() : ""));
         }
 
-        trimTrailingComma(result);
-        result += "\n]\n";
+        out.trimTrailingComma();
+        out.append("\n]\n");
 
-        result += "}\n";
+        out.append("}\n");
 
     } else {
-        result += "mice:\n";
+        out.append("mice:\n");
 
         for (auto const& m : g_pInputManager->m_pointers) {
-            result += std::format("\tMouse at {:x}:\n\t\t{}\n\t\t\tdefault speed: {:.5f}\n\t\t\tscroll factor: {:.2f}\n", rc<uintptr_t>(m.get()), m->m_hlName,
-                                  (m->aq() && m->aq()->getLibinputHandle() ? libinput_device_config_accel_get_default_speed(m->aq()->getLibinputHandle()) : 0.f),
-                                  m->m_scrollFactor.value_or(-1));
+            out.format("\tMouse at {:x}:\n\t\t{}\n\t\t\tdefault speed: {:.5f}\n\t\t\tscroll factor: {:.2f}\n", rc<uintptr_t>(m.get()), m->m_hlName,
+                       (m->aq() && m->aq()->getLibinputHandle() ? libinput_device_config_accel_get_default_speed(m->aq()->getLibinputHandle()) : 0.f),
+                       m->m_scrollFactor.value_or(-1));
         }
 
-        result += "\n\nKeyboards:\n";
+        out.append("\n\nKeyboards:\n");
 
         for (auto const& k : g_pInputManager->m_keyboards) {
             const auto INDEX_OPT = k->getActiveLayoutIndex();
             const auto KI        = INDEX_OPT.has_value() ? std::to_string(INDEX_OPT.value()) : "none";
             const auto KM        = k->getActiveLayout();
-            result += std::format("\tKeyboard at {:x}:\n\t\t{}\n\t\t\trules: r \"{}\", m \"{}\", l \"{}\", v \"{}\", o \"{}\"\n\t\t\tactive layout index: {}\n\t\t\tactive keymap: "
-                                  "{}\n\t\t\tcapsLock: "
-                                  "{}\n\t\t\tnumLock: {}\n\t\t\tmain: {}\n",
-                                  rc<uintptr_t>(k.get()), k->m_hlName, k->m_currentRules.rules, k->m_currentRules.model, k->m_currentRules.layout, k->m_currentRules.variant,
-                                  k->m_currentRules.options, KI, KM, (getModState(k, XKB_MOD_NAME_CAPS) ? "yes" : "no"), (getModState(k, XKB_MOD_NAME_NUM) ? "yes" : "no"),
-                                  (k->m_active ? "yes" : "no"));
+            out.format("\tKeyboard at {:x}:\n\t\t{}\n\t\t\trules: r \"{}\", m \"{}\", l \"{}\", v \"{}\", o \"{}\"\n\t\t\tactive layout index: {}\n\t\t\tactive keymap: "
+                       "{}\n\t\t\tcapsLock: "
+                       "{}\n\t\t\tnumLock: {}\n\t\t\tmain: {}\n",
+                       rc<uintptr_t>(k.get()), k->m_hlName, k->m_currentRules.rules, k->m_currentRules.model, k->m_currentRules.layout, k->m_currentRules.variant,
+                       k->m_currentRules.options, KI, KM, (getModState(k, XKB_MOD_NAME_CAPS) ? "yes" : "no"), (getModState(k, XKB_MOD_NAME_NUM) ? "yes" : "no"),
+                       (k->m_active ? "yes" : "no"));
         }
 
-        result += "\n\nTablets:\n";
+        out.append("\n\nTablets:\n");
 
         for (auto const& d : g_pInputManager->m_tabletPads) {
-            result +=
-                std::format("\tTablet Pad at {:x} (belongs to {:x} -> {})\n", rc<uintptr_t>(d.get()), rc<uintptr_t>(d->m_parent.get()), d->m_parent ? d->m_parent->m_hlName : "");
+            out.format("\tTablet Pad at {:x} (belongs to {:x} -> {})\n", rc<uintptr_t>(d.get()), rc<uintptr_t>(d->m_parent.get()), d->m_parent ? d->m_parent->m_hlName : "");
         }
 
         for (auto const& d : g_pInputManager->m_tablets) {
-            result += std::format("\tTablet at {:x}:\n\t\t{}\n\t\t\tsize: {}x{}mm\n", rc<uintptr_t>(d.get()), d->m_hlName, d->aq()->physicalSize.x, d->aq()->physicalSize.y);
+            out.format("\tTablet at {:x}:\n\t\t{}\n\t\t\tsize: {}x{}mm\n", rc<uintptr_t>(d.get()), d->m_hlName, d->aq()->physicalSize.x, d->aq()->physicalSize.y);
         }
 
         for (auto const& d : g_pInputManager->m_tabletTools) {
-            result += std::format("\tTablet Tool at {:x}\n", rc<uintptr_t>(d.get()));
+            out.format("\tTablet Tool at {:x}\n", rc<uintptr_t>(d.get()));
         }
 
-        result += "\n\nTouch:\n";
+        out.append("\n\nTouch:\n");
 
         for (auto const& d : g_pInputManager->m_touches) {
-            result += std::format("\tTouch Device at {:x}:\n\t\t{}\n", rc<uintptr_t>(d.get()), d->m_hlName);
+            out.format("\tTouch Device at {:x}:\n\t\t{}\n", rc<uintptr_t>(d.get()), d->m_hlName);
         }
 
-        result += "\n\nSwitches:\n";
+        out.append("\n\nSwitches:\n");
 
         for (auto const& d : g_pInputManager->m_switches) {
-            result += std::format("\tSwitch Device at {:x}:\n\t\t{}\n", rc<uintptr_t>(&d), d.pDevice ? d.pDevice->getName() : "");
+            out.format("\tSwitch Device at {:x}:\n\t\t{}\n", rc<uintptr_t>(&d), d.pDevice ? d.pDevice->getName() : "");
         }
     }
 
-    return result;
+    return out.take();
 }
 
 static std::string animationsRequest(eHyprCtlOutputFormat format, std::string request) {
@@ -957,10 +1002,10 @@ static std::string rollinglogRequest(eHyprCtlOutputFormat format, std::string re
 
     if (format == eHyprCtlOutputFormat::FORMAT_JSON) {
         result += "[\n\"log\":\"";
-        result += escapeJSONStrings(Debug::m_rollingLog);
+        result += escapeJSONStrings(Debug::rollingLog());
         result += "\"]";
     } else {
-        result = Debug::m_rollingLog;
+        result = Debug::rollingLog();
     }
 
     return result;
@@ -993,31 +1038,31 @@ static std::string globalShortcutsRequest(eHyprCtlOutputFormat format, std::stri
 }
 
 static std::string bindsRequest(eHyprCtlOutputFormat format, std::string request) {
-    std::string ret = "";
+    CJSONWriter out;
     if (format == eHyprCtlOutputFormat::FORMAT_NORMAL) {
         for (auto const& kb : g_pKeybindManager->m_keybinds) {
-            ret += "bind";
+            out.append("bind");
             if (kb->locked)
-                ret += "l";
+                out.append("l");
             if (kb->mouse)
-                ret += "m";
+                out.append("m");
             if (kb->release)
-                ret += "r";
+                out.append("r");
             if (kb->repeat)
-                ret += "e";
+                out.append("e");
             if (kb->nonConsuming)
-                ret += "n";
+                out.append("n");
             if (kb->hasDescription)
-                ret += "d";
+                out.append("d");
 
-            ret += std::format("\n\tmodmask: {}\n\tsubmap: {}\n\tkey: {}\n\tkeycode: {}\n\tcatchall: {}\n\tdescription: {}\n\tdispatcher: {}\n\targ: {}\n\n", kb->modmask,
-                               kb->submap.name, kb->key, kb->keycode, kb->catchAll, kb->description, kb->handler, kb->arg);
+            out.format("\n\tmodmask: {}\n\tsubmap: {}\n\tkey: {}\n\tkeycode: {}\n\tcatchall: {}\n\tdescription: {}\n\tdispatcher: {}\n\targ: {}\n\n", kb->modmask,
+                       kb->submap.name, kb->key, kb->keycode, kb->catchAll, kb->description, kb->handler, kb->arg);
         }
     } else {
         // json
-        ret += "[";
+        out.append("[");
         for (auto const& kb : g_pKeybindManager->m_keybinds) {
-            ret += std::format(
+            out.format(
                 R"#(
 {{
     "locked": {},
@@ -1038,15 +1083,14 @@ static std::string bindsRequest(eHyprCtlOutputFormat format, std::string request
     "arg": "{}"
 }},)#",
                 kb->locked ? "true" : "false", kb->mouse ? "true" : "false", kb->release ? "true" : "false", kb->repeat ? "true" : "false", kb->longPress ? "true" : "false",
-                kb->nonConsuming ? "true" : "false", kb->hasDescription ? "true" : "false", kb->modmask, escapeJSONStrings(kb->submap.name), kb->submapUniversal,
-                escapeJSONStrings(kb->key), kb->keycode, kb->catchAll ? "true" : "false", escapeJSONStrings(kb->description), escapeJSONStrings(kb->handler),
-                escapeJSONStrings(kb->arg));
+                kb->nonConsuming ? "true" : "false", kb->hasDescription ? "true" : "false", kb->modmask, jsonEscaped(kb->submap.name), kb->submapUniversal, jsonEscaped(kb->key),
+                kb->keycode, kb->catchAll ? "true" : "false", jsonEscaped(kb->description), jsonEscaped(kb->handler), jsonEscaped(kb->arg));
         }
-        trimTrailingComma(ret);
-        ret += "]";
+        out.trimTrailingComma();
+        out.append("]");
     }
 
-    return ret;
+    return out.take();
 }
 
 std::string versionRequest(eHyprCtlOutputFormat format, std::string request) {
@@ -1207,6 +1251,15 @@ std::string systemInfoRequest(eHyprCtlOutputFormat format, std::string request)
     if (g_pHyprOpenGL) {
         result += std::format("\nExplicit sync: {}", g_pHyprOpenGL->m_exts.EGL_ANDROID_native_fence_sync_ext ? "supported" : "missing");
         result += std::format("\nGL ver: {}", g_pHyprOpenGL->m_eglContextVersion == CHyprOpenGLImpl::EGL_CONTEXT_GLES_3_2 ? "3.2" : "3.0");
+
+        if (g_pHyprOpenGL->m_programCache) {
+            const auto& STATS = g_pHyprOpenGL->m_programCache->m_stats;
+            if (g_pHyprOpenGL->m_programCache->enabled())
+                result += std::format("\nShader cache: {} hits, {} misses ({} rejected), {:.2f}ms loading, {:.2f}ms compiling", STATS.hits, STATS.misses, STATS.rejected, STATS.loadMs,
+                                      STATS.compileMs);
+            else
+                result += std::format("\nShader cache: disabled, {:.2f}ms compiling", STATS.compileMs);
+        }
     }
 
     if (g_pCompositor) {
@@ -1377,6 +1430,77 @@ static std::string cursorPosRequest(eHyprCtlOutputFormat format, std::string req
     return "error";
 }
 
+static std::string regexCacheRequest(eHyprCtlOutputFormat format, std::string request) {
+    const auto STATS = regexCache()->stats();
+
+    if (format == eHyprCtlOutputFormat::FORMAT_NORMAL)
+        return std::format("hits: {}\nmisses: {}\nentries: {}/{}\n", STATS.hits, STATS.misses, STATS.entries, STATS.capacity);
+
+    return std::format(R"#(
+{{
+    "hits": {},
+    "misses": {},
+    "entries": {},
+    "capacity": {}
+}}
+)#",
+                       STATS.hits, STATS.misses, STATS.entries, STATS.capacity);
+}
+
+static void appendHistogram(CJSONWriter& out, std::string_view name, const CRingHistogram& histogram, eHyprCtlOutputFormat format) {
+    const auto SUMMARY = histogram.summary();
+
+    if (format == eHyprCtlOutputFormat::FORMAT_JSON)
+        out.format(R"#(
+        "{}": {{"count": {}, "p50": {:.3f}, "p90": {:.3f}, "p99": {:.3f}, "max": {:.3f}}},)#",
+                   name, SUMMARY.count, SUMMARY.p50, SUMMARY.p90, SUMMARY.p99, SUMMARY.max);
+    else
+        out.format("\t{}: p50 {:.3f}, p90 {:.3f}, p99 {:.3f}, max {:.3f} ({} samples)\n", name, SUMMARY.p50, SUMMARY.p90, SUMMARY.p99, SUMMARY.max, SUMMARY.count);
+}
+
+static std::string perfRequest(eHyprCtlOutputFormat format, std::string request) {
+    const bool  JSON = format == eHyprCtlOutputFormat::FORMAT_JSON;
+    CJSONWriter out;
+
+    if (JSON)
+        out.append("[");
+
+    for (auto const& m : g_pCompositor->m_monitors) {
+        const auto PDATA = g_pTelemetry->dataFor(m);
+        if (!PDATA || !m->m_output)
+            continue;
+
+        if (JSON)
+            out.format(R"#(
+{{
+    "monitor": "{}",
+    "histograms": {{)#",
+                       jsonEscaped(m->m_name));
+        else
+            out.format("Monitor {}:\n", m->m_name);
+
+        appendHistogram(out, "renderMs", PDATA->renderMs, format);
+        appendHistogram(out, "presentLatencyMs", PDATA->presentLatencyMs, format);
+        appendHistogram(out, "inputLatencyMs", PDATA->inputLatencyMs, format);
+        appendHistogram(out, "damagePercent", PDATA->damagePercent, format);
+        appendHistogram(out, "passElements", PDATA->passElements, format);
+        appendHistogram(out, "discardedElements", PDATA->discardedElements, format);
+
+        if (JSON) {
+            out.trimTrailingComma();
+            out.format("\n    }},\n    \"inputOverBudget\": {}\n}},", PDATA->inputOverBudget);
+        } else
+            out.format("\tinputOverBudget: {}\n\n", PDATA->inputOverBudget);
+    }
+
+    if (JSON) {
+        out.trimTrailingComma();
+        out.append("\n]");
+    }
+
+    return out.take();
+}
+
 static std::string dispatchBatch(eHyprCtlOutputFormat format, std::string request) {
     // split by ; ignores ; inside [] and adds ; on last command
 
@@ -2066,6 +2190,8 @@ CHyprCtl::CHyprCtl() {
     registerCommand(SHyprCtlCommand{"locked", true, getIsLocked});
     registerCommand(SHyprCtlCommand{"descriptions", true, getDescriptions});
     registerCommand(SHyprCtlCommand{"submap", true, submapRequest});
+    registerCommand(SHyprCtlCommand{"regexcache", true, regexCacheRequest});
+    registerCommand(SHyprCtlCommand{"perf", true, perfRequest});
     registerCommand(SHyprCtlCommand{.name = "reloadshaders", .exact = true, .fn = reloadShaders});
 
     registerCommand(SHyprCtlCommand{"monitors", false, monitorsRequest});
@@ -2088,6 +2214,18 @@ CHyprCtl::CHyprCtl() {
 }
 
 CHyprCtl::~CHyprCtl() {
+    for (const auto& client : m_clients) {
+        if (client->eventSource)
+            wl_event_source_remove(client->eventSource);
+        if (client->idleTimer)
+            wl_event_source_remove(client->idleTimer);
+    }
+
+    if (m_logFollowSource) {
+        wl_event_source_remove(m_logFollowSource);
+        Debug::setLogFollowed(false);
+    }
+
     if (m_eventSource)
         wl_event_source_remove(m_eventSource);
     if (!m_socketPath.empty())
@@ -2095,73 +2233,121 @@ CHyprCtl::~CHyprCtl() {
 }
 
 SP<SHyprCtlCommand> CHyprCtl::registerCommand(SHyprCtlCommand cmd) {
-    return m_commands.emplace_back(makeShared<SHyprCtlCommand>(cmd));
+    const auto PCMD = m_commands.emplace_back(makeShared<SHyprCtlCommand>(cmd));
+    rebuildCommandIndex();
+    return PCMD;
 }
 
 void CHyprCtl::unregisterCommand(const SP<SHyprCtlCommand>& cmd) {
     std::erase(m_commands, cmd);
+    rebuildCommandIndex();
 }
 
-std::string CHyprCtl::getReply(std::string request) {
-    auto format                          = eHyprCtlOutputFormat::FORMAT_NORMAL;
-    bool reloadAll                       = false;
-    m_currentRequestParams.all           = false;
-    m_currentRequestParams.sysInfoConfig = false;
+void CHyprCtl::rebuildCommandIndex() {
+    m_commandIndex.exact.clear();
+    m_commandIndex.prefixTrie.clear();
+    m_commandIndex.prefixTrie.emplace_back();
 
-    // process flags for non-batch requests
-    if (!request.starts_with("[[BATCH]]") && request.contains("/")) {
-        long unsigned int sepIndex = 0;
-        for (const auto& c : request) {
-            if (c == '/') { // stop at separator
-                break;
-            }
+    for (size_t i = 0; i < m_commands.size(); ++i) {
+        const auto& CMD = m_commands[i];
 
-            // after whitespace assume the first word as a keyword,
-            // so its value can have slashes (e.g., a path)
-            if (c == ' ') {
-                sepIndex = request.size();
-                break;
-            }
+        if (CMD->exact) {
+            // first registration wins, same as the old linear scan
+            m_commandIndex.exact.try_emplace(CMD->name, CMD);
+            continue;
+        }
 
-            sepIndex++;
+        size_t node = 0;
+        for (const char c : CMD->name) {
+            const auto IT = m_commandIndex.prefixTrie[node].children.find(c);
+            if (IT != m_commandIndex.prefixTrie[node].children.end()) {
+                node = IT->second;
+                continue;
+            }
 
-            if (c == 'j')
-                format = eHyprCtlOutputFormat::FORMAT_JSON;
-            else if (c == 'r')
-                reloadAll = true;
-            else if (c == 'a')
-                m_currentRequestParams.all = true;
-            else if (c == 'c')
-                m_currentRequestParams.sysInfoConfig = true;
+            const size_t NEWNODE = m_commandIndex.prefixTrie.size();
+            m_commandIndex.prefixTrie[node].children.emplace(c, NEWNODE);
+            m_commandIndex.prefixTrie.emplace_back();
+            node = NEWNODE;
         }
 
-        if (sepIndex < request.size())
-            request = request.substr(sepIndex + 1); // remove flags and separator so we can compare the rest of the string
+        if (!m_commandIndex.prefixTrie[node].command) {
+            m_commandIndex.prefixTrie[node].command = CMD;
+            m_commandIndex.prefixTrie[node].order   = i;
+        }
     }
+}
 
-    std::string result = "";
+SP<SHyprCtlCommand> CHyprCtl::findCommand(const std::string& request) const {
+    if (const auto IT = m_commandIndex.exact.find(request); IT != m_commandIndex.exact.end())
+        return IT->second;
 
-    // parse exact cmds first, then non-exact.
-    for (auto const& cmd : m_commands) {
-        if (!cmd->exact)
-            continue;
+    return findPrefixCommand(request);
+}
+
+SP<SHyprCtlCommand> CHyprCtl::findPrefixCommand(const std::string& request) const {
+    if (m_commandIndex.prefixTrie.empty())
+        return nullptr;
 
-        if (cmd->name == request) {
-            result = cmd->fn(format, request);
+    // every command on the path is a prefix of the request, pick the one registered first
+    SP<SHyprCtlCommand> found;
+    size_t              foundOrder = 0;
+    size_t              node       = 0;
+
+    for (const char c : request) {
+        const auto IT = m_commandIndex.prefixTrie[node].children.find(c);
+        if (IT == m_commandIndex.prefixTrie[node].children.end())
             break;
+
+        node             = IT->second;
+        const auto& NODE = m_commandIndex.prefixTrie[node];
+
+        if (NODE.command && (!found || NODE.order < foundOrder)) {
+            found      = NODE.command;
+            foundOrder = NODE.order;
         }
     }
 
-    if (result.empty())
-        for (auto const& cmd : m_commands) {
-            if (cmd->exact)
-                continue;
+    return found;
+}
 
-            if (request.starts_with(cmd->name)) {
-                result = cmd->fn(format, request);
-                break;
+std::string CHyprCtl::getReply(std::string request) {
+    auto format                          = eHyprCtlOutputFormat::FORMAT_NORMAL;
+    bool reloadAll                       = false;
+    m_currentRequestParams.all           = false;
+    m_currentRequestParams.sysInfoConfig = false;
+
+    // process flags for non-batch requests. Flags are everything before a '/' that comes before
+    // the first whitespace, so values of the first keyword can have slashes (e.g., a path)
+    if (!request.starts_with("[[BATCH]]")) {
+        const auto SEPINDEX = request.find_first_of("/ ");
+
+        if (SEPINDEX != std::string::npos && request[SEPINDEX] == '/') {
+            for (const char c : std::string_view{request}.substr(0, SEPINDEX)) {
+                if (c == 'j')
+                    format = eHyprCtlOutputFormat::FORMAT_JSON;
+                else if (c == 'r')
+                    reloadAll = true;
+                else if (c == 'a')
+                    m_currentRequestParams.all = true;
+                else if (c == 'c')
+                    m_currentRequestParams.sysInfoConfig = true;
             }
+
+            request = request.substr(SEPINDEX + 1); // remove flags and separator so we can compare the rest of the string
         }
+    }
+
+    std::string result = "";
+
+    // exact cmds first, then non-exact.
+    if (const auto IT = m_commandIndex.exact.find(request); IT != m_commandIndex.exact.end())
+        result = IT->second->fn(format, request);
+
+    if (result.empty()) {
+        if (const auto CMD = findPrefixCommand(request); CMD)
+            result = CMD->fn(format, request);
+    }
 
     if (result.empty())
         return "unknown request";
@@ -2204,141 +2390,340 @@ std::string CHyprCtl::makeDynamicCall(const std::string& input) {
     return getReply(input);
 }
 
-static bool successWrite(int fd, const std::string& data, bool needLog = true) {
-    if (write(fd, data.c_str(), data.length()) > 0)
-        return true;
+static bool isFollowUpRollingLogRequest(const std::string& request) {
+    return request.contains("rollinglog") && request.contains("f");
+}
 
-    if (errno == EAGAIN)
-        return true;
+// a single request (or a pending unframed one) may not grow past this
+constexpr size_t MAX_REQUEST_SIZE = 1024 * 1024;
 
-    if (needLog)
-        Debug::log(ERR, "Couldn't write to socket. Error: " + std::string(strerror(errno)));
+// a client we're waiting on that neither sends nor reads anything for this long gets dropped, like the old blocking poll did
+constexpr int CLIENT_IDLE_TIMEOUT_MS = 5000;
 
-    return false;
+SP<CHyprCtl::SClient> CHyprCtl::clientFromData(void* data) {
+    const auto IT = std::ranges::find_if(m_clients, [data](const auto& c) { return c.get() == data; });
+    return IT == m_clients.end() ? nullptr : *IT;
 }
 
-static void runWritingDebugLogThread(const int conn) {
-    using namespace std::chrono_literals;
-    Debug::log(LOG, "In followlog thread, got connection, start writing: {}", conn);
-    //will be finished, when reading side close connection
-    std::thread([conn]() {
-        while (Debug::SRollingLogFollow::get().isRunning()) {
-            if (Debug::SRollingLogFollow::get().isEmpty(conn)) {
-                std::this_thread::sleep_for(1000ms);
-                continue;
-            }
+int CHyprCtl::onServerEvent(int fd, uint32_t mask, void* data) {
+    if (mask & WL_EVENT_ERROR || mask & WL_EVENT_HANGUP)
+        return 0;
 
-            auto line = Debug::SRollingLogFollow::get().getLog(conn);
-            if (!successWrite(conn, line))
-                // We cannot write, when connection is closed. So thread will successfully exit by itself
-                break;
+    g_pHyprCtl->acceptClients();
+    return 0;
+}
 
-            std::this_thread::sleep_for(100ms);
-        }
-        close(conn);
-        Debug::SRollingLogFollow::get().stopFor(conn);
-    }).detach();
+int CHyprCtl::onClientEvent(int fd, uint32_t mask, void* data) {
+    const auto CLIENT = g_pHyprCtl->clientFromData(data);
+    if (!CLIENT)
+        return 0;
+
+    if (mask & WL_EVENT_ERROR) {
+        g_pHyprCtl->removeClient(CLIENT);
+        return 0;
+    }
+
+    if (mask & WL_EVENT_WRITABLE)
+        g_pHyprCtl->flushClient(CLIENT);
+
+    if ((mask & WL_EVENT_READABLE) || (mask & WL_EVENT_HANGUP))
+        g_pHyprCtl->readClient(CLIENT);
+
+    return 0;
 }
 
-static bool isFollowUpRollingLogRequest(const std::string& request) {
-    return request.contains("rollinglog") && request.contains("f");
+void CHyprCtl::acceptClients() {
+    if (!m_socketFD.isValid())
+        return;
+
+    while (true) {
+        sockaddr_in     clientAddress;
+        socklen_t       clientSize = sizeof(clientAddress);
+
+        CFileDescriptor ACCEPTEDCONNECTION{accept4(m_socketFD.get(), rc<sockaddr*>(&clientAddress), &clientSize, SOCK_CLOEXEC | SOCK_NONBLOCK)};
+
+        if (!ACCEPTEDCONNECTION.isValid()) {
+            if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+                Debug::log(ERR, "Hyprctl: failed to accept a connection, errno: {}", errno);
+            return;
+        }
+
+        auto client = makeShared<SClient>();
+        client->fd  = std::move(ACCEPTEDCONNECTION);
+
+        // try to get creds
+        CRED_T   creds;
+        uint32_t len = sizeof(creds);
+        if (getsockopt(client->fd.get(), CRED_LVL, CRED_OPT, &creds, &len) == -1)
+            Debug::log(ERR, "Hyprctl: failed to get peer creds");
+        else {
+            client->pid = creds.CRED_PID;
+            Debug::log(LOG, "Hyprctl: new connection from pid {}", creds.CRED_PID);
+        }
+
+        client->eventSource = wl_event_loop_add_fd(g_pCompositor->m_wlEventLoop, client->fd.get(), WL_EVENT_READABLE, onClientEvent, client.get());
+        client->idleTimer   = wl_event_loop_add_timer(g_pCompositor->m_wlEventLoop, onClientIdle, client.get());
+        m_clients.emplace_back(client);
+
+        resetClientIdle(client);
+    }
 }
 
-static int hyprCtlFDTick(int fd, uint32_t mask, void* data) {
-    if (mask & WL_EVENT_ERROR || mask & WL_EVENT_HANGUP)
+int CHyprCtl::onClientIdle(void* data) {
+    const auto CLIENT = g_pHyprCtl->clientFromData(data);
+    if (!CLIENT)
         return 0;
 
-    if (!g_pHyprCtl->m_socketFD.isValid())
+    // waiting on us: a promise that hasn't resolved, or a follower with nothing new to send
+    if (!CLIENT->replies.empty() || (CLIENT->followLog && CLIENT->writeBuffer.empty())) {
+        g_pHyprCtl->resetClientIdle(CLIENT);
         return 0;
+    }
+
+    Debug::log(LOG, "Hyprctl: connection from pid {} was idle for {}ms, dropping it", CLIENT->pid, CLIENT_IDLE_TIMEOUT_MS);
+    g_pHyprCtl->removeClient(CLIENT);
+    return 0;
+}
 
-    sockaddr_in            clientAddress;
-    socklen_t              clientSize = sizeof(clientAddress);
+void CHyprCtl::resetClientIdle(const SP<SClient>& client) {
+    if (client->idleTimer)
+        wl_event_source_timer_update(client->idleTimer, CLIENT_IDLE_TIMEOUT_MS);
+}
 
-    const auto             ACCEPTEDCONNECTION = accept4(g_pHyprCtl->m_socketFD.get(), rc<sockaddr*>(&clientAddress), &clientSize, SOCK_CLOEXEC);
+void CHyprCtl::readClient(const SP<SClient>& client) {
+    if (client->closeAfterFlush || !std::ranges::contains(m_clients, client))
+        return;
 
-    std::array<char, 1024> readBuffer;
+    std::array<char, 8192> readBuffer;
+    bool                   peerClosed = false;
 
-    // try to get creds
-    CRED_T   creds;
-    uint32_t len = sizeof(creds);
-    if (getsockopt(ACCEPTEDCONNECTION, CRED_LVL, CRED_OPT, &creds, &len) == -1)
-        Debug::log(ERR, "Hyprctl: failed to get peer creds");
-    else {
-        g_pHyprCtl->m_currentRequestParams.pid = creds.CRED_PID;
-        Debug::log(LOG, "Hyprctl: new connection from pid {}", creds.CRED_PID);
+    while (true) {
+        const auto SIZE = read(client->fd.get(), readBuffer.data(), readBuffer.size());
+
+        if (SIZE > 0) {
+            client->readBuffer.append(readBuffer.data(), SIZE);
+            resetClientIdle(client);
+            continue;
+        }
+
+        if (SIZE < 0 && errno == EINTR)
+            continue;
+
+        if (SIZE == 0 || (errno != EAGAIN && errno != EWOULDBLOCK))
+            peerClosed = true;
+
+        break;
     }
 
-    //
-    pollfd pollfds[1] = {
-        {
-            .fd     = ACCEPTEDCONNECTION,
-            .events = POLLIN,
-        },
-    };
+    // followers don't send anything we care about, we only need to know when they go away
+    if (client->followLog) {
+        client->readBuffer.clear();
+        if (peerClosed)
+            removeClient(client);
+        return;
+    }
 
-    int ret = poll(pollfds, 1, 5000);
+    if (client->readBuffer.contains('\0'))
+        client->framed = true;
 
-    if (ret <= 0) {
-        close(ACCEPTEDCONNECTION);
-        return 0;
+    if (client->framed) {
+        size_t begin = 0;
+        for (size_t end = client->readBuffer.find('\0'); end != std::string::npos; end = client->readBuffer.find('\0', begin)) {
+            handleRequest(client, client->readBuffer.substr(begin, end - begin));
+            begin = end + 1;
+
+            // a request (e.g. reload) might have dropped us
+            if (!std::ranges::contains(m_clients, client))
+                return;
+        }
+
+        client->readBuffer.erase(0, begin);
+    } else if (!client->readBuffer.empty()) {
+        // legacy, unterminated request: whatever we got until the socket ran dry is the request,
+        // and the connection is closed after the reply.
+        client->closeAfterFlush = true;
+        handleRequest(client, std::exchange(client->readBuffer, ""));
+        return;
     }
 
-    std::string request;
-    while (true) {
-        readBuffer.fill(0);
-        auto messageSize = read(ACCEPTEDCONNECTION, readBuffer.data(), 1023);
-        if (messageSize < 1)
-            break;
-        std::string recvd = readBuffer.data();
-        request += recvd;
-        if (messageSize < 1023)
-            break;
+    if (client->readBuffer.size() > MAX_REQUEST_SIZE) {
+        Debug::log(ERR, "Hyprctl: request from pid {} is too large, dropping the connection", client->pid);
+        removeClient(client);
+        return;
+    }
+
+    if (peerClosed) {
+        client->closeAfterFlush = true;
+        flushClient(client);
     }
+}
 
-    std::string reply = "";
+void CHyprCtl::handleRequest(const SP<SClient>& client, const std::string& request) {
+    m_currentRequestParams.pid = client->pid;
+
+    auto        replySlot = client->replies.emplace_back(makeShared<SReply>());
+    std::string reply     = "";
 
     try {
-        reply = g_pHyprCtl->getReply(request);
+        reply = getReply(request);
     } catch (std::exception& e) {
         Debug::log(ERR, "Error in request: {}", e.what());
         reply = "Err: " + std::string(e.what());
     }
 
-    if (g_pHyprCtl->m_currentRequestParams.pendingPromise) {
+    if (m_currentRequestParams.pendingPromise) {
         // we have a promise pending
-        g_pHyprCtl->m_currentRequestParams.pendingPromise->then([ACCEPTEDCONNECTION, request](SP<CPromiseResult<std::string>> result) {
-            const auto RES = result->hasError() ? result->error() : result->result();
-            successWrite(ACCEPTEDCONNECTION, RES);
+        m_currentRequestParams.pendingPromise->then([weakClient = WP<SClient>{client}, replySlot](SP<CPromiseResult<std::string>> result) {
+            replySlot->data  = result->hasError() ? result->error() : result->result();
+            replySlot->ready = true;
 
             // No rollinglog or ensureMonitor here. These are only for plugins for now.
 
-            close(ACCEPTEDCONNECTION);
+            if (const auto CLIENT = weakClient.lock(); CLIENT && g_pHyprCtl)
+                g_pHyprCtl->flushClient(CLIENT);
         });
 
-        g_pHyprCtl->m_currentRequestParams.pendingPromise.reset();
+        m_currentRequestParams.pendingPromise.reset();
     } else {
-        successWrite(ACCEPTEDCONNECTION, reply);
+        replySlot->data  = std::move(reply);
+        replySlot->ready = true;
 
-        if (isFollowUpRollingLogRequest(request)) {
-            Debug::log(LOG, "Followup rollinglog request received. Starting thread to write to socket.");
-            Debug::SRollingLogFollow::get().startFor(ACCEPTEDCONNECTION);
-            runWritingDebugLogThread(ACCEPTEDCONNECTION);
-            Debug::log(LOG, Debug::SRollingLogFollow::get().debugInfo());
-        } else
-            close(ACCEPTEDCONNECTION);
+        if (!client->framed && isFollowUpRollingLogRequest(request)) {
+            Debug::log(LOG, "Followup rollinglog request received, following the log on fd {}", client->fd.get());
+            replySlot->data += std::format("[LOG] Following log to socket: {} started\n", client->fd.get());
+            client->followLog       = true;
+            client->closeAfterFlush = false;
+            client->logCursor       = Debug::logFollowCursor();
+            updateLogFollowing();
+        }
 
         if (g_pConfigManager->m_wantsMonitorReload)
             g_pConfigManager->ensureMonitorStatus();
 
-        g_pHyprCtl->m_currentRequestParams.pid = 0;
+        m_currentRequestParams.pid = 0;
+    }
+
+    flushClient(client);
+}
+
+void CHyprCtl::flushClient(const SP<SClient>& client) {
+    if (!std::ranges::contains(m_clients, client))
+        return;
+
+    while (!client->replies.empty() && client->replies.front()->ready) {
+        client->writeBuffer += client->replies.front()->data;
+        if (client->framed)
+            client->writeBuffer += '\0';
+        client->replies.pop_front();
+    }
+
+    do {
+        if (client->followLog && client->writeBuffer.empty())
+            appendFollowedLog(client);
+
+        while (client->writeOffset < client->writeBuffer.size()) {
+            const auto WRITTEN = write(client->fd.get(), client->writeBuffer.data() + client->writeOffset, client->writeBuffer.size() - client->writeOffset);
+
+            if (WRITTEN < 0) {
+                if (errno == EINTR)
+                    continue;
+
+                if (errno == EAGAIN || errno == EWOULDBLOCK)
+                    break;
+
+                // don't log for followers, that'd just produce more lines to fail writing
+                if (!client->followLog)
+                    Debug::log(ERR, "Couldn't write to socket. Error: {}", strerror(errno));
+                removeClient(client);
+                return;
+            }
+
+            client->writeOffset += WRITTEN;
+            resetClientIdle(client);
+        }
+
+        if (client->writeOffset >= client->writeBuffer.size()) {
+            client->writeBuffer.clear();
+            client->writeOffset = 0;
+        }
+
+        // a follower that caught up might already have more waiting
+    } while (client->followLog && client->writeBuffer.empty() && client->logCursor != Debug::logFollowCursor());
+
+    const bool DRAINED = client->writeBuffer.empty() && client->replies.empty();
+
+    if (DRAINED && client->closeAfterFlush) {
+        removeClient(client);
+        return;
+    }
+
+    updateClientMask(client);
+}
+
+void CHyprCtl::appendFollowedLog(const SP<SClient>& client) {
+    if (!Debug::readLogFollow(client->logCursor, client->writeBuffer))
+        client->writeBuffer.insert(0, "[hyprctl] the log moved too fast to follow, some lines were skipped\n");
+}
+
+void CHyprCtl::updateLogFollowing() {
+    const bool FOLLOWED = std::ranges::any_of(m_clients, [](const auto& c) { return c->followLog; });
+
+    if (FOLLOWED == !!m_logFollowSource)
+        return;
+
+    Debug::setLogFollowed(FOLLOWED);
+
+    if (FOLLOWED)
+        m_logFollowSource = wl_event_loop_add_fd(g_pCompositor->m_wlEventLoop, Debug::logFollowFD(), WL_EVENT_READABLE, onLogFollowEvent, nullptr);
+    else {
+        wl_event_source_remove(m_logFollowSource);
+        m_logFollowSource = nullptr;
+    }
+}
+
+int CHyprCtl::onLogFollowEvent(int fd, uint32_t mask, void* data) {
+    uint64_t count = 0;
+    if (read(fd, &count, sizeof(count)) < 0 && errno != EAGAIN)
+        return 0;
+
+    // copy, a failing write removes the client
+    const auto CLIENTS = g_pHyprCtl->m_clients;
+    for (const auto& c : CLIENTS) {
+        // ones with a backlog get refilled once the socket is writable again
+        if (c->followLog && c->writeBuffer.empty())
+            g_pHyprCtl->flushClient(c);
     }
 
     return 0;
 }
 
-void CHyprCtl::startHyprCtlSocket() {
-    m_socketFD = CFileDescriptor{socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0)};
+void CHyprCtl::updateClientMask(const SP<SClient>& client) {
+    uint32_t mask = 0;
 
+    if (!client->closeAfterFlush)
+        mask |= WL_EVENT_READABLE;
+    if (!client->writeBuffer.empty())
+        mask |= WL_EVENT_WRITABLE;
+
+    wl_event_source_fd_update(client->eventSource, mask);
+}
+
+void CHyprCtl::removeClient(const SP<SClient>& client) {
+    if (client->eventSource)
+        wl_event_source_remove(client->eventSource);
+    if (client->idleTimer)
+        wl_event_source_remove(client->idleTimer);
+    client->eventSource = nullptr;
+    client->idleTimer   = nullptr;
+
+    std::erase(m_clients, client);
+
+    if (client->followLog)
+        updateLogFollowing();
+}
+
+void CHyprCtl::startHyprCtlSocket() {
+    m_socketFD = CFileDescriptor{socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC | SOCK_NONBLOCK, 0)};
     if (!m_socketFD.isValid()) {
         Debug::log(ERR, "Couldn't start the Hyprland Socket. (1) IPC will not work.");
         return;
@@ -2355,10 +2740,10 @@ void CHyprCtl::startHyprCtlSocket() {
         return;
     }
 
-    // 10 max queued.
-    listen(m_socketFD.get(), 10);
+    // 64 max queued, we accept all pending connections on every wakeup anyway.
+    listen(m_socketFD.get(), 64);
 
     Debug::log(LOG, "Hypr socket started at {}", m_socketPath);
 
-    m_eventSource = wl_event_loop_add_fd(g_pCompositor->m_wlEventLoop, m_socketFD.get(), WL_EVENT_READABLE, hyprCtlFDTick, nullptr);
+    m_eventSource = wl_event_loop_add_fd(g_pCompositor->m_wlEventLoop, m_socketFD.get(), WL_EVENT_READABLE, onServerEvent, nullptr);
 }
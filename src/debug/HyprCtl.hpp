@@ -3,8 +3,11 @@
 #include <fstream>
 #include "../helpers/MiscFunctions.hpp"
 #include "../helpers/defer/Promise.hpp"
+#include "../helpers/JSONWriter.hpp"
 #include "../desktop/Window.hpp"
 #include <functional>
+#include <deque>
+#include <unordered_map>
 #include <sys/types.h>
 #include <hyprutils/os/FileDescriptor.hpp>
 
@@ -22,6 +25,9 @@ class CHyprCtl {
     void                           unregisterCommand(const SP<SHyprCtlCommand>& cmd);
     std::string                    getReply(std::string);
 
+    // resolves a request (without flags) to its command: exact names first, then the earliest registered prefix
+    SP<SHyprCtlCommand>            findCommand(const std::string& request) const;
+
     Hyprutils::OS::CFileDescriptor m_socketFD;
 
     struct {
@@ -39,12 +45,77 @@ class CHyprCtl {
     static std::string getTearingBlockedReason(Hyprutils::Memory::CSharedPointer<CMonitor> m, eHyprCtlOutputFormat format);
     static std::string getMonitorData(Hyprutils::Memory::CSharedPointer<CMonitor> m, eHyprCtlOutputFormat format);
 
+    // same as the above, but appending to a shared buffer
+    static void appendWindowData(CJSONWriter& out, PHLWINDOW w, eHyprCtlOutputFormat format);
+    static void appendWorkspaceData(CJSONWriter& out, PHLWORKSPACE w, eHyprCtlOutputFormat format);
+    static void appendMonitorData(CJSONWriter& out, Hyprutils::Memory::CSharedPointer<CMonitor> m, eHyprCtlOutputFormat format);
+
   private:
+    struct SReply {
+        std::string data;
+        bool        ready = false;
+    };
+
+    struct SClient {
+        Hyprutils::OS::CFileDescriptor fd;
+        wl_event_source*               eventSource = nullptr;
+        wl_event_source*               idleTimer   = nullptr;
+        pid_t                          pid         = 0;
+
+        std::string                    readBuffer;
+        std::string                    writeBuffer;
+        size_t                         writeOffset = 0;
+
+        // replies are flushed in request order, even if a later one resolves first
+        std::deque<SP<SReply>> replies;
+
+        // framed clients terminate requests (and get replies) with a NUL byte and may pipeline
+        // several requests on one connection. Legacy clients send a single unterminated request.
+        bool framed          = false;
+        bool closeAfterFlush = false;
+
+        // rollinglog -f: after the reply the connection keeps streaming the log from this cursor
+        bool     followLog = false;
+        uint64_t logCursor = 0;
+    };
+
     void                             startHyprCtlSocket();
+    void                             rebuildCommandIndex();
+    SP<SHyprCtlCommand>              findPrefixCommand(const std::string& request) const;
+
+    static int                       onServerEvent(int fd, uint32_t mask, void* data);
+    static int                       onClientEvent(int fd, uint32_t mask, void* data);
+    static int                       onClientIdle(void* data);
+    static int                       onLogFollowEvent(int fd, uint32_t mask, void* data);
+
+    void                             acceptClients();
+    void                             readClient(const SP<SClient>& client);
+    void                             handleRequest(const SP<SClient>& client, const std::string& request);
+    void                             flushClient(const SP<SClient>& client);
+    void                             updateClientMask(const SP<SClient>& client);
+    void                             removeClient(const SP<SClient>& client);
+    void                             resetClientIdle(const SP<SClient>& client);
+    void                             appendFollowedLog(const SP<SClient>& client);
+    void                             updateLogFollowing();
+    SP<SClient>                      clientFromData(void* data);
 
     std::vector<SP<SHyprCtlCommand>> m_commands;
-    wl_event_source*                 m_eventSource = nullptr;
-    std::string                      m_socketPath;
+
+    struct SPrefixNode {
+        std::unordered_map<char, size_t> children;
+        SP<SHyprCtlCommand>              command;
+        size_t                           order = 0; // position in m_commands, earlier registrations win
+    };
+
+    struct {
+        std::unordered_map<std::string, SP<SHyprCtlCommand>> exact;
+        std::vector<SPrefixNode>                             prefixTrie; // [0] is the root
+    } m_commandIndex;
+
+    std::vector<SP<SClient>> m_clients;
+    wl_event_source*         m_eventSource     = nullptr;
+    wl_event_source*         m_logFollowSource = nullptr;
+    std::string              m_socketPath;
 };
 
 inline UP<CHyprCtl> g_pHyprCtl;
@@ -1,22 +1,368 @@
 #include "Log.hpp"
 #include "../defines.hpp"
-#include "RollingLogFollow.hpp"
 
+#include <array>
+#include <atomic>
+#include <cstdio>
 #include <fstream>
-#include <print>
+#include <mutex>
+#include <thread>
 #include <fcntl.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+
+// Records are pushed into a bounded lock-free ring by any thread and written out in batches by a dedicated writer thread,
+// so logging on the main thread costs a format and a move, not a flush of the file and stdout.
+namespace {
+    constexpr size_t LOG_RING_SIZE = 8192; // has to be a power of two
+
+    struct SLogRecord {
+        eLogLevel   level = LOG;
+        std::string msg;
+    };
+
+    struct SLogSlot {
+        std::atomic<uint64_t> seq = 0;
+        SLogRecord            record;
+    };
+
+    class CLogRing {
+      public:
+        CLogRing() {
+            for (size_t i = 0; i < LOG_RING_SIZE; ++i) {
+                m_slots[i].seq.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        // multiple producers, false if the ring is full
+        bool push(SLogRecord& record) {
+            uint64_t  pos  = m_enqueuePos.load(std::memory_order_relaxed);
+            SLogSlot* slot = nullptr;
+
+            while (true) {
+                slot            = &m_slots[pos & (LOG_RING_SIZE - 1)];
+                const auto SEQ  = slot->seq.load(std::memory_order_acquire);
+                const auto DIFF = sc<int64_t>(SEQ) - sc<int64_t>(pos);
+
+                if (DIFF == 0) {
+                    if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                        break;
+                } else if (DIFF < 0)
+                    return false;
+                else
+                    pos = m_enqueuePos.load(std::memory_order_relaxed);
+            }
+
+            slot->record = std::move(record);
+            slot->seq.store(pos + 1, std::memory_order_release);
+            return true;
+        }
+
+        // single consumer, guarded by the writer mutex
+        bool pop(SLogRecord& out) {
+            auto&      slot = m_slots[m_dequeuePos & (LOG_RING_SIZE - 1)];
+            const auto SEQ  = slot.seq.load(std::memory_order_acquire);
+
+            if (SEQ != m_dequeuePos + 1)
+                return false;
+
+            out = std::move(slot.record);
+            slot.seq.store(m_dequeuePos + LOG_RING_SIZE, std::memory_order_release);
+            m_dequeuePos++;
+            return true;
+        }
+
+        uint64_t enqueued() const {
+            return m_enqueuePos.load(std::memory_order_acquire);
+        }
+
+        uint64_t dequeued() const {
+            return m_dequeuePos;
+        }
+
+      private:
+        std::array<SLogSlot, LOG_RING_SIZE> m_slots;
+        std::atomic<uint64_t>               m_enqueuePos = 0;
+        uint64_t                            m_dequeuePos = 0;
+    };
+
+    // how much of the log is kept for followers, the rolling log is the ROLLING_LOG_SIZE tail of it
+    constexpr size_t LOG_TAIL_SIZE = 256 * 1024;
+
+    // fixed size circular buffer holding the tail of the log. Positions are absolute offsets into everything ever logged,
+    // so followers can keep a cursor into it.
+    class CRollingBuffer {
+      public:
+        void append(std::string_view data) {
+            if (data.size() > LOG_TAIL_SIZE) {
+                m_end += data.size() - LOG_TAIL_SIZE;
+                data = data.substr(data.size() - LOG_TAIL_SIZE);
+            }
+
+            while (!data.empty()) {
+                const size_t AT    = m_end % LOG_TAIL_SIZE;
+                const size_t CHUNK = std::min(data.size(), LOG_TAIL_SIZE - AT);
+                std::copy_n(data.data(), CHUNK, m_data.data() + AT);
+
+                data = data.substr(CHUNK);
+                m_end += CHUNK;
+                m_size = std::min(m_size + CHUNK, LOG_TAIL_SIZE);
+            }
+        }
+
+        // copies [from, end) to out, false if part of it fell out of the buffer already
+        bool read(uint64_t from, std::string& out) const {
+            const uint64_t BEGIN = m_end - m_size;
+            const bool     LOST  = from < BEGIN;
+
+            for (uint64_t pos = std::max(from, BEGIN); pos < m_end;) {
+                const size_t AT    = pos % LOG_TAIL_SIZE;
+                const size_t CHUNK = std::min<uint64_t>(m_end - pos, LOG_TAIL_SIZE - AT);
+                out.append(m_data.data() + AT, CHUNK);
+                pos += CHUNK;
+            }
+
+            return !LOST;
+        }
+
+        uint64_t end() const {
+            return m_end;
+        }
+
+      private:
+        std::array<char, LOG_TAIL_SIZE> m_data = {};
+        uint64_t                        m_end  = 0;
+        size_t                          m_size = 0;
+    };
+
+    CLogRing       g_logRing;
+
+    CRollingBuffer g_rollingBuffer;
+    std::mutex     g_rollingBufferMutex;
+
+    // held by whoever drains the ring: the writer thread, or a caller of flush()
+    std::mutex            g_drainMutex;
+
+    std::atomic<bool>     g_writerSleeping = false;
+    std::atomic<uint32_t> g_writerWakeups  = 0;
+
+    // signalled after every batch while someone follows the log
+    Hyprutils::OS::CFileDescriptor g_followFD;
+    std::atomic<bool>              g_followed = false;
+
+    // declared last, so it's stopped before anything above is destroyed
+    std::jthread g_writerThread;
+}
+
+static void wakeWriter() {
+    g_writerWakeups.fetch_add(1, std::memory_order_release);
+    g_writerWakeups.notify_one();
+}
+
+static const char* levelTag(eLogLevel level) {
+    switch (level) {
+        case LOG: return "[LOG] ";
+        case WARN: return "[WARN] ";
+        case ERR: return "[ERR] ";
+        case CRIT: return "[CRITICAL] ";
+        case INFO: return "[INFO] ";
+        case TRACE: return "[TRACE] ";
+        default: return "";
+    }
+}
+
+static const char* levelColor(eLogLevel level) {
+    switch (level) {
+        case WARN: return "\033[1;33m"; // yellow
+        case ERR: return "\033[1;31m";  // red
+        case CRIT: return "\033[1;35m"; // magenta
+        case INFO: return "\033[1;32m"; // green
+        case TRACE: return "\033[1;34m"; // blue
+        default: return nullptr;
+    }
+}
+
+// writes out everything in the ring, g_drainMutex has to be held
+static void drainRing() {
+    static std::string plain, colored;
+    SLogRecord         record;
+
+    plain.clear();
+    colored.clear();
+
+    const bool TOFILE   = !Debug::m_disableLogs;
+    const bool TOSTDOUT = !Debug::m_disableStdout;
+    const bool COLORED  = Debug::m_coloredLogs;
+
+    while (g_logRing.pop(record)) {
+        const auto* TAG   = levelTag(record.level);
+        const auto* COLOR = levelColor(record.level);
+
+        plain += TAG;
+        plain += record.msg;
+        plain += '\n';
+
+        if (!TOSTDOUT)
+            continue;
+
+        if (COLORED && COLOR) {
+            colored += COLOR;
+            colored += TAG;
+            colored += record.msg;
+            colored += "\033[0m\n";
+        } else {
+            colored += TAG;
+            colored += record.msg;
+            colored += '\n';
+        }
+    }
+
+    if (plain.empty())
+        return;
+
+    {
+        std::lock_guard<std::mutex> guard(g_rollingBufferMutex);
+        g_rollingBuffer.append(plain);
+    }
+
+    if (g_followed.load(std::memory_order_relaxed)) {
+        const uint64_t ONE = 1;
+        write(g_followFD.get(), &ONE, sizeof(ONE));
+    }
+
+    if (TOFILE) {
+        Debug::m_logOfs.write(plain.data(), plain.size());
+        Debug::m_logOfs.flush();
+    }
+
+    if (TOSTDOUT) {
+        std::fwrite(colored.data(), 1, colored.size(), stdout);
+        std::fflush(stdout);
+    }
+}
+
+static void writerThread(std::stop_token stopToken) {
+    std::stop_callback onStop(stopToken, wakeWriter);
+
+    while (!stopToken.stop_requested()) {
+        const auto WAKEUPS = g_writerWakeups.load(std::memory_order_acquire);
+
+        {
+            std::lock_guard<std::mutex> guard(g_drainMutex);
+            drainRing();
+        }
+
+        g_writerSleeping.store(true);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        // something might have been pushed after the drain, but before we said we're going to sleep
+        if (g_logRing.enqueued() == g_logRing.dequeued())
+            g_writerWakeups.wait(WAKEUPS, std::memory_order_acquire);
+
+        g_writerSleeping.store(false);
+    }
+}
 
 void Debug::init(const std::string& IS) {
     m_logFile = IS + (ISDEBUG ? "/hyprlandd.log" : "/hyprland.log");
     m_logOfs.open(m_logFile, std::ios::out | std::ios::app);
     auto handle = m_logOfs.native_handle();
     fcntl(handle, F_SETFD, FD_CLOEXEC);
+
+    g_followFD = Hyprutils::OS::CFileDescriptor{eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK)};
+
+    g_writerThread = std::jthread(writerThread);
 }
 
 void Debug::close() {
+    if (g_writerThread.joinable()) {
+        g_writerThread.request_stop();
+        g_writerThread.join();
+    }
+
+    flush();
+
     m_logOfs.close();
 }
 
+void Debug::flush() {
+    std::lock_guard<std::mutex> guard(g_drainMutex);
+    drainRing();
+}
+
+std::string Debug::rollingLog() {
+    flush();
+
+    std::lock_guard<std::mutex> guard(g_rollingBufferMutex);
+    std::string                 result;
+    g_rollingBuffer.read(g_rollingBuffer.end() - std::min<uint64_t>(g_rollingBuffer.end(), ROLLING_LOG_SIZE), result);
+    return result;
+}
+
+std::string Debug::rollingLogNoWait() {
+    // if a lock is taken, whatever is still in the ring is lost and the buffer might be mid-append. A torn line beats a hang.
+    std::unique_lock<std::mutex> drainLock(g_drainMutex, std::try_to_lock);
+    if (drainLock.owns_lock()) {
+        // draining takes the buffer lock, which the crashed thread might be holding as well
+        std::unique_lock<std::mutex> bufferLock(g_rollingBufferMutex, std::try_to_lock);
+        if (bufferLock.owns_lock()) {
+            bufferLock.unlock();
+            drainRing();
+        }
+    }
+
+    std::string result;
+    g_rollingBuffer.read(g_rollingBuffer.end() - std::min<uint64_t>(g_rollingBuffer.end(), ROLLING_LOG_SIZE), result);
+    return result;
+}
+
+int Debug::logFollowFD() {
+    return g_followFD.get();
+}
+
+void Debug::setLogFollowed(bool followed) {
+    g_followed = followed;
+}
+
+uint64_t Debug::logFollowCursor() {
+    std::lock_guard<std::mutex> guard(g_rollingBufferMutex);
+    return g_rollingBuffer.end();
+}
+
+bool Debug::readLogFollow(uint64_t& cursor, std::string& out) {
+    std::lock_guard<std::mutex> guard(g_rollingBufferMutex);
+    const bool                  COMPLETE = g_rollingBuffer.read(cursor, out);
+    cursor                               = g_rollingBuffer.end();
+    return COMPLETE;
+}
+
+std::string Debug::timestamp() {
+    using namespace std::chrono;
+
+    // the local time only has to be looked up once a second, the fraction is appended to the cached part
+    thread_local sys_seconds cachedSecond = {};
+    thread_local std::string cachedPrefix;
+
+    const auto               NOW    = system_clock::now();
+    const auto               SECOND = floor<seconds>(NOW);
+
+    if (SECOND != cachedSecond || cachedPrefix.empty()) {
+#ifndef _LIBCPP_VERSION
+        static const auto* ZONE  = current_zone();
+        const auto         LOCAL = zoned_time{ZONE, SECOND}.get_local_time();
+        cachedPrefix             = std::format("[{}", hh_mm_ss{LOCAL - floor<days>(LOCAL)});
+#else
+        // TODO: current clang 17 does not support `zoned_time`, remove this once clang 19 is ready
+        cachedPrefix = std::format("[{}", hh_mm_ss{SECOND - floor<days>(SECOND)});
+#endif
+        cachedSecond = SECOND;
+    }
+
+    constexpr auto WIDTH = hh_mm_ss<system_clock::duration>::fractional_width;
+
+    return std::format("{}.{:0{}}] ", cachedPrefix, (NOW - SECOND).count(), WIDTH);
+}
+
 void Debug::log(eLogLevel level, std::string str) {
     if (level == TRACE && !m_trace)
         return;
@@ -24,55 +370,19 @@ void Debug::log(eLogLevel level, std::string str) {
     if (m_shuttingDown)
         return;
 
-    std::lock_guard<std::mutex> guard(m_logMutex);
+    SLogRecord record{.level = level, .msg = std::move(str)};
 
-    std::string                 coloredStr = str;
-    //NOLINTBEGIN
-    switch (level) {
-        case LOG:
-            str        = "[LOG] " + str;
-            coloredStr = str;
-            break;
-        case WARN:
-            str        = "[WARN] " + str;
-            coloredStr = "\033[1;33m" + str + "\033[0m"; // yellow
-            break;
-        case ERR:
-            str        = "[ERR] " + str;
-            coloredStr = "\033[1;31m" + str + "\033[0m"; // red
-            break;
-        case CRIT:
-            str        = "[CRITICAL] " + str;
-            coloredStr = "\033[1;35m" + str + "\033[0m"; // magenta
-            break;
-        case INFO:
-            str        = "[INFO] " + str;
-            coloredStr = "\033[1;32m" + str + "\033[0m"; // green
-            break;
-        case TRACE:
-            str        = "[TRACE] " + str;
-            coloredStr = "\033[1;34m" + str + "\033[0m"; // blue
-            break;
-        default: break;
+    // full, or nobody to write it out yet. Drain it ourselves.
+    while (!g_logRing.push(record)) {
+        flush();
     }
-    //NOLINTEND
-
-    m_rollingLog += str + "\n";
-    if (m_rollingLog.size() > ROLLING_LOG_SIZE)
-        m_rollingLog = m_rollingLog.substr(m_rollingLog.size() - ROLLING_LOG_SIZE);
-
-    if (SRollingLogFollow::get().isRunning())
-        SRollingLogFollow::get().addLog(str);
 
-    if (!m_disableLogs || !**m_disableLogs) {
-        // log to a file
-        m_logOfs << str << "\n";
-        m_logOfs.flush();
+    if (!g_writerThread.joinable()) {
+        flush();
+        return;
     }
 
-    // log it to the stdout too.
-    if (!m_disableStdout) {
-        std::println("{}", ((m_coloredLogs && !**m_coloredLogs) ? str : coloredStr));
-        std::fflush(stdout);
-    }
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (g_writerSleeping.load())
+        wakeWriter();
 }
@@ -4,7 +4,8 @@
 #include <iostream>
 #include <fstream>
 #include <chrono>
-#include <mutex>
+#include <iterator>
+#include <atomic>
 
 #define LOGMESSAGESIZE   1024
 #define ROLLING_LOG_SIZE 4096
@@ -23,18 +24,36 @@ enum eLogLevel : int8_t {
 namespace Debug {
     inline std::string     m_logFile;
     inline std::ofstream   m_logOfs;
-    inline int64_t* const* m_disableLogs   = nullptr;
-    inline int64_t* const* m_disableTime   = nullptr;
-    inline bool            m_disableStdout = false;
-    inline bool            m_trace         = false;
-    inline bool            m_shuttingDown  = false;
-    inline int64_t* const* m_coloredLogs   = nullptr;
+    inline int64_t* const* m_disableTime  = nullptr;
+    inline bool            m_trace        = false;
+    inline bool            m_shuttingDown = false;
 
-    inline std::string     m_rollingLog = ""; // rolling log contains the ROLLING_LOG_SIZE tail of the log
-    inline std::mutex      m_logMutex;
+    // read by the writer thread, set from the config by the config manager
+    inline std::atomic<bool> m_disableLogs   = false;
+    inline std::atomic<bool> m_disableStdout = false;
+    inline std::atomic<bool> m_coloredLogs   = true;
 
-    void                   init(const std::string& IS);
-    void                   close();
+    void                     init(const std::string& IS);
+    void                     close();
+
+    // blocks until everything logged so far has been written out
+    void flush();
+
+    // the ROLLING_LOG_SIZE tail of the log
+    std::string rollingLog();
+
+    // same, for the crash reporter. Doesn't wait for the writer, which might be what crashed or be stuck holding its lock.
+    std::string rollingLogNoWait();
+
+    // "[HH:MM:SS.fraction] "
+    std::string timestamp();
+
+    // following the log (hyprctl rollinglog -f). While followed, the fd becomes readable whenever new lines were written out.
+    int      logFollowFD();
+    void     setLogFollowed(bool followed);
+    uint64_t logFollowCursor();
+    // appends everything logged since cursor to out and moves the cursor to the end, false if some of it was lost already
+    bool readLogFollow(uint64_t& cursor, std::string& out);
 
     //
     void log(eLogLevel level, std::string str);
@@ -51,25 +70,16 @@ namespace Debug {
         std::string logMsg = "";
 
         // print date and time to the ofs
-        if (m_disableTime && !**m_disableTime) {
-#ifndef _LIBCPP_VERSION
-            static auto current_zone = std::chrono::current_zone();
-            const auto  zt           = std::chrono::zoned_time{current_zone, std::chrono::system_clock::now()};
-            const auto  hms          = std::chrono::hh_mm_ss{zt.get_local_time() - std::chrono::floor<std::chrono::days>(zt.get_local_time())};
-#else
-            // TODO: current clang 17 does not support `zoned_time`, remove this once clang 19 is ready
-            const auto hms = std::chrono::hh_mm_ss{std::chrono::system_clock::now() - std::chrono::floor<std::chrono::days>(std::chrono::system_clock::now())};
-#endif
-            logMsg += std::format("[{}] ", hms);
-        }
+        if (m_disableTime && !**m_disableTime)
+            logMsg = timestamp();
 
         // no need for try {} catch {} because std::format_string<Args...> ensures that vformat never throw std::format_error
         // because
         // 1. any faulty format specifier that sucks will cause a compilation error.
         // 2. and `std::bad_alloc` is catastrophic, (Almost any operation in stdlib could throw this.)
         // 3. this is actually what std::format in stdlib does
-        logMsg += std::vformat(fmt.get(), std::make_format_args(args...));
+        std::vformat_to(std::back_inserter(logMsg), fmt.get(), std::make_format_args(args...));
 
-        log(level, logMsg);
+        log(level, std::move(logMsg));
     }
 };
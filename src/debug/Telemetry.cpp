@@ -0,0 +1,98 @@
+#include "Telemetry.hpp"
+#include "../helpers/Monitor.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+static float msBetween(const Time::steady_tp& from, const Time::steady_tp& to) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(to - from).count() / 1000.F;
+}
+
+void CRingHistogram::add(float value) {
+    m_samples[m_next] = value;
+    m_next            = (m_next + 1) % SIZE;
+    m_count           = std::min(m_count + 1, SIZE);
+}
+
+CRingHistogram::SSummary CRingHistogram::summary() const {
+    if (m_count == 0)
+        return {};
+
+    std::array<float, SIZE> sorted;
+    std::copy_n(m_samples.begin(), m_count, sorted.begin());
+    std::sort(sorted.begin(), sorted.begin() + m_count);
+
+    const auto AT = [&](float p) { return sorted[std::min(m_count - 1, sc<size_t>(std::ceil(p * m_count)) - 1)]; };
+
+    return {
+        .count = m_count,
+        .p50   = AT(0.5F),
+        .p90   = AT(0.9F),
+        .p99   = AT(0.99F),
+        .max   = sorted[m_count - 1],
+    };
+}
+
+SMonitorTelemetry& CTelemetry::forMonitor(PHLMONITOR pMonitor) {
+    return m_monitors[pMonitor];
+}
+
+const SMonitorTelemetry* CTelemetry::dataFor(PHLMONITOR pMonitor) const {
+    const auto IT = m_monitors.find(pMonitor);
+    return IT == m_monitors.end() ? nullptr : &IT->second;
+}
+
+void CTelemetry::onInput(PHLMONITOR pMonitor) {
+    if (!pMonitor)
+        return;
+
+    auto& data = forMonitor(pMonitor);
+    if (!data.pendingInput)
+        data.pendingInput = Time::steadyNow();
+}
+
+void CTelemetry::onIdleFrame(PHLMONITOR pMonitor) {
+    // the input didn't damage anything (a key the focused app ignored, the pointer over an idle monitor). A later frame has nothing
+    // to do with it, and would measure how long the monitor sat idle.
+    forMonitor(pMonitor).pendingInput.reset();
+}
+
+void CTelemetry::onCommit(PHLMONITOR pMonitor) {
+    auto&      data = forMonitor(pMonitor);
+    const auto NOW  = Time::steadyNow();
+
+    data.committedAt = NOW;
+
+    if (!data.pendingInput)
+        return;
+
+    // could still be input that never got a frame of its own when nothing rendered in between (vfr, no damage at all), which
+    // would throw the percentiles off. Counted, so a real regression that slow doesn't go unnoticed.
+    const auto BUDGETMS = 2 * 1000.F / std::max(1.F, pMonitor->m_refreshRate);
+
+    if (msBetween(*data.pendingInput, NOW) <= BUDGETMS)
+        data.committedInput = data.pendingInput;
+    else
+        data.inputOverBudget++;
+
+    data.pendingInput.reset();
+}
+
+void CTelemetry::onPresented(PHLMONITOR pMonitor, const Time::steady_tp& when) {
+    auto& data = forMonitor(pMonitor);
+
+    // presentation timestamps come from the kernel and can be a hair before our own commit timestamp
+    if (data.committedAt) {
+        data.presentLatencyMs.add(std::max(0.F, msBetween(*data.committedAt, when)));
+        data.committedAt.reset();
+    }
+
+    if (data.committedInput) {
+        data.inputLatencyMs.add(std::max(0.F, msBetween(*data.committedInput, when)));
+        data.committedInput.reset();
+    }
+}
+
+void CTelemetry::onMonitorRemoved(PHLMONITOR pMonitor) {
+    m_monitors.erase(pMonitor);
+}
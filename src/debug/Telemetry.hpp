@@ -0,0 +1,66 @@
+#pragma once
+
+#include "../defines.hpp"
+#include "../helpers/time/Time.hpp"
+#include <array>
+#include <map>
+#include <optional>
+
+// The last SIZE samples of one metric. Adding is O(1) and never allocates,
+// sorting for percentiles only happens when someone asks for them.
+class CRingHistogram {
+  public:
+    static constexpr size_t SIZE = 1024;
+
+    struct SSummary {
+        size_t count = 0;
+        float  p50   = 0.F;
+        float  p90   = 0.F;
+        float  p99   = 0.F;
+        float  max   = 0.F;
+    };
+
+    void     add(float value);
+    SSummary summary() const;
+
+  private:
+    std::array<float, SIZE> m_samples = {};
+    size_t                  m_next    = 0;
+    size_t                  m_count   = 0;
+};
+
+struct SMonitorTelemetry {
+    CRingHistogram renderMs;          // cpu time of CHyprRenderer::renderMonitor
+    CRingHistogram presentLatencyMs;  // output commit -> presentation
+    CRingHistogram inputLatencyMs;    // first input event -> presentation of the frame after it
+    CRingHistogram damagePercent;     // of the monitor's area
+    CRingHistogram passElements;      // per rendered pass
+    CRingHistogram discardedElements; // per rendered pass, culled by CRenderPass::simplify
+    size_t         inputOverBudget = 0; // input that took longer than two refreshes to be committed, left out of inputLatencyMs
+
+    // internal
+    std::optional<Time::steady_tp> committedAt;
+    std::optional<Time::steady_tp> pendingInput;   // input aimed at this monitor since the last commit
+    std::optional<Time::steady_tp> committedInput; // input the last committed frame shows
+};
+
+/*
+    Always-on, cheap per-monitor frame timing, for catching regressions without a Tracy build.
+    See hyprctl perf.
+*/
+class CTelemetry {
+  public:
+    SMonitorTelemetry&       forMonitor(PHLMONITOR pMonitor);
+    const SMonitorTelemetry* dataFor(PHLMONITOR pMonitor) const;
+
+    void                     onInput(PHLMONITOR pMonitor); // the monitor the input goes to, cursor or focused
+    void                     onIdleFrame(PHLMONITOR pMonitor); // renderMonitor ran, but had nothing to draw
+    void                     onCommit(PHLMONITOR pMonitor);
+    void                     onPresented(PHLMONITOR pMonitor, const Time::steady_tp& when);
+    void                     onMonitorRemoved(PHLMONITOR pMonitor);
+
+  private:
+    std::map<PHLMONITORREF, SMonitorTelemetry> m_monitors;
+};
+
+inline UP<CTelemetry> g_pTelemetry;
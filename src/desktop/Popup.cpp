@@ -8,6 +8,7 @@
 #include "../managers/SeatManager.hpp"
 #include "../managers/animation/AnimationManager.hpp"
 #include "../desktop/LayerSurface.hpp"
+#include "../desktop/state/HitTestIndex.hpp"
 #include "../managers/input/InputManager.hpp"
 #include "../render/Renderer.hpp"
 #include "../render/OpenGL.hpp"
@@ -127,6 +128,8 @@ void CPopup::onMap() {
     m_mapped   = true;
     m_lastSize = m_resource->m_surface->m_surface->m_current.size;
 
+    Desktop::hitTestIndex()->invalidate();
+
     const auto COORDS   = coordsGlobal();
     const auto PMONITOR = g_pCompositor->getMonitorFromVector(COORDS);
 
@@ -166,6 +169,8 @@ void CPopup::onUnmap() {
 
     Debug::log(LOG, "popup {:x}: unmapped", rc<uintptr_t>(this));
 
+    Desktop::hitTestIndex()->invalidate();
+
     // if the popup committed a different size right now, we also need to damage the old size.
     const Vector2D MAX_DAMAGE_SIZE = {std::max(m_lastSize.x, m_resource->m_surface->m_surface->m_current.size.x),
                                       std::max(m_lastSize.y, m_resource->m_surface->m_surface->m_current.size.y)};
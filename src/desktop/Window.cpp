@@ -8,6 +8,7 @@
 #include <string_view>
 #include "Window.hpp"
 #include "state/FocusState.hpp"
+#include "state/HitTestIndex.hpp"
 #include "../Compositor.hpp"
 #include "../render/decorations/CHyprDropShadowDecoration.hpp"
 #include "../render/decorations/CHyprGroupBarDecoration.hpp"
@@ -25,6 +26,7 @@
 #include "../protocols/FractionalScale.hpp"
 #include "../xwayland/XWayland.hpp"
 #include "../helpers/Color.hpp"
+#include "../helpers/RegexCache.hpp"
 #include "../helpers/math/Expression.hpp"
 #include "../events/Events.hpp"
 #include "../managers/XWaylandManager.hpp"
@@ -275,6 +277,8 @@ SBoxExtents CWindow::getFullWindowReservedArea() {
 }
 
 void CWindow::updateWindowDecos() {
+    // layouts move windows right before this, and decorations change the extents
+    Desktop::hitTestIndex()->invalidate();
 
     if (!m_isMapped || isHidden())
         return;
@@ -569,6 +573,10 @@ void CWindow::onMap() {
     m_movingToWorkspaceAlpha->resetAllCallbacks();
     m_movingFromWorkspaceAlpha->resetAllCallbacks();
 
+    // set after the reset above, every move or resize has to drop the pointer hit-test grid, warps included
+    m_realPosition->setUpdateCallback([](auto) { Desktop::hitTestIndex()->invalidate(); });
+    m_realSize->setUpdateCallback([](auto) { Desktop::hitTestIndex()->invalidate(); });
+
     m_movingFromWorkspaceAlpha->setValueAndWarp(1.F);
 
     if (m_borderAngleAnimationProgress->enabled()) {
@@ -1483,13 +1491,13 @@ PHLWINDOW CWindow::getSwallower() {
     }
 
     if (!(*PSWALLOWREGEX).empty())
-        std::erase_if(candidates, [&](const auto& other) { return !RE2::FullMatch(other->m_class, *PSWALLOWREGEX); });
+        std::erase_if(candidates, [REGEX = regexCache()->get(*PSWALLOWREGEX)](const auto& other) { return !RE2::FullMatch(other->m_class, *REGEX); });
 
     if (candidates.empty())
         return nullptr;
 
     if (!(*PSWALLOWEXREGEX).empty())
-        std::erase_if(candidates, [&](const auto& other) { return RE2::FullMatch(other->m_title, *PSWALLOWEXREGEX); });
+        std::erase_if(candidates, [REGEX = regexCache()->get(*PSWALLOWEXREGEX)](const auto& other) { return RE2::FullMatch(other->m_title, *REGEX); });
 
     if (candidates.empty())
         return nullptr;
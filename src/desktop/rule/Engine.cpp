@@ -1,5 +1,6 @@
 #include "Engine.hpp"
 #include "Rule.hpp"
+#include "windowRule/WindowRule.hpp"
 #include "../LayerSurface.hpp"
 #include "../../Compositor.hpp"
 
@@ -13,22 +14,26 @@ SP<CRuleEngine> Rule::ruleEngine() {
 
 void CRuleEngine::registerRule(SP<IRule>&& rule) {
     m_rules.emplace_back(std::move(rule));
+    m_windowRuleIndexDirty = true;
 }
 
 void CRuleEngine::unregisterRule(const std::string& name) {
     if (name.empty())
         return;
 
-    std::erase_if(m_rules, [&name](const auto& el) { return el->name() == name; });
+    if (std::erase_if(m_rules, [&name](const auto& el) { return el->name() == name; }) > 0)
+        m_windowRuleIndexDirty = true;
 }
 
 void CRuleEngine::unregisterRule(const SP<IRule>& rule) {
-    std::erase(m_rules, rule);
+    if (std::erase(m_rules, rule) > 0)
+        m_windowRuleIndexDirty = true;
     cleanExecRules();
 }
 
 void CRuleEngine::cleanExecRules() {
-    std::erase_if(m_rules, [](const auto& e) { return e->isExecRule() && e->execExpired(); });
+    if (std::erase_if(m_rules, [](const auto& e) { return e->isExecRule() && e->execExpired(); }) > 0)
+        m_windowRuleIndexDirty = true;
 }
 
 void CRuleEngine::updateAllRules() {
@@ -49,8 +54,39 @@ void CRuleEngine::updateAllRules() {
 
 void CRuleEngine::clearAllRules() {
     std::erase_if(m_rules, [](const auto& e) { return !e->isExecRule() || e->execExpired(); });
+    m_windowRuleIndexDirty = true;
 }
 
 const std::vector<SP<IRule>>& CRuleEngine::rules() {
     return m_rules;
 }
+
+const CRuleEngine::SWindowRuleIndex& CRuleEngine::windowRules() {
+    if (m_windowRuleIndexDirty)
+        rebuildWindowRuleIndex();
+
+    return m_windowRuleIndex;
+}
+
+void CRuleEngine::rebuildWindowRuleIndex() {
+    m_windowRuleIndex      = {};
+    m_windowRuleIndexDirty = false;
+
+    for (const auto& r : m_rules) {
+        if (r->type() != RULE_TYPE_WINDOW)
+            continue;
+
+        const auto IDX  = m_windowRuleIndex.rules.size();
+        const auto MASK = r->getPropertiesMask();
+
+        for (size_t bit = 0; bit < m_windowRuleIndex.byProp.size(); ++bit) {
+            if (MASK & (1U << bit))
+                m_windowRuleIndex.byProp[bit].emplace_back(IDX);
+        }
+
+        const auto& WR = m_windowRuleIndex.rules.emplace_back(reinterpretPointerCast<CWindowRule>(r));
+        for (const auto& effect : WR->effectsSet()) {
+            m_windowRuleIndex.byEffect[effect].emplace_back(IDX);
+        }
+    }
+}
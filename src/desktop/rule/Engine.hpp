@@ -1,13 +1,25 @@
 #pragma once
 
 #include "Rule.hpp"
+#include "windowRule/WindowRuleEffectContainer.hpp"
+
+#include <array>
 
 namespace Desktop::Rule {
+    class CWindowRule;
+
     class CRuleEngine {
       public:
         CRuleEngine()  = default;
         ~CRuleEngine() = default;
 
+        // window rules in config order, with inverted indices into them
+        struct SWindowRuleIndex {
+            std::vector<SP<CWindowRule>>                                                       rules;
+            std::array<std::vector<size_t>, sizeof(std::underlying_type_t<eRuleProperty>) * 8> byProp; // one per eRuleProperty bit
+            std::unordered_map<CWindowRuleEffectContainer::storageType, std::vector<size_t>>   byEffect;
+        };
+
         void                          registerRule(SP<IRule>&& rule);
         void                          unregisterRule(const std::string& name);
         void                          unregisterRule(const SP<IRule>& rule);
@@ -15,9 +27,15 @@ namespace Desktop::Rule {
         void                          cleanExecRules();
         void                          clearAllRules();
         const std::vector<SP<IRule>>& rules();
+        const SWindowRuleIndex&       windowRules();
 
       private:
         std::vector<SP<IRule>> m_rules;
+
+        SWindowRuleIndex       m_windowRuleIndex;
+        bool                   m_windowRuleIndexDirty = true;
+
+        void                   rebuildWindowRuleIndex();
     };
 
     SP<CRuleEngine> ruleEngine();
@@ -1,4 +1,5 @@
 #include "RegexMatchEngine.hpp"
+#include "../../../helpers/RegexCache.hpp"
 #include <re2/re2.h>
 
 using namespace Desktop::Rule;
@@ -6,10 +7,10 @@ using namespace Desktop::Rule;
 CRegexMatchEngine::CRegexMatchEngine(const std::string& regex) {
     if (regex.starts_with("negative:")) {
         m_negative = true;
-        m_regex    = makeUnique<re2::RE2>(regex.substr(9));
+        m_regex    = regexCache()->get(regex.substr(9));
         return;
     }
-    m_regex = makeUnique<re2::RE2>(regex);
+    m_regex = regexCache()->get(regex);
 }
 
 bool CRegexMatchEngine::match(const std::string& other) {
@@ -17,7 +17,7 @@ namespace Desktop::Rule {
         virtual bool match(const std::string& other);
 
       private:
-        UP<re2::RE2> m_regex;
+        SP<re2::RE2> m_regex;
         bool         m_negative = false;
     };
 }
\ No newline at end of file
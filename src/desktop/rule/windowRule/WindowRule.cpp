@@ -1,13 +1,168 @@
 #include "WindowRule.hpp"
+#include "WindowRuleApplicator.hpp"
 #include "../../Window.hpp"
 #include "../../../helpers/Monitor.hpp"
 #include "../../../Compositor.hpp"
 #include "../../../managers/TokenManager.hpp"
 #include "../../../desktop/state/FocusState.hpp"
+#include "../../../helpers/MiscFunctions.hpp"
+
+#include <hyprutils/string/String.hpp>
+
+using namespace Hyprutils::String;
 
 using namespace Desktop;
 using namespace Desktop::Rule;
 
+static SBorderColorEffect parseBorderColor(const std::string& effect) {
+    // Each vector will only get used if it has at least one color
+    CGradientValueData activeBorderGradient   = {};
+    CGradientValueData inactiveBorderGradient = {};
+    bool               active                 = true;
+    CVarList           colorsAndAngles        = CVarList(trim(effect.substr(effect.find_first_of(' ') + 1)), 0, 's', true);
+
+    // Basic form has only two colors, everything else can be parsed as a gradient
+    if (colorsAndAngles.size() == 2 && !colorsAndAngles[1].contains("deg"))
+        return SBorderColorEffect{
+            .active   = CGradientValueData(CHyprColor(configStringToInt(colorsAndAngles[0]).value_or(0))),
+            .inactive = CGradientValueData(CHyprColor(configStringToInt(colorsAndAngles[1]).value_or(0))),
+        };
+
+    for (auto const& token : colorsAndAngles) {
+        // The first angle, or an explicit "0deg", splits the two gradients
+        if (active && token.contains("deg")) {
+            activeBorderGradient.m_angle = std::stoi(token.substr(0, token.size() - 3)) * (PI / 180.0);
+            active                       = false;
+        } else if (token.contains("deg"))
+            inactiveBorderGradient.m_angle = std::stoi(token.substr(0, token.size() - 3)) * (PI / 180.0);
+        else if (active)
+            activeBorderGradient.m_colors.emplace_back(configStringToInt(token).value_or(0));
+        else
+            inactiveBorderGradient.m_colors.emplace_back(configStringToInt(token).value_or(0));
+    }
+
+    activeBorderGradient.updateColorsOk();
+
+    // Includes sanity checks for the number of colors in each gradient
+    if (activeBorderGradient.m_colors.size() > 10 || inactiveBorderGradient.m_colors.size() > 10) {
+        Debug::log(WARN, "Bordercolor rule \"{}\" has more than 10 colors in one gradient, ignoring", effect);
+        return {};
+    } else if (activeBorderGradient.m_colors.empty()) {
+        Debug::log(WARN, "Bordercolor rule \"{}\" has no colors, ignoring", effect);
+        return {};
+    } else if (inactiveBorderGradient.m_colors.empty())
+        return SBorderColorEffect{.active = activeBorderGradient};
+
+    return SBorderColorEffect{.active = activeBorderGradient, .inactive = inactiveBorderGradient};
+}
+
+static SOpacityEffect parseOpacity(const std::string& effect) {
+    SOpacityEffect opacity;
+    CVarList2      vars(std::string{effect}, 0, ' ');
+
+    for (const auto& r : vars) {
+        if (r == "opacity")
+            continue;
+
+        // override applies to the value before it
+        if (r == "override") {
+            if (opacity.count > 0)
+                opacity.alpha[opacity.count - 1].overridden = true;
+            continue;
+        }
+
+        if (opacity.count >= opacity.alpha.size())
+            throw std::runtime_error("more than 3 alpha values");
+
+        opacity.alpha[opacity.count++] = Types::SAlphaValue{.alpha = std::stof(std::string{r}), .overridden = false};
+    }
+
+    return opacity;
+}
+
+static parsedEffect parseEffect(CWindowRuleEffectContainer::storageType e, const std::string& effect) {
+    switch (e) {
+        default: return std::monostate{};
+
+        case WINDOW_RULE_EFFECT_ROUNDING:
+        case WINDOW_RULE_EFFECT_BORDER_SIZE: {
+            try {
+                return sc<Hyprlang::INT>(e == WINDOW_RULE_EFFECT_ROUNDING ? std::stoull(effect) : std::stoi(effect));
+            } catch (...) { Debug::log(ERR, "CWindowRule: invalid {} {}", windowEffects()->get(e), effect); }
+            return std::monostate{};
+        }
+        case WINDOW_RULE_EFFECT_ROUNDING_POWER:
+        case WINDOW_RULE_EFFECT_SCROLL_MOUSE:
+        case WINDOW_RULE_EFFECT_SCROLL_TOUCHPAD: {
+            try {
+                const auto MIN = e == WINDOW_RULE_EFFECT_ROUNDING_POWER ? 1.F : 0.01F;
+                return std::clamp(std::stof(effect), MIN, 10.F);
+            } catch (...) { Debug::log(ERR, "CWindowRule: invalid {} {}", windowEffects()->get(e), effect); }
+            return std::monostate{};
+        }
+        case WINDOW_RULE_EFFECT_BORDER_COLOR: {
+            try {
+                return parseBorderColor(effect);
+            } catch (std::exception& ex) { Debug::log(ERR, "BorderColor rule \"{}\" failed with: {}", effect, ex.what()); }
+            return SBorderColorEffect{};
+        }
+        case WINDOW_RULE_EFFECT_IDLE_INHIBIT: {
+            if (effect == "none")
+                return sc<Hyprlang::INT>(IDLEINHIBIT_NONE);
+            else if (effect == "always")
+                return sc<Hyprlang::INT>(IDLEINHIBIT_ALWAYS);
+            else if (effect == "focus")
+                return sc<Hyprlang::INT>(IDLEINHIBIT_FOCUS);
+            else if (effect == "fullscreen")
+                return sc<Hyprlang::INT>(IDLEINHIBIT_FULLSCREEN);
+
+            Debug::log(ERR, "Rule idleinhibit: unknown mode {}", effect);
+            return std::monostate{};
+        }
+        case WINDOW_RULE_EFFECT_OPACITY: {
+            try {
+                return parseOpacity(effect);
+            } catch (std::exception& ex) { Debug::log(ERR, "Opacity rule \"{}\" failed with: {}", effect, ex.what()); }
+            return SOpacityEffect{};
+        }
+        case WINDOW_RULE_EFFECT_MAX_SIZE:
+        case WINDOW_RULE_EFFECT_MIN_SIZE: {
+            try {
+                const auto VEC = configStringToVector2D(effect);
+                if (VEC.x >= 1 && VEC.y >= 1)
+                    return VEC;
+
+                Debug::log(ERR, "Invalid size for {}", windowEffects()->get(e));
+            } catch (std::exception& ex) { Debug::log(ERR, "{} rule \"{}\" failed with: {}", windowEffects()->get(e), effect, ex.what()); }
+            return std::monostate{};
+        }
+        case WINDOW_RULE_EFFECT_PERSISTENT_SIZE:
+        case WINDOW_RULE_EFFECT_ALLOWS_INPUT:
+        case WINDOW_RULE_EFFECT_DIM_AROUND:
+        case WINDOW_RULE_EFFECT_DECORATE:
+        case WINDOW_RULE_EFFECT_FOCUS_ON_ACTIVATE:
+        case WINDOW_RULE_EFFECT_KEEP_ASPECT_RATIO:
+        case WINDOW_RULE_EFFECT_NEAREST_NEIGHBOR:
+        case WINDOW_RULE_EFFECT_NO_ANIM:
+        case WINDOW_RULE_EFFECT_NO_BLUR:
+        case WINDOW_RULE_EFFECT_NO_DIM:
+        case WINDOW_RULE_EFFECT_NO_FOCUS:
+        case WINDOW_RULE_EFFECT_NO_FOLLOW_MOUSE:
+        case WINDOW_RULE_EFFECT_NO_MAX_SIZE:
+        case WINDOW_RULE_EFFECT_NO_SHADOW:
+        case WINDOW_RULE_EFFECT_NO_SHORTCUTS_INHIBIT:
+        case WINDOW_RULE_EFFECT_OPAQUE:
+        case WINDOW_RULE_EFFECT_FORCE_RGBX:
+        case WINDOW_RULE_EFFECT_SYNC_FULLSCREEN:
+        case WINDOW_RULE_EFFECT_IMMEDIATE:
+        case WINDOW_RULE_EFFECT_XRAY:
+        case WINDOW_RULE_EFFECT_RENDER_UNFOCUSED:
+        case WINDOW_RULE_EFFECT_NO_SCREEN_SHARE:
+        case WINDOW_RULE_EFFECT_NO_VRR:
+        case WINDOW_RULE_EFFECT_STAY_FOCUSED: return truthy(effect);
+    }
+}
+
 CWindowRule::CWindowRule(const std::string& name) : IRule(name) {
     ;
 }
@@ -18,6 +173,7 @@ eRuleType CWindowRule::type() {
 
 void CWindowRule::addEffect(CWindowRule::storageType e, const std::string& result) {
     m_effects.emplace_back(std::make_pair<>(e, result));
+    m_parsedEffects.emplace_back(parseEffect(e, result));
     m_effectSet.emplace(e);
 }
 
@@ -25,6 +181,10 @@ const std::vector<std::pair<CWindowRule::storageType, std::string>>& CWindowRule
     return m_effects;
 }
 
+const std::vector<parsedEffect>& CWindowRule::parsedEffects() {
+    return m_parsedEffects;
+}
+
 bool CWindowRule::matches(PHLWINDOW w, bool allowEnvLookup) {
     if (m_matchEngines.empty())
         return false;
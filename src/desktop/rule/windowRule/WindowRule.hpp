@@ -3,13 +3,30 @@
 #include "../Rule.hpp"
 #include "../../DesktopTypes.hpp"
 #include "WindowRuleEffectContainer.hpp"
+#include "../../types/OverridableVar.hpp"
 #include "../../../helpers/math/Math.hpp"
+#include "../../../config/ConfigDataValues.hpp"
 
+#include <array>
 #include <unordered_set>
+#include <variant>
 
 namespace Desktop::Rule {
     constexpr const char* EXEC_RULE_ENV_NAME = "HL_EXEC_RULE_TOKEN";
 
+    struct SOpacityEffect {
+        std::array<Types::SAlphaValue, 3> alpha;
+        size_t                            count = 0;
+    };
+
+    struct SBorderColorEffect {
+        std::optional<CGradientValueData> active, inactive;
+    };
+
+    // Effect values are parsed once when the effect is added, so applying a rule doesn't touch the strings.
+    // monostate means the value didn't parse (or the effect is applied from its string).
+    using parsedEffect = std::variant<std::monostate, bool, Hyprlang::INT, float, Vector2D, SOpacityEffect, SBorderColorEffect>;
+
     class CWindowRule : public IRule {
       private:
         using storageType = CWindowRuleEffectContainer::storageType;
@@ -24,12 +41,14 @@ namespace Desktop::Rule {
 
         void                                                    addEffect(storageType e, const std::string& result);
         const std::vector<std::pair<storageType, std::string>>& effects();
+        const std::vector<parsedEffect>&                        parsedEffects();
         const std::unordered_set<storageType>&                  effectsSet();
 
         bool                                                    matches(PHLWINDOW w, bool allowEnvLookup = false);
 
       private:
         std::vector<std::pair<storageType, std::string>> m_effects;
+        std::vector<parsedEffect>                        m_parsedEffects; // same order as m_effects
         std::unordered_set<storageType>                  m_effectSet;
     };
 };
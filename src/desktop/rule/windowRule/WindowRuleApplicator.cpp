@@ -1,7 +1,6 @@
 #include "WindowRuleApplicator.hpp"
 #include "WindowRule.hpp"
 #include "../Engine.hpp"
-#include "../utils/SetUtils.hpp"
 #include "../../Window.hpp"
 #include "../../types/OverridableVar.hpp"
 #include "../../../managers/LayoutManager.hpp"
@@ -86,7 +85,19 @@ void CWindowRuleApplicator::resetProps(std::underlying_type_t<eRuleProperty> pro
 CWindowRuleApplicator::SRuleResult CWindowRuleApplicator::applyDynamicRule(const SP<CWindowRule>& rule) {
     SRuleResult result;
 
-    for (const auto& [key, effect] : rule->effects()) {
+    const auto& EFFECTS = rule->effects();
+    const auto& PARSED  = rule->parsedEffects();
+    const auto  MASK    = rule->getPropertiesMask();
+
+    const auto  TRUTHY = [](const parsedEffect& v) {
+        const auto B = std::get_if<bool>(&v);
+        return B && *B;
+    };
+
+    for (size_t i = 0; i < EFFECTS.size(); ++i) {
+        const auto& [key, effect] = EFFECTS[i];
+        const auto& VALUE         = PARSED[i];
+
         switch (key) {
             default: {
                 if (key <= WINDOW_RULE_EFFECT_LAST_STATIC) {
@@ -99,12 +110,12 @@ CWindowRuleApplicator::SRuleResult CWindowRuleApplicator::applyDynamicRule(const
                     m_otherProps.props.emplace(key,
                                                makeUnique<SCustomPropContainer>(SCustomPropContainer{
                                                    .idx      = key,
-                                                   .propMask = rule->getPropertiesMask(),
+                                                   .propMask = MASK,
                                                    .effect   = effect,
                                                }));
                 } else {
                     auto& e = m_otherProps.props[key];
-                    e->propMask |= rule->getPropertiesMask();
+                    e->propMask |= MASK;
                     e->effect = effect;
                 }
 
@@ -116,324 +127,240 @@ CWindowRuleApplicator::SRuleResult CWindowRuleApplicator::applyDynamicRule(const
                 break;
             }
             case WINDOW_RULE_EFFECT_ROUNDING: {
-                try {
-                    m_rounding.first.set(std::stoull(effect), Types::PRIORITY_WINDOW_RULE);
-                    m_rounding.second |= rule->getPropertiesMask();
-                } catch (...) { Debug::log(ERR, "CWindowRuleApplicator::applyDynamicRule: invalid rounding {}", effect); }
+                if (const auto ROUNDING = std::get_if<Hyprlang::INT>(&VALUE)) {
+                    m_rounding.first.set(*ROUNDING, Types::PRIORITY_WINDOW_RULE);
+                    m_rounding.second |= MASK;
+                }
                 break;
             }
             case WINDOW_RULE_EFFECT_ROUNDING_POWER: {
-                try {
-                    m_roundingPower.first.set(std::clamp(std::stof(effect), 1.F, 10.F), Types::PRIORITY_WINDOW_RULE);
-                    m_roundingPower.second |= rule->getPropertiesMask();
-                } catch (...) { Debug::log(ERR, "CWindowRuleApplicator::applyDynamicRule: invalid rounding_power {}", effect); }
+                if (const auto POWER = std::get_if<float>(&VALUE)) {
+                    m_roundingPower.first.set(*POWER, Types::PRIORITY_WINDOW_RULE);
+                    m_roundingPower.second |= MASK;
+                }
                 break;
             }
             case WINDOW_RULE_EFFECT_PERSISTENT_SIZE: {
-                m_persistentSize.first.set(truthy(effect), Types::PRIORITY_WINDOW_RULE);
-                m_persistentSize.second |= rule->getPropertiesMask();
+                m_persistentSize.first.set(TRUTHY(VALUE), Types::PRIORITY_WINDOW_RULE);
+                m_persistentSize.second |= MASK;
                 break;
             }
             case WINDOW_RULE_EFFECT_ANIMATION: {
                 m_animationStyle.first.set(effect, Types::PRIORITY_WINDOW_RULE);
-                m_animationStyle.second |= rule->getPropertiesMask();
+                m_animationStyle.second |= MASK;
                 break;
             }
             case WINDOW_RULE_EFFECT_BORDER_COLOR: {
-                try {
-                    // Each vector will only get used if it has at least one color
-                    CGradientValueData activeBorderGradient   = {};
-                    CGradientValueData inactiveBorderGradient = {};
-                    bool               active                 = true;
-                    CVarList           colorsAndAngles        = CVarList(trim(effect.substr(effect.find_first_of(' ') + 1)), 0, 's', true);
-
-                    // Basic form has only two colors, everything else can be parsed as a gradient
-                    if (colorsAndAngles.size() == 2 && !colorsAndAngles[1].contains("deg")) {
-                        m_activeBorderColor.first =
-                            Types::COverridableVar(CGradientValueData(CHyprColor(configStringToInt(colorsAndAngles[0]).value_or(0))), Types::PRIORITY_WINDOW_RULE);
-                        m_inactiveBorderColor.first =
-                            Types::COverridableVar(CGradientValueData(CHyprColor(configStringToInt(colorsAndAngles[1]).value_or(0))), Types::PRIORITY_WINDOW_RULE);
-                        break;
-                    }
-
-                    for (auto const& token : colorsAndAngles) {
-                        // The first angle, or an explicit "0deg", splits the two gradients
-                        if (active && token.contains("deg")) {
-                            activeBorderGradient.m_angle = std::stoi(token.substr(0, token.size() - 3)) * (PI / 180.0);
-                            active                       = false;
-                        } else if (token.contains("deg"))
-                            inactiveBorderGradient.m_angle = std::stoi(token.substr(0, token.size() - 3)) * (PI / 180.0);
-                        else if (active)
-                            activeBorderGradient.m_colors.emplace_back(configStringToInt(token).value_or(0));
-                        else
-                            inactiveBorderGradient.m_colors.emplace_back(configStringToInt(token).value_or(0));
-                    }
-
-                    activeBorderGradient.updateColorsOk();
-
-                    // Includes sanity checks for the number of colors in each gradient
-                    if (activeBorderGradient.m_colors.size() > 10 || inactiveBorderGradient.m_colors.size() > 10)
-                        Debug::log(WARN, "Bordercolor rule \"{}\" has more than 10 colors in one gradient, ignoring", effect);
-                    else if (activeBorderGradient.m_colors.empty())
-                        Debug::log(WARN, "Bordercolor rule \"{}\" has no colors, ignoring", effect);
-                    else if (inactiveBorderGradient.m_colors.empty())
-                        m_activeBorderColor.first = Types::COverridableVar(activeBorderGradient, Types::PRIORITY_WINDOW_RULE);
-                    else {
-                        m_activeBorderColor.first   = Types::COverridableVar(activeBorderGradient, Types::PRIORITY_WINDOW_RULE);
-                        m_inactiveBorderColor.first = Types::COverridableVar(inactiveBorderGradient, Types::PRIORITY_WINDOW_RULE);
-                    }
-                } catch (std::exception& e) { Debug::log(ERR, "BorderColor rule \"{}\" failed with: {}", effect, e.what()); }
-                m_activeBorderColor.second   = rule->getPropertiesMask();
-                m_inactiveBorderColor.second = rule->getPropertiesMask();
+                if (const auto COLOR = std::get_if<SBorderColorEffect>(&VALUE)) {
+                    if (COLOR->active)
+                        m_activeBorderColor.first = Types::COverridableVar(*COLOR->active, Types::PRIORITY_WINDOW_RULE);
+                    if (COLOR->inactive)
+                        m_inactiveBorderColor.first = Types::COverridableVar(*COLOR->inactive, Types::PRIORITY_WINDOW_RULE);
+                }
+                m_activeBorderColor.second   = MASK;
+                m_inactiveBorderColor.second = MASK;
                 break;
             }
             case WINDOW_RULE_EFFECT_IDLE_INHIBIT: {
-                if (effect == "none")
-                    m_idleInhibitMode.first.set(IDLEINHIBIT_NONE, Types::PRIORITY_WINDOW_RULE);
-                else if (effect == "always")
-                    m_idleInhibitMode.first.set(IDLEINHIBIT_ALWAYS, Types::PRIORITY_WINDOW_RULE);
-                else if (effect == "focus")
-                    m_idleInhibitMode.first.set(IDLEINHIBIT_FOCUS, Types::PRIORITY_WINDOW_RULE);
-                else if (effect == "fullscreen")
-                    m_idleInhibitMode.first.set(IDLEINHIBIT_FULLSCREEN, Types::PRIORITY_WINDOW_RULE);
-                else
-                    Debug::log(ERR, "Rule idleinhibit: unknown mode {}", effect);
-                m_idleInhibitMode.second = rule->getPropertiesMask();
+                if (const auto MODE = std::get_if<Hyprlang::INT>(&VALUE))
+                    m_idleInhibitMode.first.set(*MODE, Types::PRIORITY_WINDOW_RULE);
+                m_idleInhibitMode.second = MASK;
                 break;
             }
             case WINDOW_RULE_EFFECT_OPACITY: {
-                try {
-                    CVarList2 vars(std::string{effect}, 0, ' ');
-
-                    int       opacityIDX = 0;
-
-                    for (const auto& r : vars) {
-                        if (r == "opacity")
-                            continue;
-
-                        if (r == "override") {
-                            if (opacityIDX == 1)
-                                m_alpha.first = Types::COverridableVar(Types::SAlphaValue{.alpha = m_alpha.first.value().alpha, .overridden = true}, Types::PRIORITY_WINDOW_RULE);
-                            else if (opacityIDX == 2)
-                                m_alphaInactive.first =
-                                    Types::COverridableVar(Types::SAlphaValue{.alpha = m_alphaInactive.first.value().alpha, .overridden = true}, Types::PRIORITY_WINDOW_RULE);
-                            else if (opacityIDX == 3)
-                                m_alphaFullscreen.first =
-                                    Types::COverridableVar(Types::SAlphaValue{.alpha = m_alphaFullscreen.first.value().alpha, .overridden = true}, Types::PRIORITY_WINDOW_RULE);
-                        } else {
-                            if (opacityIDX == 0)
-                                m_alpha.first = Types::COverridableVar(Types::SAlphaValue{.alpha = std::stof(std::string{r}), .overridden = false}, Types::PRIORITY_WINDOW_RULE);
-                            else if (opacityIDX == 1)
-                                m_alphaInactive.first =
-                                    Types::COverridableVar(Types::SAlphaValue{.alpha = std::stof(std::string{r}), .overridden = false}, Types::PRIORITY_WINDOW_RULE);
-                            else if (opacityIDX == 2)
-                                m_alphaFullscreen.first =
-                                    Types::COverridableVar(Types::SAlphaValue{.alpha = std::stof(std::string{r}), .overridden = false}, Types::PRIORITY_WINDOW_RULE);
-                            else
-                                throw std::runtime_error("more than 3 alpha values");
-
-                            opacityIDX++;
-                        }
-                    }
-
-                    if (opacityIDX == 1) {
+                if (const auto OPACITY = std::get_if<SOpacityEffect>(&VALUE)) {
+                    if (OPACITY->count > 0)
+                        m_alpha.first = Types::COverridableVar(OPACITY->alpha[0], Types::PRIORITY_WINDOW_RULE);
+                    if (OPACITY->count > 1)
+                        m_alphaInactive.first = Types::COverridableVar(OPACITY->alpha[1], Types::PRIORITY_WINDOW_RULE);
+                    if (OPACITY->count > 2)
+                        m_alphaFullscreen.first = Types::COverridableVar(OPACITY->alpha[2], Types::PRIORITY_WINDOW_RULE);
+
+                    if (OPACITY->count == 1) {
                         m_alphaInactive.first   = m_alpha.first;
                         m_alphaFullscreen.first = m_alpha.first;
                     }
-                } catch (std::exception& e) { Debug::log(ERR, "Opacity rule \"{}\" failed with: {}", effect, e.what()); }
-                m_alpha.second           = rule->getPropertiesMask();
-                m_alphaInactive.second   = rule->getPropertiesMask();
-                m_alphaFullscreen.second = rule->getPropertiesMask();
+                }
+                m_alpha.second           = MASK;
+                m_alphaInactive.second   = MASK;
+                m_alphaFullscreen.second = MASK;
                 break;
             }
             case WINDOW_RULE_EFFECT_TAG: {
-                m_dynamicTags.emplace_back(std::make_pair<>(effect, rule->getPropertiesMask()));
+                m_dynamicTags.emplace_back(std::make_pair<>(effect, MASK));
                 m_tagKeeper.applyTag(effect, true);
                 result.tagsChanged = true;
                 break;
             }
             case WINDOW_RULE_EFFECT_MAX_SIZE: {
-                try {
-                    static auto PCLAMP_TILED = CConfigValue<Hyprlang::INT>("misc:size_limits_tiled");
+                static auto PCLAMP_TILED = CConfigValue<Hyprlang::INT>("misc:size_limits_tiled");
 
-                    if (!m_window)
-                        break;
+                const auto  VEC = std::get_if<Vector2D>(&VALUE);
 
-                    if (!m_window->m_isFloating && !sc<bool>(*PCLAMP_TILED))
-                        break;
-
-                    const auto VEC = configStringToVector2D(effect);
-                    if (VEC.x < 1 || VEC.y < 1) {
-                        Debug::log(ERR, "Invalid size for maxsize");
-                        break;
-                    }
+                if (!VEC || !m_window)
+                    break;
 
-                    m_maxSize.first = Types::COverridableVar(VEC, Types::PRIORITY_WINDOW_RULE);
-                    m_window->clampWindowSize(std::nullopt, m_maxSize.first.value());
+                if (!m_window->m_isFloating && !sc<bool>(*PCLAMP_TILED))
+                    break;
 
-                } catch (std::exception& e) { Debug::log(ERR, "maxsize rule \"{}\" failed with: {}", effect, e.what()); }
-                m_maxSize.second = rule->getPropertiesMask();
+                m_maxSize.first = Types::COverridableVar(*VEC, Types::PRIORITY_WINDOW_RULE);
+                m_window->clampWindowSize(std::nullopt, m_maxSize.first.value());
+                m_maxSize.second = MASK;
                 break;
             }
             case WINDOW_RULE_EFFECT_MIN_SIZE: {
-                try {
-                    static auto PCLAMP_TILED = CConfigValue<Hyprlang::INT>("misc:size_limits_tiled");
+                static auto PCLAMP_TILED = CConfigValue<Hyprlang::INT>("misc:size_limits_tiled");
 
-                    if (!m_window)
-                        break;
+                const auto  VEC = std::get_if<Vector2D>(&VALUE);
 
-                    if (!m_window->m_isFloating && !sc<bool>(*PCLAMP_TILED))
-                        break;
+                if (!VEC || !m_window)
+                    break;
 
-                    const auto VEC = configStringToVector2D(effect);
-                    if (VEC.x < 1 || VEC.y < 1) {
-                        Debug::log(ERR, "Invalid size for maxsize");
-                        break;
-                    }
+                if (!m_window->m_isFloating && !sc<bool>(*PCLAMP_TILED))
+                    break;
 
-                    m_minSize.first = Types::COverridableVar(VEC, Types::PRIORITY_WINDOW_RULE);
-                    m_window->clampWindowSize(std::nullopt, m_minSize.first.value());
-                } catch (std::exception& e) { Debug::log(ERR, "minsize rule \"{}\" failed with: {}", effect, e.what()); }
-                m_minSize.second = rule->getPropertiesMask();
+                m_minSize.first = Types::COverridableVar(*VEC, Types::PRIORITY_WINDOW_RULE);
+                m_window->clampWindowSize(std::nullopt, m_minSize.first.value());
+                m_minSize.second = MASK;
                 break;
             }
             case WINDOW_RULE_EFFECT_BORDER_SIZE: {
-                try {
+                if (const auto SIZE = std::get_if<Hyprlang::INT>(&VALUE)) {
                     auto oldBorderSize = m_borderSize.first.valueOrDefault();
-                    m_borderSize.first.set(std::stoi(effect), Types::PRIORITY_WINDOW_RULE);
-                    m_borderSize.second |= rule->getPropertiesMask();
+                    m_borderSize.first.set(*SIZE, Types::PRIORITY_WINDOW_RULE);
+                    m_borderSize.second |= MASK;
                     if (oldBorderSize != m_borderSize.first.valueOrDefault())
                         result.needsRelayout = true;
-                } catch (...) { Debug::log(ERR, "CWindowRuleApplicator::applyDynamicRule: invalid border_size {}", effect); }
+                }
                 break;
             }
             case WINDOW_RULE_EFFECT_ALLOWS_INPUT: {
-                m_allowsInput.first.set(truthy(effect), Types::PRIORITY_WINDOW_RULE);
-                m_allowsInput.second |= rule->getPropertiesMask();
+                m_allowsInput.first.set(TRUTHY(VALUE), Types::PRIORITY_WINDOW_RULE);
+                m_allowsInput.second |= MASK;
                 break;
             }
             case WINDOW_RULE_EFFECT_DIM_AROUND: {
-                m_dimAround.first.set(truthy(effect), Types::PRIORITY_WINDOW_RULE);
-                m_dimAround.second |= rule->getPropertiesMask();
+                m_dimAround.first.set(TRUTHY(VALUE), Types::PRIORITY_WINDOW_RULE);
+                m_dimAround.second |= MASK;
                 break;
             }
             case WINDOW_RULE_EFFECT_DECORATE: {
-                m_decorate.first.set(truthy(effect), Types::PRIORITY_WINDOW_RULE);
-                m_decorate.second |= rule->getPropertiesMask();
+                m_decorate.first.set(TRUTHY(VALUE), Types::PRIORITY_WINDOW_RULE);
+                m_decorate.second |= MASK;
                 break;
             }
             case WINDOW_RULE_EFFECT_FOCUS_ON_ACTIVATE: {
-                m_focusOnActivate.first.set(truthy(effect), Types::PRIORITY_WINDOW_RULE);
-                m_focusOnActivate.second |= rule->getPropertiesMask();
+                m_focusOnActivate.first.set(TRUTHY(VALUE), Types::PRIORITY_WINDOW_RULE);
+                m_focusOnActivate.second |= MASK;
                 break;
             }
             case WINDOW_RULE_EFFECT_KEEP_ASPECT_RATIO: {
-                m_keepAspectRatio.first.set(truthy(effect), Types::PRIORITY_WINDOW_RULE);
-                m_keepAspectRatio.second |= rule->getPropertiesMask();
+                m_keepAspectRatio.first.set(TRUTHY(VALUE), Types::PRIORITY_WINDOW_RULE);
+                m_keepAspectRatio.second |= MASK;
                 break;
             }
             case WINDOW_RULE_EFFECT_NEAREST_NEIGHBOR: {
-                m_nearestNeighbor.first.set(truthy(effect), Types::PRIORITY_WINDOW_RULE);
-                m_nearestNeighbor.second |= rule->getPropertiesMask();
+                m_nearestNeighbor.first.set(TRUTHY(VALUE), Types::PRIORITY_WINDOW_RULE);
+                m_nearestNeighbor.second |= MASK;
                 break;
             }
             case WINDOW_RULE_EFFECT_NO_ANIM: {
-                m_noAnim.first.set(truthy(effect), Types::PRIORITY_WINDOW_RULE);
-                m_noAnim.second |= rule->getPropertiesMask();
+                m_noAnim.first.set(TRUTHY(VALUE), Types::PRIORITY_WINDOW_RULE);
+                m_noAnim.second |= MASK;
                 break;
             }
             case WINDOW_RULE_EFFECT_NO_BLUR: {
-                m_noBlur.first.set(truthy(effect), Types::PRIORITY_WINDOW_RULE);
-                m_noBlur.second |= rule->getPropertiesMask();
+                m_noBlur.first.set(TRUTHY(VALUE), Types::PRIORITY_WINDOW_RULE);
+                m_noBlur.second |= MASK;
                 break;
             }
             case WINDOW_RULE_EFFECT_NO_DIM: {
-                m_noDim.first.set(truthy(effect), Types::PRIORITY_WINDOW_RULE);
-                m_noDim.second |= rule->getPropertiesMask();
+                m_noDim.first.set(TRUTHY(VALUE), Types::PRIORITY_WINDOW_RULE);
+                m_noDim.second |= MASK;
                 break;
             }
             case WINDOW_RULE_EFFECT_NO_FOCUS: {
-                m_noFocus.first.set(truthy(effect), Types::PRIORITY_WINDOW_RULE);
-                m_noFocus.second |= rule->getPropertiesMask();
+                m_noFocus.first.set(TRUTHY(VALUE), Types::PRIORITY_WINDOW_RULE);
+                m_noFocus.second |= MASK;
                 break;
             }
             case WINDOW_RULE_EFFECT_NO_FOLLOW_MOUSE: {
-                m_noFollowMouse.first.set(truthy(effect), Types::PRIORITY_WINDOW_RULE);
-                m_noFollowMouse.second |= rule->getPropertiesMask();
+                m_noFollowMouse.first.set(TRUTHY(VALUE), Types::PRIORITY_WINDOW_RULE);
+                m_noFollowMouse.second |= MASK;
                 break;
             }
             case WINDOW_RULE_EFFECT_NO_MAX_SIZE: {
-                m_noMaxSize.first.set(truthy(effect), Types::PRIORITY_WINDOW_RULE);
-                m_noMaxSize.second |= rule->getPropertiesMask();
+                m_noMaxSize.first.set(TRUTHY(VALUE), Types::PRIORITY_WINDOW_RULE);
+                m_noMaxSize.second |= MASK;
                 break;
             }
             case WINDOW_RULE_EFFECT_NO_SHADOW: {
-                m_noShadow.first.set(truthy(effect), Types::PRIORITY_WINDOW_RULE);
-                m_noShadow.second |= rule->getPropertiesMask();
+                m_noShadow.first.set(TRUTHY(VALUE), Types::PRIORITY_WINDOW_RULE);
+                m_noShadow.second |= MASK;
                 break;
             }
             case WINDOW_RULE_EFFECT_NO_SHORTCUTS_INHIBIT: {
-                m_noShortcutsInhibit.first.set(truthy(effect), Types::PRIORITY_WINDOW_RULE);
-                m_noShortcutsInhibit.second |= rule->getPropertiesMask();
+                m_noShortcutsInhibit.first.set(TRUTHY(VALUE), Types::PRIORITY_WINDOW_RULE);
+                m_noShortcutsInhibit.second |= MASK;
                 break;
             }
             case WINDOW_RULE_EFFECT_OPAQUE: {
-                m_opaque.first.set(truthy(effect), Types::PRIORITY_WINDOW_RULE);
-                m_opaque.second |= rule->getPropertiesMask();
+                m_opaque.first.set(TRUTHY(VALUE), Types::PRIORITY_WINDOW_RULE);
+                m_opaque.second |= MASK;
                 break;
             }
             case WINDOW_RULE_EFFECT_FORCE_RGBX: {
-                m_RGBX.first.set(truthy(effect), Types::PRIORITY_WINDOW_RULE);
-                m_RGBX.second |= rule->getPropertiesMask();
+                m_RGBX.first.set(TRUTHY(VALUE), Types::PRIORITY_WINDOW_RULE);
+                m_RGBX.second |= MASK;
                 break;
             }
             case WINDOW_RULE_EFFECT_SYNC_FULLSCREEN: {
-                m_syncFullscreen.first.set(truthy(effect), Types::PRIORITY_WINDOW_RULE);
-                m_syncFullscreen.second |= rule->getPropertiesMask();
+                m_syncFullscreen.first.set(TRUTHY(VALUE), Types::PRIORITY_WINDOW_RULE);
+                m_syncFullscreen.second |= MASK;
                 break;
             }
             case WINDOW_RULE_EFFECT_IMMEDIATE: {
-                m_tearing.first.set(truthy(effect), Types::PRIORITY_WINDOW_RULE);
-                m_tearing.second |= rule->getPropertiesMask();
+                m_tearing.first.set(TRUTHY(VALUE), Types::PRIORITY_WINDOW_RULE);
+                m_tearing.second |= MASK;
                 break;
             }
             case WINDOW_RULE_EFFECT_XRAY: {
-                m_xray.first.set(truthy(effect), Types::PRIORITY_WINDOW_RULE);
-                m_xray.second |= rule->getPropertiesMask();
+                m_xray.first.set(TRUTHY(VALUE), Types::PRIORITY_WINDOW_RULE);
+                m_xray.second |= MASK;
                 break;
             }
             case WINDOW_RULE_EFFECT_RENDER_UNFOCUSED: {
-                m_renderUnfocused.first.set(truthy(effect), Types::PRIORITY_WINDOW_RULE);
-                m_renderUnfocused.second |= rule->getPropertiesMask();
+                m_renderUnfocused.first.set(TRUTHY(VALUE), Types::PRIORITY_WINDOW_RULE);
+                m_renderUnfocused.second |= MASK;
                 break;
             }
             case WINDOW_RULE_EFFECT_NO_SCREEN_SHARE: {
-                m_noScreenShare.first.set(truthy(effect), Types::PRIORITY_WINDOW_RULE);
-                m_noScreenShare.second |= rule->getPropertiesMask();
+                m_noScreenShare.first.set(TRUTHY(VALUE), Types::PRIORITY_WINDOW_RULE);
+                m_noScreenShare.second |= MASK;
                 break;
             }
             case WINDOW_RULE_EFFECT_NO_VRR: {
-                m_noVRR.first.set(truthy(effect), Types::PRIORITY_WINDOW_RULE);
-                m_noVRR.second |= rule->getPropertiesMask();
+                m_noVRR.first.set(TRUTHY(VALUE), Types::PRIORITY_WINDOW_RULE);
+                m_noVRR.second |= MASK;
                 break;
             }
             case WINDOW_RULE_EFFECT_STAY_FOCUSED: {
-                m_stayFocused.first.set(truthy(effect), Types::PRIORITY_WINDOW_RULE);
-                m_stayFocused.second |= rule->getPropertiesMask();
+                m_stayFocused.first.set(TRUTHY(VALUE), Types::PRIORITY_WINDOW_RULE);
+                m_stayFocused.second |= MASK;
                 break;
             }
             case WINDOW_RULE_EFFECT_SCROLL_MOUSE: {
-                try {
-                    m_scrollMouse.first.set(std::clamp(std::stof(effect), 0.01F, 10.F), Types::PRIORITY_WINDOW_RULE);
-                    m_scrollMouse.second |= rule->getPropertiesMask();
-                } catch (...) { Debug::log(ERR, "CWindowRuleApplicator::applyDynamicRule: invalid scroll_mouse {}", effect); }
+                if (const auto FACTOR = std::get_if<float>(&VALUE)) {
+                    m_scrollMouse.first.set(*FACTOR, Types::PRIORITY_WINDOW_RULE);
+                    m_scrollMouse.second |= MASK;
+                }
                 break;
             }
             case WINDOW_RULE_EFFECT_SCROLL_TOUCHPAD: {
-                try {
-                    m_scrollTouchpad.first.set(std::clamp(std::stof(effect), 0.01F, 10.F), Types::PRIORITY_WINDOW_RULE);
-                    m_scrollTouchpad.second |= rule->getPropertiesMask();
-                } catch (...) { Debug::log(ERR, "CWindowRuleApplicator::applyDynamicRule: invalid scroll_touchpad {}", effect); }
+                if (const auto FACTOR = std::get_if<float>(&VALUE)) {
+                    m_scrollTouchpad.first.set(*FACTOR, Types::PRIORITY_WINDOW_RULE);
+                    m_scrollTouchpad.second |= MASK;
+                }
                 break;
             }
         }
@@ -542,12 +469,7 @@ void CWindowRuleApplicator::readStaticRules() {
     std::vector<SP<IRule>> toRemove;
     bool                   tagsWereChanged = false;
 
-    for (const auto& r : ruleEngine()->rules()) {
-        if (r->type() != RULE_TYPE_WINDOW)
-            continue;
-
-        auto wr = reinterpretPointerCast<CWindowRule>(r);
-
+    for (const auto& wr : ruleEngine()->windowRules().rules) {
         if (!wr->matches(m_window.lock(), true))
             continue;
 
@@ -571,15 +493,10 @@ void CWindowRuleApplicator::readStaticRules() {
         propsToRecheck |= RULE_PROP_CONTENT;
 
     if (propsToRecheck != RULE_PROP_NONE) {
-        for (const auto& r : ruleEngine()->rules()) {
-            if (r->type() != RULE_TYPE_WINDOW)
-                continue;
-
-            if (!(r->getPropertiesMask() & propsToRecheck))
+        for (const auto& wr : ruleEngine()->windowRules().rules) {
+            if (!(wr->getPropertiesMask() & propsToRecheck))
                 continue;
 
-            auto wr = reinterpretPointerCast<CWindowRule>(r);
-
             if (!wr->matches(m_window.lock(), true))
                 continue;
 
@@ -594,51 +511,73 @@ void CWindowRuleApplicator::propertiesChanged(std::underlying_type_t<eRuleProper
 
     resetProps(props);
 
-    bool                                                        needsRelayout = false;
+    enum eRuleState : uint8_t {
+        RULE_UNCHECKED = 0,
+        RULE_MATCHED,
+        RULE_UNMATCHED,
+    };
 
-    std::unordered_set<CWindowRuleEffectContainer::storageType> effectsNeedingRecheck;
-    std::unordered_set<SP<CWindowRule>>                         passedWrs;
+    const auto& INDEX         = ruleEngine()->windowRules();
+    const auto  PWINDOW       = m_window.lock();
+    bool        needsRelayout = false;
 
-    for (const auto& r : ruleEngine()->rules()) {
-        if (r->type() != RULE_TYPE_WINDOW)
-            continue;
+    // per rule in INDEX, so nothing gets matched twice
+    std::vector<uint8_t>                                 state(INDEX.rules.size(), RULE_UNCHECKED);
+    std::vector<size_t>                                  toApply;
+    std::vector<CWindowRuleEffectContainer::storageType> effectsNeedingRecheck;
 
-        if (!(r->getPropertiesMask() & props))
-            continue;
+    // returns whether the rule newly matched
+    const auto CHECK = [&](size_t idx) {
+        if (state[idx] != RULE_UNCHECKED)
+            return false;
+
+        state[idx] = INDEX.rules[idx]->matches(PWINDOW) ? RULE_MATCHED : RULE_UNMATCHED;
+        if (state[idx] == RULE_MATCHED)
+            toApply.emplace_back(idx);
 
-        auto wr = reinterpretPointerCast<CWindowRule>(r);
+        return state[idx] == RULE_MATCHED;
+    };
 
-        if (!wr->matches(m_window.lock()))
+    // first, rules that depend on a changed prop
+    for (size_t bit = 0; bit < INDEX.byProp.size(); ++bit) {
+        if (!(props & (1U << bit)))
             continue;
 
-        for (const auto& [type, eff] : wr->effects()) {
-            effectsNeedingRecheck.emplace(type);
-        }
+        for (const auto IDX : INDEX.byProp[bit]) {
+            if (!CHECK(IDX))
+                continue;
 
-        passedWrs.emplace(std::move(wr));
+            for (const auto& [type, eff] : INDEX.rules[IDX]->effects()) {
+                if (!std::ranges::contains(effectsNeedingRecheck, type))
+                    effectsNeedingRecheck.emplace_back(type);
+            }
+        }
     }
 
-    for (const auto& r : ruleEngine()->rules()) {
-        if (r->type() != RULE_TYPE_WINDOW)
+    // resetProps() cleared what those set, so other rules setting the same effects need to apply again
+    for (const auto& effect : effectsNeedingRecheck) {
+        const auto IT = INDEX.byEffect.find(effect);
+        if (IT == INDEX.byEffect.end())
             continue;
 
-        const auto WR = reinterpretPointerCast<CWindowRule>(r);
-
-        if (!(WR->getPropertiesMask() & props) && !setsIntersect(WR->effectsSet(), effectsNeedingRecheck))
-            continue;
+        for (const auto IDX : IT->second) {
+            CHECK(IDX);
+        }
+    }
 
-        if (!std::ranges::contains(passedWrs, WR) && !WR->matches(m_window.lock()))
-            continue;
+    // later rules win, so apply in config order
+    std::ranges::sort(toApply);
 
-        const auto RES = applyDynamicRule(WR);
+    for (const auto IDX : toApply) {
+        const auto RES = applyDynamicRule(INDEX.rules[IDX]);
         needsRelayout  = needsRelayout || RES.needsRelayout;
     }
 
     m_window->updateDecorationValues();
 
     if (needsRelayout)
-        g_pDecorationPositioner->forceRecalcFor(m_window.lock());
+        g_pDecorationPositioner->forceRecalcFor(PWINDOW);
 
     // for plugins
-    EMIT_HOOK_EVENT("windowUpdateRules", m_window.lock());
+    EMIT_HOOK_EVENT("windowUpdateRules", PWINDOW);
 }
@@ -0,0 +1,151 @@
+#include "HitTestIndex.hpp"
+#include "../Window.hpp"
+#include "../../Compositor.hpp"
+#include "../../config/ConfigValue.hpp"
+#include "../../managers/HookSystemManager.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace Desktop;
+
+constexpr double CELL_SIZE = 128.0;
+
+SP<CHitTestIndex> Desktop::hitTestIndex() {
+    static SP<CHitTestIndex> index = makeShared<CHitTestIndex>();
+    return index;
+}
+
+static int borderGrabArea() {
+    static auto PRESIZEONBORDER   = CConfigValue<Hyprlang::INT>("general:resize_on_border");
+    static auto PBORDERSIZE       = CConfigValue<Hyprlang::INT>("general:border_size");
+    static auto PBORDERGRABEXTEND = CConfigValue<Hyprlang::INT>("general:extend_border_grab_area");
+    return *PRESIZEONBORDER ? *PBORDERSIZE + *PBORDERGRABEXTEND : 0;
+}
+
+Desktop::CHitTestIndex::CHitTestIndex() {
+    // everything else that changes window geometry calls invalidate() directly
+    for (const auto& EVENT : {"openWindowEarly", "closeWindow", "destroyWindow", "moveWindow", "changeFloatingMode", "fullscreen", "pin", "windowUpdateRules", "monitorAdded",
+                              "monitorRemoved", "monitorLayoutChanged", "configReloaded"}) {
+        m_hooks.emplace_back(g_pHookSystem->hookDynamic(EVENT, [this](void* self, SCallbackInfo& info, std::any data) { invalidate(); }));
+    }
+}
+
+void Desktop::CHitTestIndex::invalidate() {
+    m_dirty = true;
+}
+
+const CHitTestIndex::SStats& Desktop::CHitTestIndex::stats() {
+    return m_stats;
+}
+
+void Desktop::CHitTestIndex::rebuild() {
+    m_dirty    = false;
+    m_grabArea = borderGrabArea();
+    m_windows.clear();
+    m_always.clear();
+    m_grids.clear();
+    m_stats.rebuilds++;
+
+    for (auto const& m : g_pCompositor->m_monitors) {
+        if (!m->m_enabled || m->m_size.x <= 0 || m->m_size.y <= 0)
+            continue;
+
+        auto& grid = m_grids.emplace_back();
+        grid.box   = {m->m_position, m->m_size};
+        grid.cols  = std::max(1, sc<int>(std::ceil(m->m_size.x / CELL_SIZE)));
+        grid.rows  = std::max(1, sc<int>(std::ceil(m->m_size.y / CELL_SIZE)));
+        grid.cells.resize(sc<size_t>(grid.cols) * grid.rows);
+    }
+
+    m_windows.reserve(g_pCompositor->m_windows.size());
+
+    for (auto const& w : g_pCompositor->m_windows) {
+        const auto IDX = sc<uint32_t>(m_windows.size());
+        m_windows.emplace_back(w);
+
+        if (w->popupsCount() > 0 || w->m_ruleApplicator->dimAround().valueOrDefault()) {
+            m_always.emplace_back(IDX);
+            continue;
+        }
+
+        // a superset of every box vectorToWindowUnified checks: real geometry with all extents and the
+        // border grab area, plus the layout box it uses for tiled windows.
+        auto REAL = w->getWindowBoxUnified(RESERVED_EXTENTS | INPUT_EXTENTS | FULL_EXTENTS);
+        REAL.expand(m_grabArea);
+
+        auto TL = REAL.pos();
+        auto BR = REAL.pos() + REAL.size();
+        if (!w->m_isFloating) {
+            TL = {std::min(TL.x, w->m_position.x), std::min(TL.y, w->m_position.y)};
+            BR = {std::max(BR.x, w->m_position.x + w->m_size.x), std::max(BR.y, w->m_position.y + w->m_size.y)};
+        }
+
+        for (auto& grid : m_grids) {
+            if (BR.x < grid.box.x || BR.y < grid.box.y || TL.x > grid.box.x + grid.box.w || TL.y > grid.box.y + grid.box.h)
+                continue;
+
+            const int X1 = std::clamp(sc<int>((TL.x - grid.box.x) / CELL_SIZE), 0, grid.cols - 1);
+            const int Y1 = std::clamp(sc<int>((TL.y - grid.box.y) / CELL_SIZE), 0, grid.rows - 1);
+            const int X2 = std::clamp(sc<int>((BR.x - grid.box.x) / CELL_SIZE), 0, grid.cols - 1);
+            const int Y2 = std::clamp(sc<int>((BR.y - grid.box.y) / CELL_SIZE), 0, grid.rows - 1);
+
+            for (int y = Y1; y <= Y2; ++y) {
+                for (int x = X1; x <= X2; ++x) {
+                    grid.cells[(sc<size_t>(y) * grid.cols) + x].emplace_back(IDX);
+                }
+            }
+        }
+    }
+}
+
+const std::vector<uint32_t>* Desktop::CHitTestIndex::cellAt(const Vector2D& pos) {
+    for (auto const& grid : m_grids) {
+        if (!grid.box.containsPoint(pos))
+            continue;
+
+        const int X = std::clamp(sc<int>((pos.x - grid.box.x) / CELL_SIZE), 0, grid.cols - 1);
+        const int Y = std::clamp(sc<int>((pos.y - grid.box.y) / CELL_SIZE), 0, grid.rows - 1);
+        return &grid.cells[(sc<size_t>(Y) * grid.cols) + X];
+    }
+
+    return nullptr;
+}
+
+std::vector<PHLWINDOW> Desktop::CHitTestIndex::candidatesAt(const Vector2D& pos, const Vector2D& pointer) {
+    if (m_dirty || m_grabArea != borderGrabArea())
+        rebuild();
+
+    m_stats.queries++;
+
+    const auto POSCELL     = cellAt(pos);
+    const auto POINTERCELL = cellAt(pointer);
+
+    // off every monitor: nothing to narrow down with
+    if (!POSCELL || !POINTERCELL) {
+        m_stats.fallbacks++;
+        m_stats.candidates += g_pCompositor->m_windows.size();
+        return g_pCompositor->m_windows;
+    }
+
+    std::vector<uint32_t> indices = m_always;
+    indices.insert(indices.end(), POSCELL->begin(), POSCELL->end());
+    if (POINTERCELL != POSCELL)
+        indices.insert(indices.end(), POINTERCELL->begin(), POINTERCELL->end());
+
+    std::ranges::sort(indices);
+    const auto [first, last] = std::ranges::unique(indices);
+    indices.erase(first, last);
+
+    std::vector<PHLWINDOW> result;
+    result.reserve(indices.size());
+
+    for (const auto IDX : indices) {
+        if (const auto W = m_windows[IDX].lock(); W)
+            result.emplace_back(W);
+    }
+
+    m_stats.candidates += result.size();
+
+    return result;
+}
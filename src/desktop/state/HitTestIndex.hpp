@@ -0,0 +1,63 @@
+#pragma once
+
+#include <vector>
+
+#include "../DesktopTypes.hpp"
+#include "../../SharedDefs.hpp"
+#include "../../helpers/math/Math.hpp"
+
+namespace Desktop {
+
+    /*
+        Per-monitor uniform grids over a conservative input box of every window, in z-order.
+        CCompositor::vectorToWindowUnified asks it for the windows that can possibly be under a point
+        and runs its exact checks on those only, instead of every window.
+
+        The boxes are rebuilt lazily: anything that moves, resizes, (un)maps, restacks or re-decorates
+        a window calls invalidate().
+    */
+    class CHitTestIndex {
+      public:
+        CHitTestIndex();
+        ~CHitTestIndex() = default;
+
+        CHitTestIndex(CHitTestIndex&&)      = delete;
+        CHitTestIndex(CHitTestIndex&)       = delete;
+        CHitTestIndex(const CHitTestIndex&) = delete;
+
+        void invalidate();
+
+        // windows that may be hit at pos or at the pointer, bottom to top like m_windows.
+        std::vector<PHLWINDOW> candidatesAt(const Vector2D& pos, const Vector2D& pointer);
+
+        struct SStats {
+            size_t rebuilds   = 0;
+            size_t queries    = 0;
+            size_t candidates = 0;
+            size_t fallbacks  = 0;
+        };
+
+        const SStats& stats();
+
+      private:
+        struct SGrid {
+            CBox                               box;
+            int                                cols = 0, rows = 0;
+            std::vector<std::vector<uint32_t>> cells;
+        };
+
+        void                              rebuild();
+        const std::vector<uint32_t>*      cellAt(const Vector2D& pos);
+
+        bool                              m_dirty    = true;
+        int                               m_grabArea = 0;
+        std::vector<PHLWINDOWREF>         m_windows;
+        std::vector<uint32_t>             m_always; // popups and dimAround can be hit anywhere
+        std::vector<SGrid>                m_grids;
+        SStats                            m_stats;
+
+        std::vector<SP<HOOK_CALLBACK_FN>> m_hooks;
+    };
+
+    SP<CHitTestIndex> hitTestIndex();
+};
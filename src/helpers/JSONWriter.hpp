@@ -0,0 +1,105 @@
+#pragma once
+
+#include <algorithm>
+#include <format>
+#include <iterator>
+#include <string>
+#include <string_view>
+
+// a string that gets JSON-escaped while being formatted, without a temporary copy.
+// Escapes exactly like escapeJSONStrings().
+struct SJSONEscaped {
+    std::string_view str;
+};
+
+inline SJSONEscaped jsonEscaped(std::string_view str) {
+    return SJSONEscaped{str};
+}
+
+template <typename CharT>
+struct std::formatter<SJSONEscaped, CharT> {
+    constexpr auto parse(std::basic_format_parse_context<CharT>& ctx) {
+        return ctx.begin();
+    }
+
+    template <typename FormatContext>
+    auto format(const SJSONEscaped& e, FormatContext& ctx) const {
+        auto   out   = ctx.out();
+        size_t begin = 0;
+
+        const auto FLUSH = [&](size_t end) {
+            if (end > begin)
+                out = std::ranges::copy(e.str.substr(begin, end - begin), out).out;
+        };
+
+        for (size_t i = 0; i < e.str.size(); ++i) {
+            const char c = e.str[i];
+
+            if (c != '"' && c != '\\' && (c < '\x00' || c > '\x1f'))
+                continue;
+
+            FLUSH(i);
+            begin = i + 1;
+
+            switch (c) {
+                case '"': out = std::ranges::copy(std::string_view{"\\\""}, out).out; break;
+                case '\\': out = std::ranges::copy(std::string_view{"\\\\"}, out).out; break;
+                case '\b': out = std::ranges::copy(std::string_view{"\\b"}, out).out; break;
+                case '\f': out = std::ranges::copy(std::string_view{"\\f"}, out).out; break;
+                case '\n': out = std::ranges::copy(std::string_view{"\\n"}, out).out; break;
+                case '\r': out = std::ranges::copy(std::string_view{"\\r"}, out).out; break;
+                case '\t': out = std::ranges::copy(std::string_view{"\\t"}, out).out; break;
+                default: out = std::format_to(out, "\\u{:04x}", static_cast<int>(c)); break;
+            }
+        }
+
+        FLUSH(e.str.size());
+
+        return out;
+    }
+};
+
+// Builds hyprctl-style output (json or not) in one growable buffer.
+class CJSONWriter {
+  public:
+    CJSONWriter(size_t reserve = 0) {
+        m_buffer.reserve(reserve);
+    }
+
+    template <typename... Args>
+    void format(std::format_string<Args...> fmt, Args&&... args) {
+        std::format_to(std::back_inserter(m_buffer), fmt, std::forward<Args>(args)...);
+    }
+
+    void append(std::string_view str) {
+        m_buffer.append(str);
+    }
+
+    void appendEscaped(std::string_view str) {
+        format("{}", jsonEscaped(str));
+    }
+
+    void trimTrailingComma() {
+        if (!m_buffer.empty() && m_buffer.back() == ',')
+            m_buffer.pop_back();
+    }
+
+    bool empty() const {
+        return m_buffer.empty();
+    }
+
+    size_t size() const {
+        return m_buffer.size();
+    }
+
+    const std::string& str() const {
+        return m_buffer;
+    }
+
+    std::string take() {
+        return std::move(m_buffer);
+    }
+
+  private:
+    std::string m_buffer;
+};
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <unordered_map>
+#include <utility>
+
+// A map of at most capacity entries. Inserting into a full one evicts the least recently used entry.
+template <typename K, typename V, typename Hash = std::hash<K>>
+class CLRUCache {
+  public:
+    explicit CLRUCache(size_t capacity) : m_capacity(capacity) {
+        ;
+    }
+
+    // marks the entry as used, nullptr if there's none. Stays valid until the entry is evicted.
+    V* get(const K& key) {
+        const auto IT = m_entries.find(key);
+        if (IT == m_entries.end())
+            return nullptr;
+
+        m_lru.splice(m_lru.begin(), m_lru, IT->second.lru);
+        return &IT->second.value;
+    }
+
+    // key must not be in the cache yet
+    V& insert(const K& key, V value) {
+        if (m_entries.size() >= m_capacity) {
+            m_entries.erase(m_entries.find(*m_lru.back()));
+            m_lru.pop_back();
+        }
+
+        const auto IT  = m_entries.emplace(key, SEntry{.value = std::move(value)}).first;
+        IT->second.lru = m_lru.emplace(m_lru.begin(), &IT->first);
+
+        return IT->second.value;
+    }
+
+    void clear() {
+        m_entries.clear();
+        m_lru.clear();
+    }
+
+    size_t size() const {
+        return m_entries.size();
+    }
+
+    size_t capacity() const {
+        return m_capacity;
+    }
+
+  private:
+    struct SEntry {
+        V                                     value;
+        typename std::list<const K*>::iterator lru;
+    };
+
+    std::unordered_map<K, SEntry, Hash> m_entries;
+    std::list<const K*>                 m_lru; // keys of m_entries, most recently used first
+    size_t                              m_capacity = 0;
+};
@@ -32,6 +32,7 @@
 #include "time/Time.hpp"
 #include "../desktop/LayerSurface.hpp"
 #include "../desktop/state/FocusState.hpp"
+#include "../debug/Telemetry.hpp"
 #include <aquamarine/output/Output.hpp>
 #include "debug/Log.hpp"
 #include "debug/HyprNotificationOverlay.hpp"
@@ -114,10 +115,9 @@ void CMonitor::onConnect(bool noRule) {
             ts = nullptr;
         }
 
-        if (!ts)
-            PROTO::presentation->onPresented(m_self.lock(), Time::steadyNow(), event.refresh, event.seq, event.flags);
-        else
-            PROTO::presentation->onPresented(m_self.lock(), Time::fromTimespec(event.when), event.refresh, event.seq, event.flags);
+        const auto WHEN = ts ? Time::fromTimespec(ts) : Time::steadyNow();
+
+        PROTO::presentation->onPresented(m_self.lock(), WHEN, event.refresh, event.seq, event.flags);
 
         if (m_zoomAnimFrameCounter < 5) {
             m_zoomAnimFrameCounter++;
@@ -140,7 +140,7 @@ void CMonitor::onConnect(bool noRule) {
             });
         }
 
-        m_frameScheduler->onPresented();
+        m_frameScheduler->onPresented(WHEN);
 
         m_events.presented.emit();
     });
@@ -351,6 +351,7 @@ void CMonitor::onDisconnect(bool destroy) {
             return;
         g_pEventManager->postEvent(SHyprIPCEvent{"monitorremoved", m_name});
         g_pEventManager->postEvent(SHyprIPCEvent{"monitorremovedv2", std::format("{},{},{}", m_id, m_name, m_shortDescription)});
+        g_pTelemetry->onMonitorRemoved(m_self.lock());
         EMIT_HOOK_EVENT("monitorRemoved", m_self.lock());
         g_pCompositor->scheduleMonitorStateRecheck();
     }};
@@ -145,6 +145,7 @@ class CMonitor {
 
     bool                        m_pendingFrame    = false; // if we schedule a frame during rendering, reschedule it after
     bool                        m_renderingActive = false;
+    uint64_t                    m_renderedFrames  = 0; // renderMonitor calls that drew something, it bails early a lot
 
     bool                        m_ratsScheduled = false;
     CTimer                      m_lastPresentationTimer;
@@ -3,18 +3,72 @@
 #include "../Compositor.hpp"
 #include "../render/Renderer.hpp"
 #include "../managers/eventLoop/EventLoopManager.hpp"
+#include "../managers/eventLoop/EventLoopTimer.hpp"
+
+static float msSince(const std::chrono::high_resolution_clock::time_point& tp) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - tp).count() / 1000.F;
+}
+
+static float msSince(const Time::steady_tp& tp) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(Time::steadyNow() - tp).count() / 1000.F;
+}
 
 CMonitorFrameScheduler::CMonitorFrameScheduler(PHLMONITOR m) : m_monitor(m) {
     ;
 }
 
+CMonitorFrameScheduler::~CMonitorFrameScheduler() {
+    if (m_deadlineTimer && g_pEventLoopManager)
+        g_pEventLoopManager->removeTimer(m_deadlineTimer);
+}
+
 bool CMonitorFrameScheduler::newSchedulingEnabled() {
     static auto PENABLENEW = CConfigValue<Hyprlang::INT>("render:new_render_scheduling");
 
     return *PENABLENEW && g_pHyprOpenGL->explicitSyncSupported();
 }
 
+bool CMonitorFrameScheduler::deadlineEnabled() {
+    static auto PDEADLINE = CConfigValue<Hyprlang::INT>("render:render_deadline");
+
+    return *PDEADLINE && !m_monitor->m_tearingState.activelyTearing;
+}
+
+void CMonitorFrameScheduler::addRenderTimeSample(float ms) {
+    // follow a heavier scene quickly so it doesn't miss for long, and settle back slowly so a single light frame doesn't cause a miss
+    const float WEIGHT = ms > m_deadline.estimateMs ? 0.5F : 0.05F;
+
+    if (m_deadline.estimateMs <= 0.F)
+        m_deadline.estimateMs = ms;
+    else
+        m_deadline.estimateMs += (ms - m_deadline.estimateMs) * WEIGHT;
+}
+
+float CMonitorFrameScheduler::deadlineDelayMs() {
+    static auto PMARGIN = CConfigValue<Hyprlang::FLOAT>("render:render_deadline_margin");
+
+    if (m_deadlineBackoff > 0 || m_deadline.estimateMs <= 0.F || m_monitor->m_refreshRate <= 0.F)
+        return 0.F;
+
+    // the frame event comes right after a vblank, the next one is a refresh after the last presentation
+    const float INTERVAL    = 1000.F / m_monitor->m_refreshRate;
+    const float SINCEVBLANK = msSince(m_lastPresented);
+
+    if (SINCEVBLANK >= INTERVAL)
+        return 0.F; // no recent presentation to go by
+
+    const float DELAY = INTERVAL - SINCEVBLANK - m_deadline.estimateMs - *PMARGIN;
+
+    // anything shorter isn't worth a timer
+    return DELAY < 0.5F ? 0.F : DELAY;
+}
+
 void CMonitorFrameScheduler::onSyncFired() {
+    // the fence fires once the gpu is done, so this covers both the cpu and gpu side of the frame
+    if (deadlineEnabled() && m_sampleSync)
+        addRenderTimeSample(msSince(m_lastRenderBegun));
+
+    m_sampleSync = false;
 
     if (!newSchedulingEnabled())
         return;
@@ -39,17 +93,34 @@ void CMonitorFrameScheduler::onSyncFired() {
 
     // get a ref to ourselves. renderMonitor can destroy this scheduler if it decides to perform a monitor reload
     // FIXME: this is horrible. "renderMonitor" should not be able to do that.
-    auto self = m_self;
+    auto       self     = m_self;
+    const auto RENDERED = m_monitor->m_renderedFrames;
 
     g_pHyprRenderer->renderMonitor(m_monitor.lock(), false);
 
     if (!self)
         return;
 
+    m_sampleSync = m_monitor->m_renderedFrames != RENDERED;
     onFinishRender();
 }
 
-void CMonitorFrameScheduler::onPresented() {
+void CMonitorFrameScheduler::onPresented(const Time::steady_tp& when) {
+    m_lastPresented = when;
+
+    if (m_deadlineTarget != Time::steady_tp{}) {
+        // presented about a refresh after the vblank we aimed for: the estimate was too optimistic, render right away
+        // for a second to let it catch up. Anything much later means that render didn't present at all, so it tells nothing.
+        const float LATE = std::chrono::duration_cast<std::chrono::microseconds>(when - m_deadlineTarget).count() / 1000.F * m_monitor->m_refreshRate / 1000.F;
+        if (LATE > 0.5F && LATE < 1.5F) {
+            Debug::log(TRACE, "CMonitorFrameScheduler: {} -> onPresented, missed the render deadline", m_monitor->m_name);
+            m_deadline.misses++;
+            m_deadlineBackoff = std::max(1, sc<int>(m_monitor->m_refreshRate));
+        }
+
+        m_deadlineTarget = {};
+    }
+
     if (!newSchedulingEnabled())
         return;
 
@@ -93,10 +164,62 @@ void CMonitorFrameScheduler::onFrame() {
         m_monitor->m_tearingState.frameScheduledWhileBusy = false;
     }
 
+    if (deadlineEnabled()) {
+        if (m_deadlineTimer && m_deadlineTimer->armed())
+            return; // a held back render is already coming
+
+        if (m_deadlineBackoff > 0)
+            m_deadlineBackoff--;
+
+        m_deadline.delayMs = deadlineDelayMs();
+
+        if (m_deadline.delayMs > 0.F) {
+            if (!m_deadlineTimer) {
+                m_deadlineTimer = makeShared<CEventLoopTimer>(
+                    std::nullopt,
+                    [this, self = m_self](SP<CEventLoopTimer> timer, void* data) {
+                        if (!self || !canRender())
+                            return;
+
+                        renderFrame();
+                    },
+                    nullptr);
+                g_pEventLoopManager->addTimer(m_deadlineTimer);
+            }
+
+            Debug::log(TRACE, "CMonitorFrameScheduler: {} -> frame event, holding the render for {:.2f}ms", m_monitor->m_name, m_deadline.delayMs);
+
+            m_deadlineTarget = m_lastPresented + std::chrono::microseconds(sc<int64_t>(1000000.F / m_monitor->m_refreshRate));
+            m_deadlineTimer->updateTimeout(std::chrono::microseconds(sc<int64_t>(m_deadline.delayMs * 1000.F)));
+            return;
+        }
+    }
+
+    renderFrame();
+}
+
+void CMonitorFrameScheduler::renderFrame() {
     if (!newSchedulingEnabled()) {
         m_monitor->m_lastPresentationTimer.reset();
 
+        m_lastRenderBegun = hrc::now();
+
+        auto       self     = m_self;
+        const auto RENDERED = m_monitor->m_renderedFrames;
+
         g_pHyprRenderer->renderMonitor(m_monitor.lock());
+
+        // nothing to time if there was no damage or the frame got scanned out directly
+        if (!self || !deadlineEnabled() || m_monitor->m_renderedFrames == RENDERED)
+            return;
+
+        // without fences the cpu side is all we can measure
+        if (g_pHyprOpenGL->explicitSyncSupported()) {
+            m_sampleSync = true;
+            onFinishRender();
+        } else
+            addRenderTimeSample(msSince(m_lastRenderBegun));
+
         return;
     }
 
@@ -111,13 +234,15 @@ void CMonitorFrameScheduler::onFrame() {
 
     // get a ref to ourselves. renderMonitor can destroy this scheduler if it decides to perform a monitor reload
     // FIXME: this is horrible. "renderMonitor" should not be able to do that.
-    auto self = m_self;
+    auto       self     = m_self;
+    const auto RENDERED = m_monitor->m_renderedFrames;
 
     g_pHyprRenderer->renderMonitor(m_monitor.lock());
 
     if (!self)
         return;
 
+    m_sampleSync = m_monitor->m_renderedFrames != RENDERED;
     onFinishRender();
 }
 
@@ -1,16 +1,19 @@
 #pragma once
 
 #include "Monitor.hpp"
+#include "time/Time.hpp"
 
 #include <chrono>
 
 class CEGLSync;
+class CEventLoopTimer;
 
 class CMonitorFrameScheduler {
   public:
     using hrc = std::chrono::high_resolution_clock;
 
     CMonitorFrameScheduler(PHLMONITOR m);
+    ~CMonitorFrameScheduler();
 
     CMonitorFrameScheduler(const CMonitorFrameScheduler&)            = delete;
     CMonitorFrameScheduler(CMonitorFrameScheduler&&)                 = delete;
@@ -18,17 +21,35 @@ class CMonitorFrameScheduler {
     CMonitorFrameScheduler& operator=(CMonitorFrameScheduler&&)      = delete;
 
     void                    onSyncFired();
-    void                    onPresented();
+    void                    onPresented(const Time::steady_tp& when);
     void                    onFrame();
 
+    // render:render_deadline, shown in hyprctl monitors
+    struct SDeadlineStats {
+        float  estimateMs = 0.F; // moving estimate of cpu + gpu time per frame
+        float  delayMs    = 0.F; // how long the last render was held back after its frame event
+        size_t misses     = 0;   // delayed frames that got presented a refresh late
+    } m_deadline;
+
   private:
     bool                       canRender();
+    void                       renderFrame();
     void                       onFinishRender();
     bool                       newSchedulingEnabled();
+    bool                       deadlineEnabled();
+    void                       addRenderTimeSample(float ms);
+    // how long to hold back a render starting now, 0 means right away
+    float                      deadlineDelayMs();
 
     bool                       m_renderAtFrame = true;
     bool                       m_pendingThird  = false;
     hrc::time_point            m_lastRenderBegun;
+    Time::steady_tp            m_lastPresented; // as reported by the presentation feedback
+
+    SP<CEventLoopTimer>        m_deadlineTimer;
+    Time::steady_tp            m_deadlineTarget;          // vblank a held back render aims for, zero if none
+    int                        m_deadlineBackoff = 0;     // frames left to render right away after a miss
+    bool                       m_sampleSync      = false; // the render the pending sync belongs to drew a frame
 
     PHLMONITORREF              m_monitor;
 
@@ -0,0 +1,33 @@
+#include "RegexCache.hpp"
+#include <re2/re2.h>
+
+constexpr size_t REGEX_CACHE_CAPACITY = 256;
+
+SP<CRegexCache> regexCache() {
+    static SP<CRegexCache> cache = makeShared<CRegexCache>();
+    return cache;
+}
+
+CRegexCache::CRegexCache() : m_entries(REGEX_CACHE_CAPACITY) {
+    ;
+}
+
+SP<re2::RE2> CRegexCache::get(const std::string& pattern) {
+    if (const auto REGEX = m_entries.get(pattern)) {
+        m_hits++;
+        return *REGEX;
+    }
+
+    m_misses++;
+
+    return m_entries.insert(pattern, makeShared<re2::RE2>(pattern));
+}
+
+CRegexCache::SStats CRegexCache::stats() const {
+    return SStats{
+        .hits     = m_hits,
+        .misses   = m_misses,
+        .entries  = m_entries.size(),
+        .capacity = m_entries.capacity(),
+    };
+}
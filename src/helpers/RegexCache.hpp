@@ -0,0 +1,37 @@
+#pragma once
+
+#include <string>
+#include "LRUCache.hpp"
+#include "memory/Memory.hpp"
+
+//NOLINTNEXTLINE
+namespace re2 {
+    class RE2;
+};
+
+// Compiled regexes by pattern, so selectors and rules using the same pattern don't recompile it.
+// Holders keep their regex alive after it gets evicted.
+class CRegexCache {
+  public:
+    CRegexCache();
+
+    // never null, but check ok() if the pattern may be invalid
+    SP<re2::RE2> get(const std::string& pattern);
+
+    struct SStats {
+        size_t hits     = 0;
+        size_t misses   = 0;
+        size_t entries  = 0;
+        size_t capacity = 0;
+    };
+
+    SStats stats() const;
+
+  private:
+    CLRUCache<std::string, SP<re2::RE2>> m_entries;
+
+    size_t                               m_hits   = 0;
+    size_t                               m_misses = 0;
+};
+
+SP<CRegexCache> regexCache();
@@ -45,31 +45,86 @@ void SDwindleNodeData::recalcSizePosRecursive(bool force, bool horizontalOverrid
     }
 }
 
-int CHyprDwindleLayout::getNodesOnWorkspace(const WORKSPACEID& id) {
-    int no = 0;
-    for (auto const& n : m_dwindleNodesData) {
-        if (n.workspaceID == id && n.valid)
-            ++no;
+SDwindleNodeData* CHyprDwindleLayout::addNode(const WORKSPACEID& id) {
+    m_dwindleNodesData.emplace_back();
+
+    const auto PNODE   = &m_dwindleNodesData.back();
+    PNODE->workspaceID = id;
+    PNODE->layout      = this;
+
+    m_workspaceNodes[id].emplace_back(std::prev(m_dwindleNodesData.end()));
+
+    return PNODE;
+}
+
+void CHyprDwindleLayout::setNodeWindow(SDwindleNodeData* pNode, PHLWINDOW pWindow) {
+    // switchWindows hands windows between nodes, only drop the old key if it's still ours
+    if (const auto OLD = m_windowNodes.find(pNode->pWindow.lock().get()); OLD != m_windowNodes.end() && OLD->second == pNode)
+        m_windowNodes.erase(OLD);
+
+    pNode->pWindow = pWindow;
+
+    if (pWindow)
+        m_windowNodes[pWindow.get()] = pNode;
+}
+
+void CHyprDwindleLayout::removeNode(SDwindleNodeData* pNode) {
+    if (const auto PWINDOW = pNode->pWindow.lock(); PWINDOW) {
+        if (const auto IT = m_windowNodes.find(PWINDOW.get()); IT != m_windowNodes.end() && IT->second == pNode)
+            m_windowNodes.erase(IT);
+    } else if (!pNode->isNode) // window is already gone, can't look it up
+        std::erase_if(m_windowNodes, [pNode](const auto& e) { return e.second == pNode; });
+
+    const auto BUCKET = m_workspaceNodes.find(pNode->workspaceID);
+    if (BUCKET == m_workspaceNodes.end())
+        return;
+
+    auto& nodes = BUCKET->second;
+    for (auto it = nodes.begin(); it != nodes.end(); ++it) {
+        if (&**it != pNode)
+            continue;
+
+        m_dwindleNodesData.erase(*it);
+        nodes.erase(it);
+        break;
     }
-    return no;
+
+    if (nodes.empty())
+        m_workspaceNodes.erase(BUCKET);
+}
+
+int CHyprDwindleLayout::getNodesOnWorkspace(const WORKSPACEID& id) {
+    const auto BUCKET = m_workspaceNodes.find(id);
+    if (BUCKET == m_workspaceNodes.end())
+        return 0;
+
+    return sc<int>(std::ranges::count_if(BUCKET->second, [](const auto& n) { return n->valid; }));
 }
 
 SDwindleNodeData* CHyprDwindleLayout::getFirstNodeOnWorkspace(const WORKSPACEID& id) {
-    for (auto& n : m_dwindleNodesData) {
-        if (n.workspaceID == id && validMapped(n.pWindow))
-            return &n;
+    const auto BUCKET = m_workspaceNodes.find(id);
+    if (BUCKET == m_workspaceNodes.end())
+        return nullptr;
+
+    for (auto const& n : BUCKET->second) {
+        if (validMapped(n->pWindow))
+            return &*n;
     }
     return nullptr;
 }
 
 SDwindleNodeData* CHyprDwindleLayout::getClosestNodeOnWorkspace(const WORKSPACEID& id, const Vector2D& point) {
+    const auto BUCKET = m_workspaceNodes.find(id);
+    if (BUCKET == m_workspaceNodes.end())
+        return nullptr;
+
     SDwindleNodeData* res         = nullptr;
     double            distClosest = -1;
-    for (auto& n : m_dwindleNodesData) {
-        if (n.workspaceID == id && validMapped(n.pWindow)) {
-            auto distAnother = vecToRectDistanceSquared(point, n.box.pos(), n.box.pos() + n.box.size());
+    for (auto const& n : BUCKET->second) {
+        if (validMapped(n->pWindow)) {
+            auto distAnother = vecToRectDistanceSquared(point, n->box.pos(), n->box.pos() + n->box.size());
             if (!res || distAnother < distClosest) {
-                res         = &n;
+                res         = &*n;
                 distClosest = distAnother;
             }
         }
@@ -78,18 +133,22 @@ SDwindleNodeData* CHyprDwindleLayout::getClosestNodeOnWorkspace(const WORKSPACEI
 }
 
 SDwindleNodeData* CHyprDwindleLayout::getNodeFromWindow(PHLWINDOW pWindow) {
-    for (auto& n : m_dwindleNodesData) {
-        if (n.pWindow.lock() == pWindow && !n.isNode)
-            return &n;
-    }
+    if (!pWindow)
+        return nullptr;
 
-    return nullptr;
+    // the key is a raw pointer, make sure it's not a new window that reused a dead one's address
+    const auto IT = m_windowNodes.find(pWindow.get());
+    return IT == m_windowNodes.end() || IT->second->pWindow.lock() != pWindow ? nullptr : IT->second;
 }
 
 SDwindleNodeData* CHyprDwindleLayout::getMasterNodeOnWorkspace(const WORKSPACEID& id) {
-    for (auto& n : m_dwindleNodesData) {
-        if (!n.pParent && n.workspaceID == id)
-            return &n;
+    const auto BUCKET = m_workspaceNodes.find(id);
+    if (BUCKET == m_workspaceNodes.end())
+        return nullptr;
+
+    for (auto const& n : BUCKET->second) {
+        if (!n->pParent)
+            return &*n;
     }
     return nullptr;
 }
@@ -136,9 +195,6 @@ void CHyprDwindleLayout::applyNodeDataToWindow(SDwindleNodeData* pNode, bool for
     if (PWINDOW->isFullscreen() && !pNode->ignoreFullscreenChecks)
         return;
 
-    PWINDOW->m_ruleApplicator->resetProps(Desktop::Rule::RULE_PROP_ALL, Desktop::Types::PRIORITY_LAYOUT);
-    PWINDOW->updateWindowData();
-
     static auto PGAPSINDATA  = CConfigValue<Hyprlang::CUSTOMTYPE>("general:gaps_in");
     static auto PGAPSOUTDATA = CConfigValue<Hyprlang::CUSTOMTYPE>("general:gaps_out");
     auto* const PGAPSIN      = sc<CCssGapData*>((PGAPSINDATA.ptr())->getData());
@@ -146,7 +202,16 @@ void CHyprDwindleLayout::applyNodeDataToWindow(SDwindleNodeData* pNode, bool for
 
     auto        gapsIn  = WORKSPACERULE.gapsIn.value_or(*PGAPSIN);
     auto        gapsOut = WORKSPACERULE.gapsOut.value_or(*PGAPSOUT);
-    CBox        nodeBox = pNode->box;
+
+    // before the check below, rules and window data can change without the node moving
+    PWINDOW->m_ruleApplicator->resetProps(Desktop::Rule::RULE_PROP_ALL, Desktop::Types::PRIORITY_LAYOUT);
+    PWINDOW->updateWindowData();
+
+    // most recalcs only move a part of the tree, leave the windows of the rest alone
+    if (!tiledApplyNeeded(pNode->applied, PWINDOW, PMONITOR, pNode->box, gapsIn, gapsOut) && !force)
+        return;
+
+    CBox nodeBox = pNode->box;
     nodeBox.round();
 
     PWINDOW->m_size     = nodeBox.size();
@@ -255,6 +320,8 @@ void CHyprDwindleLayout::applyNodeDataToWindow(SDwindleNodeData* pNode, bool for
         *PWINDOW->m_realPosition = wb.pos();
     }
 
+    tiledApplied(pNode->applied, PWINDOW);
+
     if (force) {
         g_pHyprRenderer->damageWindow(PWINDOW);
 
@@ -271,9 +338,7 @@ void CHyprDwindleLayout::onWindowCreatedTiling(PHLWINDOW pWindow, eDirection dir
     if (pWindow->m_isFloating)
         return;
 
-    m_dwindleNodesData.emplace_back();
-    const auto  PNODE = &m_dwindleNodesData.back();
-
+    const auto  PNODE    = addNode(pWindow->workspaceID());
     const auto  PMONITOR = pWindow->m_monitor.lock();
 
     static auto PUSEACTIVE    = CConfigValue<Hyprlang::INT>("dwindle:use_active_for_splits");
@@ -283,10 +348,7 @@ void CHyprDwindleLayout::onWindowCreatedTiling(PHLWINDOW pWindow, eDirection dir
         m_overrideDirection = direction;
 
     // Populate the node with our window's data
-    PNODE->workspaceID = pWindow->workspaceID();
-    PNODE->pWindow     = pWindow;
-    PNODE->isNode      = false;
-    PNODE->layout      = this;
+    setNodeWindow(PNODE, pWindow);
 
     SDwindleNodeData* OPENINGON;
 
@@ -326,16 +388,16 @@ void CHyprDwindleLayout::onWindowCreatedTiling(PHLWINDOW pWindow, eDirection dir
     if (const auto MAXSIZE = pWindow->requestedMaxSize(); MAXSIZE.x < PREDSIZEMAX.x || MAXSIZE.y < PREDSIZEMAX.y) {
         // we can't continue. make it floating.
         pWindow->m_isFloating = true;
-        m_dwindleNodesData.remove(*PNODE);
+        removeNode(PNODE);
         g_pLayoutManager->getCurrentLayout()->onWindowCreatedFloating(pWindow);
         return;
     }
 
     // last fail-safe to avoid duplicate fullscreens
     if ((!OPENINGON || OPENINGON->pWindow.lock() == pWindow) && getNodesOnWorkspace(PNODE->workspaceID) > 1) {
-        for (auto& node : m_dwindleNodesData) {
-            if (node.workspaceID == PNODE->workspaceID && node.pWindow.lock() && node.pWindow.lock() != pWindow) {
-                OPENINGON = &node;
+        for (auto const& node : m_workspaceNodes[PNODE->workspaceID]) {
+            if (node->pWindow.lock() && node->pWindow.lock() != pWindow) {
+                OPENINGON = &*node;
                 break;
             }
         }
@@ -352,15 +414,13 @@ void CHyprDwindleLayout::onWindowCreatedTiling(PHLWINDOW pWindow, eDirection dir
 
     // get the node under our cursor
 
-    m_dwindleNodesData.emplace_back();
-    const auto NEWPARENT = &m_dwindleNodesData.back();
+    const auto NEWPARENT = addNode(OPENINGON->workspaceID);
 
     // make the parent have the OPENINGON's stats
-    NEWPARENT->box         = OPENINGON->box;
-    NEWPARENT->workspaceID = OPENINGON->workspaceID;
-    NEWPARENT->pParent     = OPENINGON->pParent;
-    NEWPARENT->isNode      = true; // it is a node
-    NEWPARENT->splitRatio  = std::clamp(*PDEFAULTSPLIT, 0.1f, 1.9f);
+    NEWPARENT->box        = OPENINGON->box;
+    NEWPARENT->pParent    = OPENINGON->pParent;
+    NEWPARENT->isNode     = true; // it is a node
+    NEWPARENT->splitRatio = std::clamp(*PDEFAULTSPLIT, 0.1f, 1.9f);
 
     static auto PWIDTHMULTIPLIER = CConfigValue<Hyprlang::FLOAT>("dwindle:split_width_multiplier");
 
@@ -503,7 +563,7 @@ void CHyprDwindleLayout::onWindowRemovedTiling(PHLWINDOW pWindow) {
 
     if (!PPARENT) {
         Debug::log(LOG, "Removing last node (dwindle)");
-        m_dwindleNodesData.remove(*PNODE);
+        removeNode(PNODE);
         return;
     }
 
@@ -528,8 +588,8 @@ void CHyprDwindleLayout::onWindowRemovedTiling(PHLWINDOW pWindow) {
     else
         PSIBLING->recalcSizePosRecursive();
 
-    m_dwindleNodesData.remove(*PPARENT);
-    m_dwindleNodesData.remove(*PNODE);
+    removeNode(PPARENT);
+    removeNode(PNODE);
     pWindow->m_workspace->updateWindows();
 }
 
@@ -539,7 +599,8 @@ void CHyprDwindleLayout::recalculateMonitor(const MONITORID& monid) {
     if (!PMONITOR || !PMONITOR->m_activeWorkspace)
         return; // ???
 
-    g_pHyprRenderer->damageMonitor(PMONITOR);
+    // windows that move damage their own old and new boxes
+    damageMonitorIfChanged(PMONITOR);
 
     if (PMONITOR->m_activeSpecialWorkspace)
         calculateWorkspace(PMONITOR->m_activeSpecialWorkspace);
@@ -854,6 +915,8 @@ void CHyprDwindleLayout::recalculateWindow(PHLWINDOW pWindow) {
     if (!PNODE)
         return;
 
+    // something about the window itself changed, place it even if its node didn't move
+    PNODE->applied = {};
     PNODE->recalcSizePosRecursive();
 }
 
@@ -946,8 +1009,8 @@ void CHyprDwindleLayout::switchWindows(PHLWINDOW pWindow, PHLWINDOW pWindow2) {
     SDwindleNodeData* ACTIVE2 = nullptr;
 
     // swap the windows and recalc
-    PNODE2->pWindow = pWindow;
-    PNODE->pWindow  = pWindow2;
+    setNodeWindow(PNODE2, pWindow);
+    setNodeWindow(PNODE, pWindow2);
 
     if (PNODE->workspaceID != PNODE2->workspaceID) {
         std::swap(pWindow2->m_monitor, pWindow->m_monitor);
@@ -1117,7 +1180,7 @@ void CHyprDwindleLayout::replaceWindowDataWith(PHLWINDOW from, PHLWINDOW to) {
     if (!PNODE)
         return;
 
-    PNODE->pWindow = to;
+    setNodeWindow(PNODE, to);
 
     applyNodeDataToWindow(PNODE, true);
 }
@@ -1136,6 +1199,8 @@ void CHyprDwindleLayout::onEnable() {
 }
 
 void CHyprDwindleLayout::onDisable() {
+    m_windowNodes.clear();
+    m_workspaceNodes.clear();
     m_dwindleNodesData.clear();
 }
 
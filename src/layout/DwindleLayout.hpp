@@ -5,6 +5,7 @@
 
 #include <list>
 #include <vector>
+#include <unordered_map>
 #include <array>
 #include <optional>
 #include <format>
@@ -32,6 +33,8 @@ struct SDwindleNodeData {
 
     bool                             ignoreFullscreenChecks = false;
 
+    STiledApplyState                 applied; // leaves only
+
     // For list lookup
     bool operator==(const SDwindleNodeData& rhs) const {
         return pWindow.lock() == rhs.pWindow.lock() && workspaceID == rhs.workspaceID && box == rhs.box && pParent == rhs.pParent && children[0] == rhs.children[0] &&
@@ -67,6 +70,10 @@ class CHyprDwindleLayout : public IHyprLayout {
   private:
     std::list<SDwindleNodeData> m_dwindleNodesData;
 
+    // lookup indices over m_dwindleNodesData, kept in sync by addNode / setNodeWindow / removeNode
+    std::unordered_map<const CWindow*, SDwindleNodeData*>                               m_windowNodes;    // leaves only
+    std::unordered_map<WORKSPACEID, std::vector<std::list<SDwindleNodeData>::iterator>> m_workspaceNodes; // in creation order
+
     struct {
         bool started = false;
         bool pseudo  = false;
@@ -84,6 +91,10 @@ class CHyprDwindleLayout : public IHyprLayout {
     SDwindleNodeData*       getClosestNodeOnWorkspace(const WORKSPACEID&, const Vector2D&);
     SDwindleNodeData*       getMasterNodeOnWorkspace(const WORKSPACEID&);
 
+    SDwindleNodeData*       addNode(const WORKSPACEID&);
+    void                    setNodeWindow(SDwindleNodeData*, PHLWINDOW);
+    void                    removeNode(SDwindleNodeData*);
+
     void                    toggleSplit(PHLWINDOW);
     void                    swapSplit(PHLWINDOW);
     void                    moveToRoot(PHLWINDOW, bool stable = true);
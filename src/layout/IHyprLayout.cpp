@@ -1039,3 +1039,73 @@ bool IHyprLayout::updateDragWindow() {
 
     return false;
 }
+
+void IHyprLayout::invalidateTiledState() {
+    m_tiledEpoch++;
+}
+
+bool IHyprLayout::tiledApplyNeeded(STiledApplyState& state, PHLWINDOW pWindow, PHLMONITOR pMonitor, const CBox& nodeBox, const CCssGapData& gapsIn, const CCssGapData& gapsOut) {
+    STiledApplyState next = {
+        .window     = pWindow,
+        .epoch      = m_tiledEpoch,
+        .nodeBox    = nodeBox,
+        .monitorBox = {pMonitor->m_position, pMonitor->m_size},
+        .workArea   = {pMonitor->m_position + pMonitor->m_reservedTopLeft, pMonitor->m_size - pMonitor->m_reservedTopLeft - pMonitor->m_reservedBottomRight},
+        .gaps       = {gapsIn.m_top, gapsIn.m_right, gapsIn.m_bottom, gapsIn.m_left, gapsOut.m_top, gapsOut.m_right, gapsOut.m_bottom, gapsOut.m_left},
+        .reserved   = pWindow->getFullWindowReservedArea(),
+        .pseudoSize = pWindow->m_pseudoSize,
+        .minSize    = pWindow->m_ruleApplicator->minSize().valueOr(Vector2D{}),
+        .maxSize    = pWindow->m_ruleApplicator->maxSize().valueOr(Vector2D{}),
+        .borderSize = pWindow->getRealBorderSize(),
+        .pseudo     = pWindow->m_isPseudotiled,
+        .fullscreen = pWindow->isFullscreen(),
+        .special    = pWindow->onSpecialWorkspace(),
+        .goalPos    = state.goalPos,
+        .goalSize   = state.goalSize,
+    };
+
+    const bool NEEDED = next != state || pWindow->m_realPosition->goal() != state.goalPos || pWindow->m_realSize->goal() != state.goalSize;
+
+    state = next;
+
+    return NEEDED;
+}
+
+void IHyprLayout::tiledApplied(STiledApplyState& state, PHLWINDOW pWindow) {
+    const bool MOVED = pWindow->m_realPosition->goal() != state.goalPos || pWindow->m_realSize->goal() != state.goalSize;
+
+    state.goalPos  = pWindow->m_realPosition->goal();
+    state.goalSize = pWindow->m_realSize->goal();
+
+    if (!MOVED)
+        return;
+
+    // the animation damages every step in between
+    g_pHyprRenderer->damageWindow(pWindow);
+    g_pHyprRenderer->damageBox(CBox{state.goalPos, state.goalSize}.addExtents(pWindow->getFullWindowExtents()));
+}
+
+bool IHyprLayout::damageMonitorIfChanged(PHLMONITOR pMonitor) {
+    const auto    PACTIVE  = pMonitor->m_activeWorkspace;
+    const auto    PSPECIAL = pMonitor->m_activeSpecialWorkspace;
+
+    SMonitorState state = {
+        .box                   = {pMonitor->m_position, pMonitor->m_size},
+        .workArea              = {pMonitor->m_position + pMonitor->m_reservedTopLeft, pMonitor->m_size - pMonitor->m_reservedTopLeft - pMonitor->m_reservedBottomRight},
+        .activeWorkspace       = pMonitor->activeWorkspaceID(),
+        .specialWorkspace      = pMonitor->activeSpecialWorkspaceID(),
+        .fullscreenMode        = PACTIVE && PACTIVE->m_hasFullscreenWindow ? sc<int8_t>(PACTIVE->m_fullscreenMode) : sc<int8_t>(-1),
+        .specialFullscreenMode = PSPECIAL && PSPECIAL->m_hasFullscreenWindow ? sc<int8_t>(PSPECIAL->m_fullscreenMode) : sc<int8_t>(-1),
+    };
+
+    // drop monitors that are gone
+    std::erase_if(m_monitorStates, [](const auto& e) { return !g_pCompositor->getMonitorFromID(e.first); });
+
+    auto& last = m_monitorStates[pMonitor->m_id];
+    if (last == state)
+        return false;
+
+    last = state;
+    g_pHyprRenderer->damageMonitor(pMonitor);
+    return true;
+}
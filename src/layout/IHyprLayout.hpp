@@ -3,9 +3,12 @@
 #include "../defines.hpp"
 #include "../managers/input/InputManager.hpp"
 #include <any>
+#include <array>
+#include <unordered_map>
 
 class CWindow;
 class CGradientValueData;
+class CCssGapData;
 
 struct SWindowRenderLayoutHints {
     bool                isBorderGradient = false;
@@ -50,6 +53,38 @@ enum eDirection : int8_t {
     DIRECTION_LEFT
 };
 
+/*
+    Where a layout node last placed a tiled window, and everything that placement was derived from.
+    If none of it changed, applying the node again would be a no-op.
+*/
+struct STiledApplyState {
+    PHLWINDOWREF           window;
+    uint64_t               epoch = 0;
+    CBox                   nodeBox;
+    CBox                   monitorBox;
+    CBox                   workArea;
+    std::array<int64_t, 8> gaps = {}; // in, then out. top, right, bottom, left
+    SBoxExtents            reserved;
+    Vector2D               pseudoSize;
+    Vector2D               minSize;
+    Vector2D               maxSize;
+    int                    borderSize = 0;
+    bool                   pseudo     = false;
+    bool                   fullscreen = false;
+    bool                   special    = false;
+
+    // the goals we set, so a window moved by someone else gets placed again
+    Vector2D goalPos;
+    Vector2D goalSize;
+
+    //
+    bool operator==(const STiledApplyState& rhs) const {
+        return window.lock() == rhs.window.lock() && epoch == rhs.epoch && nodeBox == rhs.nodeBox && monitorBox == rhs.monitorBox && workArea == rhs.workArea &&
+            gaps == rhs.gaps && reserved == rhs.reserved && pseudoSize == rhs.pseudoSize && minSize == rhs.minSize && maxSize == rhs.maxSize &&
+            borderSize == rhs.borderSize && pseudo == rhs.pseudo && fullscreen == rhs.fullscreen && special == rhs.special && goalPos == rhs.goalPos && goalSize == rhs.goalSize;
+    }
+};
+
 class IHyprLayout {
   public:
     virtual ~IHyprLayout()   = default;
@@ -230,6 +265,31 @@ class IHyprLayout {
     */
     virtual void fitFloatingWindowOnMonitor(PHLWINDOW w, std::optional<CBox> targetBox = std::nullopt);
 
+    /*
+        Forgets where tiled windows were last placed, so the next recalculation
+        applies every node again. Called when the config changes.
+    */
+    void invalidateTiledState();
+
+  protected:
+    /*
+        Fills state with what placing pWindow into nodeBox depends on.
+        Returns false if that's what the window was last placed from and its goals are still ours,
+        i.e. applying the node would change nothing.
+    */
+    bool tiledApplyNeeded(STiledApplyState& state, PHLWINDOW pWindow, PHLMONITOR pMonitor, const CBox& nodeBox, const CCssGapData& gapsIn, const CCssGapData& gapsOut);
+
+    /*
+        Call after setting the goals of pWindow. Damages where it is and where it's headed, if it moved.
+    */
+    void tiledApplied(STiledApplyState& state, PHLWINDOW pWindow);
+
+    /*
+        Returns true, and damages the monitor, if its area, reserved area, workspaces or fullscreen state
+        changed since the last call. Otherwise a recalculation only needs the damage of the windows it moves.
+    */
+    bool damageMonitorIfChanged(PHLMONITOR pMonitor);
+
   private:
     int          m_mouseMoveEventCount;
     Vector2D     m_beginDragXY;
@@ -240,4 +300,19 @@ class IHyprLayout {
     eRectCorner  m_grabbedCorner = CORNER_TOPLEFT;
 
     PHLWINDOWREF m_lastTiledWindow;
+
+    struct SMonitorState {
+        CBox        box;
+        CBox        workArea;
+        WORKSPACEID activeWorkspace       = WORKSPACE_INVALID;
+        WORKSPACEID specialWorkspace      = WORKSPACE_INVALID;
+        int8_t      fullscreenMode        = -1; // -1 for no fullscreen window
+        int8_t      specialFullscreenMode = -1;
+
+        //
+        bool operator==(const SMonitorState&) const = default;
+    };
+
+    std::unordered_map<MONITORID, SMonitorState> m_monitorStates;
+    uint64_t                                     m_tiledEpoch = 1;
 };
@@ -13,12 +13,33 @@
 #include "xwayland/XWayland.hpp"
 
 SMasterNodeData* CHyprMasterLayout::getNodeFromWindow(PHLWINDOW pWindow) {
-    for (auto& nd : m_masterNodesData) {
-        if (nd.pWindow.lock() == pWindow)
-            return &nd;
-    }
+    if (!pWindow)
+        return nullptr;
 
-    return nullptr;
+    // the key is a raw pointer, make sure it's not a new window that reused a dead one's address
+    const auto IT = m_windowNodes.find(pWindow.get());
+    return IT == m_windowNodes.end() || IT->second->pWindow.lock() != pWindow ? nullptr : IT->second;
+}
+
+void CHyprMasterLayout::setNodeWindow(SMasterNodeData* pNode, PHLWINDOW pWindow) {
+    // switchWindows hands windows between nodes, only drop the old key if it's still ours
+    if (const auto OLD = m_windowNodes.find(pNode->pWindow.lock().get()); OLD != m_windowNodes.end() && OLD->second == pNode)
+        m_windowNodes.erase(OLD);
+
+    pNode->pWindow = pWindow;
+
+    if (pWindow)
+        m_windowNodes[pWindow.get()] = pNode;
+}
+
+void CHyprMasterLayout::removeNode(SMasterNodeData* pNode) {
+    if (const auto PWINDOW = pNode->pWindow.lock(); PWINDOW) {
+        if (const auto IT = m_windowNodes.find(PWINDOW.get()); IT != m_windowNodes.end() && IT->second == pNode)
+            m_windowNodes.erase(IT);
+    } else // window is already gone, can't look it up
+        std::erase_if(m_windowNodes, [pNode](const auto& e) { return e.second == pNode; });
+
+    m_masterNodesData.remove_if([pNode](const auto& n) { return &n == pNode; });
 }
 
 int CHyprMasterLayout::getNodesOnWorkspace(const WORKSPACEID& ws) {
@@ -106,7 +127,7 @@ void CHyprMasterLayout::onWindowCreatedTiling(PHLWINDOW pWindow, eDirection dire
     }();
 
     PNODE->workspaceID = pWindow->workspaceID();
-    PNODE->pWindow     = pWindow;
+    setNodeWindow(PNODE, pWindow);
 
     const auto   WINDOWSONWORKSPACE = getNodesOnWorkspace(PNODE->workspaceID);
     static auto  PMFACT             = CConfigValue<Hyprlang::FLOAT>("master:mfact");
@@ -210,7 +231,7 @@ void CHyprMasterLayout::onWindowCreatedTiling(PHLWINDOW pWindow, eDirection dire
         if (const auto MAXSIZE = pWindow->requestedMaxSize(); MAXSIZE.x < PMONITOR->m_size.x * lastSplitPercent || MAXSIZE.y < PMONITOR->m_size.y) {
             // we can't continue. make it floating.
             pWindow->m_isFloating = true;
-            m_masterNodesData.remove(*PNODE);
+            removeNode(PNODE);
             g_pLayoutManager->getCurrentLayout()->onWindowCreatedFloating(pWindow);
             return;
         }
@@ -223,7 +244,7 @@ void CHyprMasterLayout::onWindowCreatedTiling(PHLWINDOW pWindow, eDirection dire
             MAXSIZE.x < PMONITOR->m_size.x * (1 - lastSplitPercent) || MAXSIZE.y < PMONITOR->m_size.y * (1.f / (WINDOWSONWORKSPACE - 1))) {
             // we can't continue. make it floating.
             pWindow->m_isFloating = true;
-            m_masterNodesData.remove(*PNODE);
+            removeNode(PNODE);
             g_pLayoutManager->getCurrentLayout()->onWindowCreatedFloating(pWindow);
             return;
         }
@@ -261,7 +282,7 @@ void CHyprMasterLayout::onWindowRemovedTiling(PHLWINDOW pWindow) {
         }
     }
 
-    m_masterNodesData.remove(*PNODE);
+    removeNode(PNODE);
 
     if (getMastersOnWorkspace(WORKSPACEID) == getNodesOnWorkspace(WORKSPACEID) && MASTERSLEFT > 1) {
         for (auto& nd : m_masterNodesData | std::views::reverse) {
@@ -291,7 +312,8 @@ void CHyprMasterLayout::recalculateMonitor(const MONITORID& monid) {
     if (!PMONITOR || !PMONITOR->m_activeWorkspace)
         return;
 
-    g_pHyprRenderer->damageMonitor(PMONITOR);
+    // windows that move damage their own old and new boxes
+    damageMonitorIfChanged(PMONITOR);
 
     if (PMONITOR->m_activeSpecialWorkspace)
         calculateWorkspace(PMONITOR->m_activeSpecialWorkspace);
@@ -666,9 +688,6 @@ void CHyprMasterLayout::applyNodeDataToWindow(SMasterNodeData* pNode) {
     if (PWINDOW->isFullscreen() && !pNode->ignoreFullscreenChecks)
         return;
 
-    PWINDOW->m_ruleApplicator->resetProps(Desktop::Rule::RULE_PROP_ALL, Desktop::Types::PRIORITY_LAYOUT);
-    PWINDOW->updateWindowData();
-
     static auto PANIMATE     = CConfigValue<Hyprlang::INT>("misc:animate_manual_resizes");
     static auto PGAPSINDATA  = CConfigValue<Hyprlang::CUSTOMTYPE>("general:gaps_in");
     static auto PGAPSOUTDATA = CConfigValue<Hyprlang::CUSTOMTYPE>("general:gaps_out");
@@ -683,6 +702,16 @@ void CHyprMasterLayout::applyNodeDataToWindow(SMasterNodeData* pNode) {
         return;
     }
 
+    const bool FORCE = m_forceWarps && !*PANIMATE;
+
+    // before the check below, rules and window data can change without the node moving
+    PWINDOW->m_ruleApplicator->resetProps(Desktop::Rule::RULE_PROP_ALL, Desktop::Types::PRIORITY_LAYOUT);
+    PWINDOW->updateWindowData();
+
+    // adding or removing a stack window leaves the master alone, and the other way around
+    if (!tiledApplyNeeded(pNode->applied, PWINDOW, PMONITOR, {pNode->position, pNode->size}, gapsIn, gapsOut) && !FORCE)
+        return;
+
     PWINDOW->m_size     = pNode->size;
     PWINDOW->m_position = pNode->position;
 
@@ -740,7 +769,9 @@ void CHyprMasterLayout::applyNodeDataToWindow(SMasterNodeData* pNode) {
         *PWINDOW->m_realSize     = wb.size();
     }
 
-    if (m_forceWarps && !*PANIMATE) {
+    tiledApplied(pNode->applied, PWINDOW);
+
+    if (FORCE) {
         g_pHyprRenderer->damageWindow(PWINDOW);
 
         PWINDOW->m_realPosition->warp();
@@ -957,6 +988,8 @@ void CHyprMasterLayout::recalculateWindow(PHLWINDOW pWindow) {
     if (!PNODE)
         return;
 
+    // something about the window itself changed, place it even if its node didn't move
+    PNODE->applied = {};
     recalculateMonitor(pWindow->monitorID());
 }
 
@@ -1021,8 +1054,8 @@ void CHyprMasterLayout::switchWindows(PHLWINDOW pWindow, PHLWINDOW pWindow2) {
     }
 
     // massive hack: just swap window pointers, lol
-    PNODE->pWindow  = pWindow2;
-    PNODE2->pWindow = pWindow;
+    setNodeWindow(PNODE, pWindow2);
+    setNodeWindow(PNODE2, pWindow);
 
     pWindow->setAnimationsToMove();
     pWindow2->setAnimationsToMove();
@@ -1481,7 +1514,7 @@ void CHyprMasterLayout::replaceWindowDataWith(PHLWINDOW from, PHLWINDOW to) {
     if (!PNODE)
         return;
 
-    PNODE->pWindow = to;
+    setNodeWindow(PNODE, to);
 
     applyNodeDataToWindow(PNODE);
 }
@@ -1523,5 +1556,6 @@ void CHyprMasterLayout::onEnable() {
 }
 
 void CHyprMasterLayout::onDisable() {
+    m_windowNodes.clear();
     m_masterNodesData.clear();
 }
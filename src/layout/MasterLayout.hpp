@@ -5,6 +5,7 @@
 #include "../helpers/varlist/VarList.hpp"
 #include <vector>
 #include <list>
+#include <unordered_map>
 #include <any>
 
 enum eFullscreenMode : int8_t;
@@ -33,6 +34,9 @@ struct SMasterNodeData {
 
     bool         ignoreFullscreenChecks = false;
 
+    // what the window was last placed from
+    STiledApplyState applied;
+
     //
     bool operator==(const SMasterNodeData& rhs) const {
         return pWindow.lock() == rhs.pWindow.lock();
@@ -90,6 +94,11 @@ class CHyprMasterLayout : public IHyprLayout {
     void                              calculateWorkspace(PHLWORKSPACE);
     PHLWINDOW                         getNextWindow(PHLWINDOW, bool, bool);
     int                               getMastersOnWorkspace(const WORKSPACEID&);
+    void                              setNodeWindow(SMasterNodeData*, PHLWINDOW);
+    void                              removeNode(SMasterNodeData*);
+
+    // window -> node over m_masterNodesData, kept in sync by setNodeWindow / removeNode
+    std::unordered_map<const CWindow*, SMasterNodeData*> m_windowNodes;
 
     friend struct SMasterNodeData;
     friend struct SMasterWorkspaceData;
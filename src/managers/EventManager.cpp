@@ -1,15 +1,20 @@
 #include "EventManager.hpp"
 #include "../Compositor.hpp"
+#include "../config/ConfigValue.hpp"
 
 #include <algorithm>
+#include <array>
 #include <netinet/in.h>
 #include <sys/socket.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <sys/un.h>
+#include <sys/uio.h>
 #include <unistd.h>
 #include <cstring>
+#include <hyprutils/string/VarList.hpp>
 using namespace Hyprutils::OS;
+using namespace Hyprutils::String;
 
 CEventManager::CEventManager() : m_socketFD(socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC | SOCK_NONBLOCK, 0)) {
     if (!m_socketFD.isValid()) {
@@ -85,11 +90,11 @@ int CEventManager::onServerEvent(int fd, uint32_t mask) {
     Debug::log(LOG, "Socket2 accepted a new client at FD {}", ACCEPTEDCONNECTION.get());
 
     // add to event loop so we can close it when we need to
-    auto* eventSource = wl_event_loop_add_fd(g_pCompositor->m_wlEventLoop, ACCEPTEDCONNECTION.get(), 0, onServerEvent, nullptr);
+    auto* eventSource = wl_event_loop_add_fd(g_pCompositor->m_wlEventLoop, ACCEPTEDCONNECTION.get(), WL_EVENT_READABLE, onServerEvent, nullptr);
     m_clients.emplace_back(SClient{
-        std::move(ACCEPTEDCONNECTION),
-        {},
-        eventSource,
+        .fd          = std::move(ACCEPTEDCONNECTION),
+        .eventSource = eventSource,
+        .nextEvent   = m_firstEvent + m_events.size(),
     });
 
     return 0;
@@ -99,27 +104,239 @@ int CEventManager::onClientEvent(int fd, uint32_t mask) {
     if (mask & WL_EVENT_ERROR || mask & WL_EVENT_HANGUP) {
         Debug::log(LOG, "Socket2 fd {} hung up", fd);
         removeClientByFD(fd);
+        trimEvents();
         return 0;
     }
 
+    const auto CLIENTIT = findClientByFD(fd);
+    if (CLIENTIT == m_clients.end())
+        return 0;
+
+    if (mask & WL_EVENT_READABLE) {
+        if (!readClient(*CLIENTIT)) {
+            Debug::log(LOG, "Socket2 fd {} broke while reading", fd);
+            removeClientByFD(fd);
+            trimEvents();
+            return 0;
+        }
+    }
+
     if (mask & WL_EVENT_WRITABLE) {
-        const auto CLIENTIT = findClientByFD(fd);
+        if (!flushClient(*CLIENTIT)) {
+            Debug::log(LOG, "Socket2 fd {} broke while writing", fd);
+            removeClientByFD(fd);
+        } else
+            updateClientPolling(*CLIENTIT, true);
+
+        trimEvents();
+    }
+
+    return 0;
+}
+
+bool CEventManager::readClient(SClient& client) {
+    constexpr size_t MAX_REQUEST_SIZE = 4096;
+
+    char             buf[1024];
+
+    while (client.readBuffer.size() <= MAX_REQUEST_SIZE) {
+        const auto SIZE = read(client.fd.get(), buf, sizeof(buf));
+
+        if (SIZE == 0) {
+            // half-closed (e.g. socat -u), it's done talking but still listening. A client that's gone entirely hangs up instead.
+            client.readClosed = true;
+            wl_event_source_fd_update(client.eventSource, client.pendingBytes > 0 ? WL_EVENT_WRITABLE : 0);
+            break;
+        }
+
+        if (SIZE < 0) {
+            if (errno == EINTR)
+                continue;
+
+            if (errno != EAGAIN && errno != EWOULDBLOCK)
+                return false;
+
+            break;
+        }
+
+        client.readBuffer.append(buf, SIZE);
+    }
+
+    for (size_t end = client.readBuffer.find('\n'); end != std::string::npos; end = client.readBuffer.find('\n')) {
+        const std::string_view LINE = std::string_view{client.readBuffer}.substr(0, end);
+
+        if (LINE.starts_with("subscribe "))
+            subscribeClient(client, LINE.substr(10));
+        else if (!LINE.empty())
+            Debug::log(WARN, "Socket2 fd {} sent an unknown request: {}", client.fd.get(), LINE);
 
-        // send all queued events
-        while (!CLIENTIT->events.empty()) {
-            const auto& event = CLIENTIT->events.front();
-            if (write(CLIENTIT->fd.get(), event->c_str(), event->length()) < 0)
+        client.readBuffer.erase(0, end + 1);
+    }
+
+    if (client.readBuffer.size() > MAX_REQUEST_SIZE) {
+        Debug::log(ERR, "Socket2 fd {} sent an overlong request", client.fd.get());
+        return false;
+    }
+
+    return true;
+}
+
+void CEventManager::subscribeClient(SClient& client, std::string_view list) {
+    std::string names{list};
+    std::ranges::replace(names, ',', ' ');
+
+    client.filtered = true;
+
+    for (const auto& name : CVarList(names, 0, 's', true)) {
+        if (name.ends_with('*')) {
+            // prefix, matches every event type starting with it, including ones we haven't seen yet
+            const auto PREFIX = name.substr(0, name.length() - 1);
+            for (const auto& [type, id] : m_eventTypes) {
+                if (type.starts_with(PREFIX))
+                    setSubscribed(client, id);
+            }
+
+            client.prefixes.emplace_back(PREFIX);
+        } else
+            setSubscribed(client, eventType(name));
+    }
+
+    // events already queued for this client might not be wanted anymore
+    const bool HADBACKLOG = client.pendingBytes > 0;
+    client.pendingBytes   = 0;
+    for (uint64_t seq = client.nextEvent; seq < m_firstEvent + m_events.size(); ++seq) {
+        const auto& EVENT = m_events[seq - m_firstEvent];
+        if (seq == client.nextEvent && client.offset > 0)
+            client.pendingBytes += EVENT.data.size() - client.offset;
+        else if (wantsEvent(client, EVENT.type))
+            client.pendingBytes += EVENT.data.size();
+    }
+
+    updateClientPolling(client, HADBACKLOG);
+
+    Debug::log(LOG, "Socket2 fd {} subscribed to {}", client.fd.get(), list);
+}
+
+size_t CEventManager::eventType(const std::string& name) {
+    if (const auto IT = m_eventTypes.find(name); IT != m_eventTypes.end())
+        return IT->second;
+
+    const auto TYPE = m_eventTypes.size();
+    m_eventTypes.emplace(name, TYPE);
+
+    // a new kind of event, check whether anyone subscribed to it by prefix
+    for (auto& client : m_clients) {
+        if (std::ranges::any_of(client.prefixes, [&name](const auto& prefix) { return name.starts_with(prefix); }))
+            setSubscribed(client, TYPE);
+    }
+
+    return TYPE;
+}
+
+void CEventManager::setSubscribed(SClient& client, size_t type) {
+    if (client.subscribed.size() <= type)
+        client.subscribed.resize(type + 1, false);
+
+    client.subscribed[type] = true;
+}
+
+bool CEventManager::wantsEvent(const SClient& client, size_t type) const {
+    // clients that never subscribed to anything get everything
+    if (!client.filtered)
+        return true;
+
+    return type < client.subscribed.size() && client.subscribed[type];
+}
+
+void CEventManager::skipUnwanted(SClient& client) const {
+    const uint64_t END = m_firstEvent + m_events.size();
+
+    // a partially written event has to be finished, whatever the subscription says
+    while (client.nextEvent < END && client.offset == 0 && !wantsEvent(client, m_events[client.nextEvent - m_firstEvent].type)) {
+        client.nextEvent++;
+    }
+}
+
+bool CEventManager::flushClient(SClient& client) {
+    constexpr size_t            MAX_IOVS = 64;
+    std::array<iovec, MAX_IOVS> iovs;
+
+    const uint64_t              END = m_firstEvent + m_events.size();
+
+    while (true) {
+        skipUnwanted(client);
+
+        if (client.nextEvent >= END)
+            break;
+
+        // batch as many pending events as we can into one syscall
+        size_t count = 0, total = 0;
+        for (uint64_t seq = client.nextEvent; seq < END && count < MAX_IOVS; ++seq) {
+            const auto& EVENT = m_events[seq - m_firstEvent];
+            if (seq != client.nextEvent && !wantsEvent(client, EVENT.type))
+                continue;
+
+            const size_t SKIP = seq == client.nextEvent ? client.offset : 0;
+            iovs[count]       = iovec{.iov_base = const_cast<char*>(EVENT.data.data()) + SKIP, .iov_len = EVENT.data.size() - SKIP};
+            total += iovs[count].iov_len;
+            count++;
+        }
+
+        const auto WRITTEN = writev(client.fd.get(), iovs.data(), count);
+
+        if (WRITTEN < 0) {
+            if (errno == EINTR)
+                continue;
+
+            return errno == EAGAIN || errno == EWOULDBLOCK;
+        }
+
+        client.pendingBytes -= WRITTEN;
+
+        // advance the cursor over what was written
+        size_t left = WRITTEN;
+        while (left > 0) {
+            skipUnwanted(client);
+
+            const size_t REMAINING = m_events[client.nextEvent - m_firstEvent].data.size() - client.offset;
+            if (left < REMAINING) {
+                client.offset += left;
                 break;
+            }
 
-            CLIENTIT->events.erase(CLIENTIT->events.begin());
+            left -= REMAINING;
+            client.offset = 0;
+            client.nextEvent++;
         }
 
-        // stop polling when we sent all events
-        if (CLIENTIT->events.empty())
-            wl_event_source_fd_update(CLIENTIT->eventSource, 0);
+        // socket is full, wait for it to become writable again
+        if (sc<size_t>(WRITTEN) < total)
+            break;
     }
 
-    return 0;
+    return true;
+}
+
+void CEventManager::updateClientPolling(SClient& client, bool hadBacklog) {
+    const bool HASBACKLOG = client.pendingBytes > 0;
+
+    if (HASBACKLOG == hadBacklog)
+        return;
+
+    // poll for write only while there's something to write
+    wl_event_source_fd_update(client.eventSource, (client.readClosed ? 0 : WL_EVENT_READABLE) | (HASBACKLOG ? WL_EVENT_WRITABLE : 0));
+}
+
+void CEventManager::trimEvents() {
+    uint64_t oldest = m_firstEvent + m_events.size();
+    for (const auto& client : m_clients) {
+        oldest = std::min(oldest, client.nextEvent);
+    }
+
+    while (m_firstEvent < oldest) {
+        m_events.pop_front();
+        m_firstEvent++;
+    }
 }
 
 std::vector<CEventManager::SClient>::iterator CEventManager::findClientByFD(int fd) {
@@ -146,27 +363,43 @@ void CEventManager::postEvent(const SHyprIPCEvent& event) {
         return;
     }
 
-    const size_t MAX_QUEUED_EVENTS = 64;
-    auto         sharedEvent       = makeShared<std::string>(formatEvent(event));
+    if (m_clients.empty())
+        return;
+
+    static auto PMAXBACKLOG = CConfigValue<Hyprlang::INT>("misc:socket2_max_backlog");
+    const auto  MAXBACKLOG  = sc<size_t>(*PMAXBACKLOG) * 1024;
+
+    const auto  TYPE = eventType(event.event);
+
+    // nobody wants it, don't bother formatting
+    if (std::ranges::none_of(m_clients, [this, TYPE](const auto& client) { return wantsEvent(client, TYPE); }))
+        return;
+
+    auto& queued = m_events.emplace_back(SQueuedEvent{.data = formatEvent(event), .type = TYPE});
+
     for (auto it = m_clients.begin(); it != m_clients.end();) {
-        // try to send the event immediately if the queue is empty
-        const auto QUEUESIZE = it->events.size();
-        if (QUEUESIZE > 0 || write(it->fd.get(), sharedEvent->c_str(), sharedEvent->length()) < 0) {
-            if (QUEUESIZE >= MAX_QUEUED_EVENTS) {
-                // too many events queued, remove the client
-                Debug::log(ERR, "Socket2 fd {} overflowed event queue, removing", it->fd.get());
-                it = removeClientByFD(it->fd.get());
-                continue;
-            }
+        // clients with a backlog are already polling for write and will get this one batched with the rest
+        const bool HADBACKLOG = it->pendingBytes > 0;
+
+        if (wantsEvent(*it, TYPE))
+            it->pendingBytes += queued.data.size();
 
-            // queue it to send later if failed
-            it->events.push_back(sharedEvent);
+        if (!HADBACKLOG && !flushClient(*it)) {
+            Debug::log(LOG, "Socket2 fd {} broke while writing, removing", it->fd.get());
+            it = removeClientByFD(it->fd.get());
+            continue;
+        }
 
-            // poll for write if queue was empty
-            if (QUEUESIZE == 0)
-                wl_event_source_fd_update(it->eventSource, WL_EVENT_WRITABLE);
+        if (it->pendingBytes > MAXBACKLOG) {
+            Debug::log(ERR, "Socket2 fd {} is over {} bytes behind, removing", it->fd.get(), MAXBACKLOG);
+            it = removeClientByFD(it->fd.get());
+            continue;
         }
 
+        updateClientPolling(*it, HADBACKLOG);
+
         ++it;
     }
+
+    trimEvents();
 }
@@ -1,4 +1,6 @@
 #pragma once
+#include <deque>
+#include <unordered_map>
 #include <vector>
 #include <hyprutils/os/FileDescriptor.hpp>
 #include "../defines.hpp"
@@ -27,18 +29,54 @@ class CEventManager {
 
     struct SClient {
         Hyprutils::OS::CFileDescriptor fd;
-        std::vector<SP<std::string>>   events;
         wl_event_source*               eventSource = nullptr;
+
+        // read cursor into m_events: the first event not fully written yet, and how much of it was
+        uint64_t nextEvent    = 0;
+        size_t   offset       = 0;
+        size_t   pendingBytes = 0;
+
+        // set once the client sent a subscribe request, otherwise it gets every event
+        bool                     filtered = false;
+        std::vector<bool>        subscribed; // indexed by event type
+        std::vector<std::string> prefixes;
+
+        std::string              readBuffer;
+        bool                     readClosed = false; // shut down its end, it still gets events
+    };
+
+    // every event is formatted once and shared by all clients, until the slowest one has written it
+    struct SQueuedEvent {
+        std::string data;
+        size_t      type = 0;
     };
 
     std::vector<SClient>::iterator findClientByFD(int fd);
     std::vector<SClient>::iterator removeClientByFD(int fd);
 
+    // writes as much of the client's backlog as the socket takes, false if the client broke
+    bool   flushClient(SClient& client);
+    bool   readClient(SClient& client);
+    void   subscribeClient(SClient& client, std::string_view list);
+    void   updateClientPolling(SClient& client, bool hadBacklog);
+    void   trimEvents();
+
+    size_t eventType(const std::string& name);
+    void   setSubscribed(SClient& client, size_t type);
+    bool   wantsEvent(const SClient& client, size_t type) const;
+    void   skipUnwanted(SClient& client) const;
+
   private:
     Hyprutils::OS::CFileDescriptor m_socketFD;
     wl_event_source*               m_eventSource = nullptr;
 
     std::vector<SClient>           m_clients;
+
+    std::deque<SQueuedEvent>       m_events;
+    uint64_t                       m_firstEvent = 0; // sequence number of m_events.front()
+
+    // event names, interned to the ids the subscription masks are indexed with
+    std::unordered_map<std::string, size_t> m_eventTypes;
 };
 
 inline UP<CEventManager> g_pEventManager;
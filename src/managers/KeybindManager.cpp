@@ -218,6 +218,7 @@ CKeybindManager::~CKeybindManager() {
 
 void CKeybindManager::addKeybind(SKeybind kb) {
     m_keybinds.emplace_back(makeShared<SKeybind>(kb));
+    m_keybindIndex.dirty = true;
 
     m_activeKeybinds.clear();
     m_lastLongPressKeybind.reset();
@@ -225,11 +226,93 @@ void CKeybindManager::addKeybind(SKeybind kb) {
 
 void CKeybindManager::removeKeybind(uint32_t mod, const SParsedKey& key) {
     std::erase_if(m_keybinds, [&mod, &key](const auto& el) { return el->modmask == mod && el->key == key.key && el->keycode == key.keycode && el->catchAll == key.catchAll; });
+    m_keybindIndex.dirty = true;
 
     m_activeKeybinds.clear();
     m_lastLongPressKeybind.reset();
 }
 
+void CKeybindManager::ensureKeybindIndex() {
+    // m_keybinds is public, so also catch it being changed behind our back
+    if (m_keybindIndex.dirty || m_keybindIndex.bindCount != m_keybinds.size())
+        rebuildKeybindIndex();
+}
+
+void CKeybindManager::rebuildKeybindIndex() {
+    m_keybindIndex.byName.clear();
+    m_keybindIndex.byKeycode.clear();
+    m_keybindIndex.byKeysym.clear();
+    m_keybindIndex.catchAll.clear();
+    m_keybindIndex.multiKey.clear();
+
+    // mirrors the matching order in handleKeybinds
+    for (size_t i = 0; i < m_keybinds.size(); ++i) {
+        const auto& k = m_keybinds[i];
+
+        // resolved here instead of on every key event. Here and not in addKeybind, as not every bind comes through there.
+        k->keysym            = xkb_keysym_from_name(k->key.c_str(), XKB_KEYSYM_NO_FLAGS);
+        k->keysymLower       = xkb_keysym_from_name(k->key.c_str(), XKB_KEYSYM_CASE_INSENSITIVE);
+        k->specialDispatcher = k->handler == "global" || k->handler == "pass" || k->handler == "sendshortcut" || k->handler == "mouse";
+
+        if (k->multiKey) {
+            m_keybindIndex.multiKey.emplace_back(i);
+            continue;
+        }
+
+        // named keys (mouse, switches) are matched by name against every non multikey bind
+        m_keybindIndex.byName[k->key].emplace_back(i);
+
+        if (k->keycode != 0)
+            m_keybindIndex.byKeycode[k->keycode].emplace_back(i);
+        else if (k->catchAll)
+            m_keybindIndex.catchAll.emplace_back(i);
+        else {
+            if (k->keysym != XKB_KEY_NoSymbol)
+                m_keybindIndex.byKeysym[k->keysym].emplace_back(i);
+            if (k->keysymLower != XKB_KEY_NoSymbol && k->keysymLower != k->keysym)
+                m_keybindIndex.byKeysym[k->keysymLower].emplace_back(i);
+        }
+    }
+
+    m_keybindIndex.bindCount = m_keybinds.size();
+    m_keybindIndex.dirty     = false;
+}
+
+std::vector<SP<SKeybind>> CKeybindManager::keybindCandidates(const SPressedKeyWithMods& key) {
+    ensureKeybindIndex();
+
+    std::vector<size_t> ids;
+
+    const auto          ADD = [&ids](const auto& map, const auto& k) {
+        if (const auto IT = map.find(k); IT != map.end())
+            ids.insert(ids.end(), IT->second.begin(), IT->second.end());
+    };
+
+    if (!key.keyName.empty())
+        ADD(m_keybindIndex.byName, key.keyName);
+    else {
+        if (key.keycode != 0)
+            ADD(m_keybindIndex.byKeycode, key.keycode);
+        if (key.keysym != XKB_KEY_NoSymbol)
+            ADD(m_keybindIndex.byKeysym, key.keysym);
+        ids.insert(ids.end(), m_keybindIndex.catchAll.begin(), m_keybindIndex.catchAll.end());
+    }
+
+    ids.insert(ids.end(), m_keybindIndex.multiKey.begin(), m_keybindIndex.multiKey.end());
+
+    std::ranges::sort(ids);
+    const auto [FIRST, LAST] = std::ranges::unique(ids);
+    ids.erase(FIRST, LAST);
+
+    std::vector<SP<SKeybind>> candidates;
+    candidates.reserve(ids.size());
+    for (const auto ID : ids) {
+        candidates.emplace_back(m_keybinds[ID]);
+    }
+
+    return candidates;
+}
+
 uint32_t CKeybindManager::stringToModMask(std::string mods) {
     uint32_t modMask = 0;
     std::ranges::transform(mods, mods.begin(), ::toupper);
@@ -658,8 +741,9 @@ SDispatchResult CKeybindManager::handleKeybinds(const uint32_t modmask, const SP
             m_mkKeys.erase(key.keysym);
     }
 
-    for (auto& k : m_keybinds) {
-        const bool SPECIALDISPATCHER = k->handler == "global" || k->handler == "pass" || k->handler == "sendshortcut" || k->handler == "mouse";
+    // only binds that can match this key, in config order
+    for (auto& k : keybindCandidates(key)) {
+        const bool SPECIALDISPATCHER = k->specialDispatcher;
         const bool SPECIALTRIGGERED  = std::ranges::find_if(m_pressedSpecialBinds, [&](const auto& other) { return other == k; }) != m_pressedSpecialBinds.end();
         const bool IGNORECONDITIONS =
             SPECIALDISPATCHER && !pressed && SPECIALTRIGGERED; // ignore mods. Pass, global dispatchers should be released immediately once the key is released.
@@ -694,10 +778,8 @@ SDispatchResult CKeybindManager::handleKeybinds(const uint32_t modmask, const SP
             if (key.keysym == XKB_KEY_NoSymbol)
                 continue;
 
-            // oMg such performance hit!!11!
-            // this little maneouver is gonna cost us 4µs
-            const auto KBKEY      = xkb_keysym_from_name(k->key.c_str(), XKB_KEYSYM_NO_FLAGS);
-            const auto KBKEYLOWER = xkb_keysym_from_name(k->key.c_str(), XKB_KEYSYM_CASE_INSENSITIVE);
+            const auto KBKEY      = k->keysym;
+            const auto KBKEYLOWER = k->keysymLower;
 
             if (KBKEY == XKB_KEY_NoSymbol && KBKEYLOWER == XKB_KEY_NoSymbol) {
                 // Keysym failed to resolve from the key name of the currently iterated bind.
@@ -822,6 +904,8 @@ SDispatchResult CKeybindManager::handleKeybinds(const uint32_t modmask, const SP
 void CKeybindManager::shadowKeybinds(const xkb_keysym_t& doesntHave, const uint32_t doesntHaveCode) {
     // shadow disables keybinds after one has been triggered
 
+    ensureKeybindIndex(); // for the resolved keysyms
+
     for (auto& k : m_keybinds) {
 
         bool shadow = false;
@@ -832,7 +916,7 @@ void CKeybindManager::shadowKeybinds(const xkb_keysym_t& doesntHave, const uint3
         if (k->multiKey && (mkBindMatches(k) == MK_FULL_MATCH))
             shadow = true;
         else {
-            const auto KBKEY      = xkb_keysym_from_name(k->key.c_str(), XKB_KEYSYM_CASE_INSENSITIVE);
+            const auto KBKEY      = k->keysymLower;
             const auto KBKEYUPPER = xkb_keysym_to_upper(KBKEY);
 
             for (auto const& pk : m_pressedKeys) {
@@ -1088,6 +1172,7 @@ SDispatchResult CKeybindManager::signalWindow(std::string args) {
 
 void CKeybindManager::clearKeybinds() {
     m_keybinds.clear();
+    m_keybindIndex.dirty = true;
 }
 
 static SDispatchResult toggleActiveFloatingCore(std::string args, std::optional<bool> floatState) {
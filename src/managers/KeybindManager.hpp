@@ -53,6 +53,11 @@ struct SKeybind {
 
     // DO NOT INITIALIZE
     bool shadowed = false;
+
+    // resolved when the bind index is rebuilt
+    xkb_keysym_t keysym            = XKB_KEY_NoSymbol;
+    xkb_keysym_t keysymLower       = XKB_KEY_NoSymbol;
+    bool         specialDispatcher = false;
 };
 
 enum eFocusWindowMode : uint8_t {
@@ -147,6 +152,21 @@ class CKeybindManager {
 
     SDispatchResult                  handleKeybinds(const uint32_t, const SPressedKeyWithMods&, bool, SP<IKeyboard>);
 
+    // binds that can match a key, by what they match on. Values are positions in m_keybinds, so candidates keep the config order.
+    struct {
+        std::unordered_map<std::string, std::vector<size_t>>  byName;
+        std::unordered_map<uint32_t, std::vector<size_t>>     byKeycode;
+        std::unordered_map<xkb_keysym_t, std::vector<size_t>> byKeysym;
+        std::vector<size_t>                                   catchAll;
+        std::vector<size_t>                                   multiKey;
+        size_t                                                bindCount = 0;
+        bool                                                  dirty     = true;
+    } m_keybindIndex;
+
+    void                             ensureKeybindIndex();
+    void                             rebuildKeybindIndex();
+    std::vector<SP<SKeybind>>        keybindCandidates(const SPressedKeyWithMods&);
+
     std::set<xkb_keysym_t>           m_mkKeys = {};
     std::set<xkb_keysym_t>           m_mkMods = {};
     eMultiKeyCase                    mkBindMatches(const SP<SKeybind>);
@@ -1,5 +1,6 @@
 #include "InputManager.hpp"
 #include "../../Compositor.hpp"
+#include "../../debug/Telemetry.hpp"
 #include <aquamarine/output/Output.hpp>
 #include <cstdint>
 #include <hyprutils/math/Vector2D.hpp>
@@ -40,6 +41,7 @@
 #include "../../managers/EventManager.hpp"
 #include "../../managers/LayoutManager.hpp"
 #include "../../managers/permissions/DynamicPermissionManager.hpp"
+#include "../../managers/eventLoop/EventLoopManager.hpp"
 
 #include "../../helpers/time/Time.hpp"
 #include "../../helpers/MiscFunctions.hpp"
@@ -108,11 +110,16 @@ CInputManager::~CInputManager() {
     m_tabletPads.clear();
     m_idleInhibitors.clear();
     m_switches.clear();
+
+    if (m_coalescedMotion.timer && g_pEventLoopManager)
+        g_pEventLoopManager->removeTimer(m_coalescedMotion.timer);
 }
 
 void CInputManager::onMouseMoved(IPointer::SMotionEvent e) {
     static auto PNOACCEL = CConfigValue<Hyprlang::INT>("input:force_no_accel");
 
+    g_pTelemetry->onInput(g_pCompositor->getMonitorFromCursor());
+
     Vector2D    delta   = e.delta;
     Vector2D    unaccel = e.unaccel;
 
@@ -143,7 +150,10 @@ void CInputManager::onMouseMoved(IPointer::SMotionEvent e) {
 
     g_pPointerManager->move(DELTA);
 
-    mouseMoveUnified(e.timeMs, false, e.mouse);
+    m_motionStats.received++;
+
+    if (!coalesceMotion(e.timeMs, e.mouse))
+        mouseMoveUnified(e.timeMs, false, e.mouse);
 
     m_lastCursorMovement.reset();
 
@@ -156,13 +166,59 @@ void CInputManager::onMouseMoved(IPointer::SMotionEvent e) {
 void CInputManager::onMouseWarp(IPointer::SMotionAbsoluteEvent e) {
     g_pPointerManager->warpAbsolute(e.absolute, e.device);
 
-    mouseMoveUnified(e.timeMs);
+    m_motionStats.received++;
+
+    if (!coalesceMotion(e.timeMs, false))
+        mouseMoveUnified(e.timeMs);
 
     m_lastCursorMovement.reset();
 
     m_lastInputTouch = false;
 }
 
+bool CInputManager::coalesceMotion(uint32_t timeMs, bool mouse) {
+    static auto PCOALESCE = CConfigValue<Hyprlang::INT>("input:motion_coalesce");
+    static auto PINTERVAL = CConfigValue<Hyprlang::INT>("input:motion_coalesce_interval");
+
+    if (!*PCOALESCE)
+        return false;
+
+    // only when the client under the pointer is known and nothing needs every position checked
+    const auto PSURFACE = g_pSeatManager->m_state.pointerFocus.lock();
+    if (!PSURFACE || PSURFACE != m_coalescedMotion.surface.lock() || isConstrained() || PROTO::data->dndActive() || g_pSessionLockManager->isSessionLocked())
+        return false;
+
+    m_coalescedMotion.pending = true;
+    m_coalescedMotion.timeMs  = timeMs;
+    m_coalescedMotion.mouse   = m_coalescedMotion.mouse || mouse;
+
+    g_pSeatManager->sendPointerMotion(timeMs, m_coalescedMotion.local + (getMouseCoordsInternal() - m_coalescedMotion.pos) * m_coalescedMotion.scale);
+
+    if (!m_coalescedMotion.timer) {
+        m_coalescedMotion.timer = makeShared<CEventLoopTimer>(std::nullopt, [this](SP<CEventLoopTimer> self, void* data) { flushCoalescedMotion(); }, nullptr);
+        g_pEventLoopManager->addTimer(m_coalescedMotion.timer);
+    }
+
+    if (!m_coalescedMotion.timer->armed()) {
+        // by default, once per frame of the monitor under the cursor
+        const auto PMONITOR = g_pCompositor->getMonitorFromCursor();
+        const auto HZ       = PMONITOR ? std::max(1.F, PMONITOR->m_refreshRate) : 60.F;
+        m_coalescedMotion.timer->updateTimeout(*PINTERVAL > 0 ? std::chrono::microseconds(*PINTERVAL * 1000) : std::chrono::microseconds(sc<int64_t>(1000000.0 / HZ)));
+    }
+
+    return true;
+}
+
+void CInputManager::flushCoalescedMotion() {
+    if (!m_coalescedMotion.pending)
+        return;
+
+    const bool MOUSE        = m_coalescedMotion.mouse;
+    m_coalescedMotion.mouse = false;
+
+    mouseMoveUnified(m_coalescedMotion.timeMs, false, MOUSE);
+}
+
 void CInputManager::simulateMouseMovement() {
     m_lastCursorPosFloored = m_lastCursorPosFloored - Vector2D(1, 1); // hack: force the mouseMoveUnified to report without making this a refocus.
     mouseMoveUnified(Time::millis(Time::steadyNow()));
@@ -195,6 +251,11 @@ void CInputManager::mouseMoveUnified(uint32_t time, bool refocus, bool mouse, st
     if (MOUSECOORDSFLOORED == m_lastCursorPosFloored && !refocus)
         return;
 
+    // this pass covers whatever motion was held back, and decides where it goes next
+    m_coalescedMotion.pending = false;
+    m_coalescedMotion.surface.reset();
+    m_motionStats.evaluated++;
+
     static auto PFOLLOWMOUSE          = CConfigValue<Hyprlang::INT>("input:follow_mouse");
     static auto PFOLLOWMOUSETHRESHOLD = CConfigValue<Hyprlang::FLOAT>("input:follow_mouse_threshold");
     static auto PMOUSEREFOCUS         = CConfigValue<Hyprlang::INT>("input:mouse_refocus");
@@ -513,6 +574,13 @@ void CInputManager::mouseMoveUnified(uint32_t time, bool refocus, bool mouse, st
     if (pFoundWindow && pFoundWindow->m_isX11) // for x11 force scale zero
         surfaceLocal = surfaceLocal * pFoundWindow->m_X11SurfaceScaledBy;
 
+    const auto anchorCoalescedMotion = [&]() {
+        m_coalescedMotion.surface = foundSurface;
+        m_coalescedMotion.pos     = mouseCoords;
+        m_coalescedMotion.local   = surfaceLocal;
+        m_coalescedMotion.scale   = pFoundWindow && pFoundWindow->m_isX11 ? pFoundWindow->m_X11SurfaceScaledBy : 1.0;
+    };
+
     bool allowKeyboardRefocus = true;
 
     if (!refocus && Desktop::focusState()->surface()) {
@@ -572,8 +640,10 @@ void CInputManager::mouseMoveUnified(uint32_t time, bool refocus, bool mouse, st
             if (FOLLOWMOUSE != 0 || pFoundWindow == Desktop::focusState()->window())
                 g_pSeatManager->setPointerFocus(foundSurface, surfaceLocal);
 
-            if (g_pSeatManager->m_state.pointerFocus == foundSurface)
+            if (g_pSeatManager->m_state.pointerFocus == foundSurface) {
                 g_pSeatManager->sendPointerMotion(time, surfaceLocal);
+                anchorCoalescedMotion();
+            }
 
             m_lastFocusOnLS = false;
             return; // don't enter any new surfaces
@@ -618,11 +688,19 @@ void CInputManager::mouseMoveUnified(uint32_t time, bool refocus, bool mouse, st
 
     g_pSeatManager->setPointerFocus(foundSurface, surfaceLocal);
     g_pSeatManager->sendPointerMotion(time, surfaceLocal);
+
+    if (g_pSeatManager->m_state.pointerFocus == foundSurface)
+        anchorCoalescedMotion();
 }
 
 void CInputManager::onMouseButton(IPointer::SButtonEvent e) {
+    g_pTelemetry->onInput(g_pCompositor->getMonitorFromCursor());
+
     EMIT_HOOK_EVENT_CANCELLABLE("mouseButton", e);
 
+    // clicks go to wherever the pointer really is
+    flushCoalescedMotion();
+
     if (e.mouse)
         recheckMouseWarpOnMouseInput();
 
@@ -838,6 +916,11 @@ void CInputManager::onMouseWheel(IPointer::SAxisEvent e, SP<IPointer> pointer) {
     if (pointer && pointer->m_scrollFactor.has_value())
         factor = *pointer->m_scrollFactor;
 
+    // scrolling goes to wherever the pointer really is
+    flushCoalescedMotion();
+
+    g_pTelemetry->onInput(g_pCompositor->getMonitorFromCursor());
+
     const auto EMAP = std::unordered_map<std::string, std::any>{{"event", e}};
     EMIT_HOOK_EVENT_CANCELLABLE("mouseAxis", EMAP);
 
@@ -1425,6 +1508,8 @@ void CInputManager::onKeyboardKey(const IKeyboard::SKeyEvent& event, SP<IKeyboar
     if (!pKeyboard->m_enabled || !pKeyboard->m_allowed)
         return;
 
+    g_pTelemetry->onInput(Desktop::focusState()->monitor());
+
     const bool DISALLOWACTION = pKeyboard->isVirtual() && shouldIgnoreVirtualKeyboard(pKeyboard);
 
     const auto IME    = m_relay.m_inputMethod.lock();
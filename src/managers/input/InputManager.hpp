@@ -20,6 +20,7 @@ class CIdleInhibitor;
 class CVirtualKeyboardV1Resource;
 class CVirtualPointerV1Resource;
 class IKeyboard;
+class CEventLoopTimer;
 
 AQUAMARINE_FORWARD(IPointer);
 AQUAMARINE_FORWARD(IKeyboard);
@@ -214,6 +215,12 @@ class CInputManager {
     //
     bool m_emptyFocusCursorSet = false;
 
+    // pointer motion events received vs full refocus passes run, see input:motion_coalesce
+    struct {
+        uint64_t received  = 0;
+        uint64_t evaluated = 0;
+    } m_motionStats;
+
   private:
     // Listeners
     struct {
@@ -247,6 +254,9 @@ class CInputManager {
     void               mouseMoveUnified(uint32_t, bool refocus = false, bool mouse = false, std::optional<Vector2D> overridePos = std::nullopt);
     void               recheckMouseWarpOnMouseInput();
 
+    bool               coalesceMotion(uint32_t timeMs, bool mouse);
+    void               flushCoalescedMotion();
+
     SP<CTabletTool>    ensureTabletToolPresent(SP<Aquamarine::ITabletTool>);
 
     void               applyConfigToKeyboard(SP<IKeyboard>);
@@ -261,6 +271,20 @@ class CInputManager {
     double   m_mousePosDelta  = 0;
     bool     m_lastInputMouse = true;
 
+    // motion held back until the next refocus pass. surface, pos, local and scale are where the last
+    // full pass left the pointer, so held back motion can still be sent to the client right away.
+    struct {
+        SP<CEventLoopTimer>    timer;
+        bool                   pending = false;
+        uint32_t               timeMs  = 0;
+        bool                   mouse   = false;
+
+        WP<CWLSurfaceResource> surface;
+        Vector2D               pos;
+        Vector2D               local;
+        double                 scale = 1.0;
+    } m_coalescedMotion;
+
     // for holding focus on buttons held
     bool m_focusHeldByButtons   = false;
     bool m_refocusHeldByButtons = false;
@@ -1,6 +1,7 @@
 #include "PresentationTime.hpp"
 #include <algorithm>
 #include "../helpers/Monitor.hpp"
+#include "../debug/Telemetry.hpp"
 #include "../managers/HookSystemManager.hpp"
 #include "core/Compositor.hpp"
 #include "core/Output.hpp"
@@ -111,6 +112,8 @@ void CPresentationProtocol::onGetFeedback(CWpPresentation* pMgr, wl_resource* su
 }
 
 void CPresentationProtocol::onPresented(PHLMONITOR pMonitor, const Time::steady_tp& when, uint32_t untilRefreshNs, uint64_t seq, uint32_t reportedFlags) {
+    g_pTelemetry->onPresented(pMonitor, when);
+
     for (auto const& feedback : m_feedbacks) {
         if (!feedback->m_surface)
             continue;
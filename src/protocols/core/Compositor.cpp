@@ -65,7 +65,13 @@ SP<CWLRegionResource> CWLRegionResource::fromResource(wl_resource* res) {
     return data ? data->m_self.lock() : nullptr;
 }
 
-CWLSurfaceResource::CWLSurfaceResource(SP<CWlSurface> resource_) : m_resource(resource_) {
+// unique across all trees. A subsurface's cached tree gets compared against a new root once it's attached, its old stamp can't match that.
+static uint64_t nextTreeGeneration() {
+    static uint64_t generation = 0;
+    return ++generation;
+}
+
+CWLSurfaceResource::CWLSurfaceResource(SP<CWlSurface> resource_) : m_resource(resource_), m_treeGeneration(nextTreeGeneration()) {
     if UNLIKELY (!good())
         return;
 
@@ -142,7 +148,7 @@ CWLSurfaceResource::CWLSurfaceResource(SP<CWlSurface> resource_) : m_resource(re
         }
 
         // save state while we wait for buffer to become ready
-        auto state = m_stateQueue.enqueue(makeUnique<SSurfaceState>(m_pending));
+        auto state = m_stateQueue.enqueue(m_pending);
         m_pending.reset();
 
         // fifo and fences first
@@ -238,6 +244,10 @@ CWLSurfaceResource::CWLSurfaceResource(SP<CWlSurface> resource_) : m_resource(re
 
 CWLSurfaceResource::~CWLSurfaceResource() {
     m_events.destroy.emit();
+
+    // whatever tree this was in skips it and everything below it from now on, like the traversal always did for expired surfaces.
+    // this is where the handles expire, destroy() alone isn't enough if someone else still holds the surface.
+    invalidateTree();
 }
 
 void CWLSurfaceResource::destroy() {
@@ -343,7 +353,7 @@ void CWLSurfaceResource::resetRole() {
     m_role = makeShared<CDefaultSurfaceRole>();
 }
 
-void CWLSurfaceResource::bfHelper(std::vector<SP<CWLSurfaceResource>> const& nodes, std::function<void(SP<CWLSurfaceResource>, const Vector2D&, void*)> fn, void* data) {
+void CWLSurfaceResource::flattenLevel(const std::vector<SP<CWLSurfaceResource>>& nodes, std::vector<SFlatSurface>& out) {
     std::vector<SP<CWLSurfaceResource>> nodes2;
     nodes2.reserve(nodes.size() * 2);
 
@@ -361,7 +371,7 @@ void CWLSurfaceResource::bfHelper(std::vector<SP<CWLSurfaceResource>> const& nod
     }
 
     if (!nodes2.empty())
-        bfHelper(nodes2, fn, data);
+        flattenLevel(nodes2, out);
 
     nodes2.clear();
 
@@ -372,7 +382,7 @@ void CWLSurfaceResource::bfHelper(std::vector<SP<CWLSurfaceResource>> const& nod
             offset          = subsurface->posRelativeToParent();
         }
 
-        fn(n, offset, data);
+        out.emplace_back(SFlatSurface{.surface = n, .offset = offset});
     }
 
     for (auto const& n : nodes) {
@@ -386,13 +396,49 @@ void CWLSurfaceResource::bfHelper(std::vector<SP<CWLSurfaceResource>> const& nod
     }
 
     if (!nodes2.empty())
-        bfHelper(nodes2, fn, data);
+        flattenLevel(nodes2, out);
+}
+
+std::vector<CWLSurfaceResource::SFlatSurface> CWLSurfaceResource::buildFlatTree() {
+    std::vector<SFlatSurface> tree;
+    flattenLevel({m_self.lock()}, tree);
+    return tree;
+}
+
+CWLSurfaceResource* CWLSurfaceResource::treeRoot() {
+    // raw pointers, this runs from the destructor too
+    auto* surf = this;
+    while (surf->m_role && surf->m_role->role() == SURFACE_ROLE_SUBSURFACE) {
+        const auto SUBSURFACE = sc<CSubsurfaceRole*>(surf->m_role.get())->m_subsurface.lock();
+        if (!SUBSURFACE || !SUBSURFACE->m_parent)
+            break;
+
+        surf = SUBSURFACE->m_parent.get();
+    }
+
+    return surf;
+}
+
+void CWLSurfaceResource::invalidateTree() {
+    treeRoot()->m_treeGeneration = nextTreeGeneration();
+}
+
+bool CWLSurfaceResource::ensureFlatTree() {
+    const auto GENERATION = treeRoot()->m_treeGeneration;
+
+    if (m_flatTreeGeneration == GENERATION)
+        return true;
+
+    if (m_flatTreeVisitors > 0)
+        return false;
+
+    m_flatTree           = buildFlatTree();
+    m_flatTreeGeneration = GENERATION;
+    return true;
 }
 
 void CWLSurfaceResource::breadthfirst(std::function<void(SP<CWLSurfaceResource>, const Vector2D&, void*)> fn, void* data) {
-    std::vector<SP<CWLSurfaceResource>> surfs;
-    surfs.push_back(m_self.lock());
-    bfHelper(surfs, fn, data);
+    forEachSurface([&fn, data](const SP<CWLSurfaceResource>& surf, const Vector2D& offset) { fn(surf, offset, data); });
 }
 
 SP<CWLSurfaceResource> CWLSurfaceResource::findFirstPreorderHelper(SP<CWLSurfaceResource> root, std::function<bool(SP<CWLSurfaceResource>)> fn) {
@@ -417,10 +463,15 @@ SP<CWLSurfaceResource> CWLSurfaceResource::findWithCM() {
 }
 
 std::pair<SP<CWLSurfaceResource>, Vector2D> CWLSurfaceResource::at(const Vector2D& localCoords, bool allowsInput) {
-    std::vector<std::pair<SP<CWLSurfaceResource>, Vector2D>> surfs;
-    breadthfirst([&surfs](SP<CWLSurfaceResource> surf, const Vector2D& offset, void* data) { surfs.emplace_back(std::make_pair<>(surf, offset)); }, &surfs);
+    // nothing below calls out, so the cached list can't change under us. Topmost first.
+    const auto STALE = !ensureFlatTree();
+    const auto TREE  = STALE ? buildFlatTree() : std::vector<SFlatSurface>{};
+
+    for (auto const& [weakSurf, pos] : (STALE ? TREE : m_flatTree) | std::views::reverse) {
+        const auto surf = weakSurf.lock();
+        if (!surf)
+            continue;
 
-    for (auto const& [surf, pos] : surfs | std::views::reverse) {
         if (!allowsInput) {
             const auto BOX = CBox{pos, surf->m_current.size};
             if (BOX.containsPoint(localCoords))
@@ -479,14 +530,12 @@ SP<CWlSurface> CWLSurfaceResource::getResource() {
 
 CBox CWLSurfaceResource::extends() {
     CRegion full = CBox{{}, m_current.size};
-    breadthfirst(
-        [](SP<CWLSurfaceResource> surf, const Vector2D& offset, void* d) {
-            if (surf->m_role->role() != SURFACE_ROLE_SUBSURFACE)
-                return;
-
-            sc<CRegion*>(d)->add(CBox{offset, surf->m_current.size});
-        },
-        &full);
+    forEachSurface([&full](const SP<CWLSurfaceResource>& surf, const Vector2D& offset) {
+        if (surf->m_role->role() != SURFACE_ROLE_SUBSURFACE)
+            return;
+
+        full.add(CBox{offset, surf->m_current.size});
+    });
     return full.getExtents();
 }
 
@@ -538,16 +587,14 @@ void CWLSurfaceResource::commitState(SSurfaceState& state) {
         m_events.commit.emit();
     } else {
         // send commit to all synced surfaces in this tree.
-        breadthfirst(
-            [](SP<CWLSurfaceResource> surf, const Vector2D& offset, void* data) {
-                if (surf->m_role->role() == SURFACE_ROLE_SUBSURFACE) {
-                    auto subsurface = sc<CSubsurfaceRole*>(surf->m_role.get())->m_subsurface.lock();
-                    if (!subsurface->m_sync)
-                        return;
-                }
-                surf->m_events.commit.emit();
-            },
-            nullptr);
+        forEachSurface([](const SP<CWLSurfaceResource>& surf, const Vector2D& offset) {
+            if (surf->m_role->role() == SURFACE_ROLE_SUBSURFACE) {
+                auto subsurface = sc<CSubsurfaceRole*>(surf->m_role.get())->m_subsurface.lock();
+                if (!subsurface->m_sync)
+                    return;
+            }
+            surf->m_events.commit.emit();
+        });
     }
 
     // release the buffer if it's synchronous (SHM) as updateSynchronousTexture() has copied the buffer data to a GPU tex
@@ -134,6 +134,33 @@ class CWLSurfaceResource {
     // localCoords param is relative to 0,0 of this surface
     std::pair<SP<CWLSurfaceResource>, Vector2D> at(const Vector2D& localCoords, bool allowsInput = false);
 
+    // call when a subsurface at or below this surface is added, removed, restacked or moved. Drops the cached trees of
+    // every surface in the tree this one is in, and only those.
+    void invalidateTree();
+
+    // same order and offsets as breadthfirst, fn(SP<CWLSurfaceResource>, const Vector2D& offset). Doesn't allocate unless the tree changed.
+    template <typename F>
+    void forEachSurface(F&& fn) {
+        // keeps this, and with it m_flatTree, alive if fn drops the last other reference
+        const auto SELF = m_self.lock();
+
+        if (!ensureFlatTree()) {
+            // the tree changed while a visit is still walking the cached list, leave that one alone
+            for (const auto& [surf, offset] : buildFlatTree()) {
+                if (const auto SURF = surf.lock(); SURF)
+                    fn(SURF, offset);
+            }
+            return;
+        }
+
+        m_flatTreeVisitors++;
+        for (const auto& [surf, offset] : m_flatTree) {
+            if (const auto SURF = surf.lock(); SURF)
+                fn(SURF, offset);
+        }
+        m_flatTreeVisitors--;
+    }
+
   private:
     SP<CWlSurface>         m_resource;
     wl_client*             m_client = nullptr;
@@ -142,10 +169,25 @@ class CWLSurfaceResource {
     void                   releaseBuffers(bool onlyCurrent = true);
     void                   dropPendingBuffer();
     void                   dropCurrentBuffer();
-    void                   bfHelper(std::vector<SP<CWLSurfaceResource>> const& nodes, std::function<void(SP<CWLSurfaceResource>, const Vector2D&, void*)> fn, void* data);
     SP<CWLSurfaceResource> findFirstPreorderHelper(SP<CWLSurfaceResource> root, std::function<bool(SP<CWLSurfaceResource>)> fn);
     void                   updateCursorShm(CRegion damage = CBox{0, 0, INT16_MAX, INT16_MAX});
 
+    struct SFlatSurface {
+        WP<CWLSurfaceResource> surface;
+        Vector2D               offset;
+    };
+
+    // this surface and its subsurfaces in breadthfirst order, rebuilt when the generation of the tree's root moves on
+    std::vector<SFlatSurface> m_flatTree;
+    uint64_t                  m_flatTreeGeneration = 0;
+    int                       m_flatTreeVisitors   = 0;
+    uint64_t                  m_treeGeneration     = 0; // only looked at on roots, bumped by invalidateTree
+
+    bool                      ensureFlatTree(); // false if it's stale but in use
+    std::vector<SFlatSurface> buildFlatTree();
+    CWLSurfaceResource*       treeRoot();
+    static void               flattenLevel(const std::vector<SP<CWLSurfaceResource>>& nodes, std::vector<SFlatSurface>& out);
+
     friend class CWLPointerResource;
 };
 
@@ -10,7 +10,11 @@ CWLSubsurfaceResource::CWLSubsurfaceResource(SP<CWlSubsurface> resource_, SP<CWL
     m_resource->setOnDestroy([this](CWlSubsurface* r) { destroy(); });
     m_resource->setDestroy([this](CWlSubsurface* r) { destroy(); });
 
-    m_resource->setSetPosition([this](CWlSubsurface* r, int32_t x, int32_t y) { m_position = {x, y}; });
+    m_resource->setSetPosition([this](CWlSubsurface* r, int32_t x, int32_t y) {
+        m_position = {x, y};
+        if (m_parent)
+            m_parent->invalidateTree();
+    });
 
     m_resource->setSetDesync([this](CWlSubsurface* r) { m_sync = false; });
     m_resource->setSetSync([this](CWlSubsurface* r) { m_sync = true; });
@@ -21,6 +25,8 @@ CWLSubsurfaceResource::CWLSubsurfaceResource(SP<CWlSubsurface> resource_, SP<CWL
         if (!m_parent)
             return;
 
+        m_parent->invalidateTree();
+
         std::erase_if(m_parent->m_subsurfaces, [this](const auto& e) { return e == m_self || !e; });
 
         std::ranges::for_each(m_parent->m_subsurfaces, [](const auto& e) { e->m_zIndex *= 2; });
@@ -51,6 +57,8 @@ CWLSubsurfaceResource::CWLSubsurfaceResource(SP<CWlSubsurface> resource_, SP<CWL
         if (!m_parent)
             return;
 
+        m_parent->invalidateTree();
+
         std::erase_if(m_parent->m_subsurfaces, [this](const auto& e) { return e == m_self || !e; });
 
         std::ranges::for_each(m_parent->m_subsurfaces, [](const auto& e) { e->m_zIndex *= 2; });
@@ -92,8 +100,14 @@ CWLSubsurfaceResource::CWLSubsurfaceResource(SP<CWlSubsurface> resource_, SP<CWL
 
 CWLSubsurfaceResource::~CWLSubsurfaceResource() {
     m_events.destroy.emit();
-    if (m_surface)
+    if (m_surface) {
         m_surface->resetRole();
+        // a root of its own now, and changes below it while it wasn't went to the old root
+        m_surface->invalidateTree();
+    }
+
+    if (m_parent)
+        m_parent->invalidateTree();
 }
 
 void CWLSubsurfaceResource::destroy() {
@@ -185,6 +199,7 @@ CWLSubcompositorResource::CWLSubcompositorResource(SP<CWlSubcompositor> resource
         RESOURCE->m_self = RESOURCE;
         SURF->m_role     = makeShared<CSubsurfaceRole>(RESOURCE);
         PARENT->m_subsurfaces.emplace_back(RESOURCE);
+        PARENT->invalidateTree();
 
         LOGM(LOG, "New wl_subsurface with id {} at {:x}", id, (uintptr_t)RESOURCE.get());
 
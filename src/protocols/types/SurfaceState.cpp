@@ -65,6 +65,40 @@ void SSurfaceState::reset() {
     lockMask = LOCK_REASON_NONE;
 }
 
+void SSurfaceState::takeFrom(SSurfaceState& pending) {
+    // assigning into regions this state already owns reuses their storage, so a pooled state doesn't allocate here
+    updated      = pending.updated;
+    rejected     = pending.rejected;
+    buffer       = pending.buffer;
+    damage       = pending.damage;
+    bufferDamage = pending.bufferDamage;
+    opaque       = pending.opaque;
+    input        = pending.input;
+    transform    = pending.transform;
+    scale        = pending.scale;
+    size         = pending.size;
+    bufferSize   = pending.bufferSize;
+    offset       = pending.offset;
+    ackedSize    = pending.ackedSize;
+    viewport     = pending.viewport;
+    acquire      = pending.acquire;
+    lockMask     = pending.lockMask;
+    texture      = pending.texture;
+
+    // reset() empties pending's callbacks anyway, so hand it our empty vector instead, capacity and all
+    callbacks.clear();
+    std::swap(callbacks, pending.callbacks);
+}
+
+void SSurfaceState::release() {
+    buffer   = {};
+    acquire  = {};
+    rejected = false;
+    lockMask = LOCK_REASON_NONE;
+    texture.reset();
+    callbacks.clear();
+}
+
 void SSurfaceState::updateFrom(SSurfaceState& ref) {
     updated = ref.updated;
 
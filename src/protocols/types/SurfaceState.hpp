@@ -88,8 +88,13 @@ struct SSurfaceState {
     SP<CTexture> texture;
     void         updateSynchronousTexture(SP<CTexture> lastTexture);
 
+    // set while the state waits in a CSurfaceStateQueue
+    bool queued = false;
+
     // helpers
-    CRegion accumulateBufferDamage();       // transforms state.damage and merges it into state.bufferDamage
-    void    updateFrom(SSurfaceState& ref); // updates this state based on a reference state.
-    void    reset();                        // resets pending state after commit
+    CRegion accumulateBufferDamage();         // transforms state.damage and merges it into state.bufferDamage
+    void    updateFrom(SSurfaceState& ref);   // updates this state based on a reference state.
+    void    takeFrom(SSurfaceState& pending); // takes over pending state on commit, reusing this state's storage
+    void    reset();                          // resets pending state after commit
+    void    release();                        // drops references, keeps storage, for states parked in a pool
 };
@@ -1,39 +1,69 @@
 #include "SurfaceStateQueue.hpp"
 #include "../core/Compositor.hpp"
 #include "SurfaceState.hpp"
+#include <algorithm>
+
+// deeper queues than this only happen with fifo or fences piling up, those states are just freed
+constexpr size_t POOL_CAPACITY = 4;
 
 CSurfaceStateQueue::CSurfaceStateQueue(WP<CWLSurfaceResource> surf) : m_surface(std::move(surf)) {}
 
 void CSurfaceStateQueue::clear() {
+    // not pooled, these can still have fence waiters holding onto them, freeing expires those handles
     m_queue.clear();
 }
 
-WP<SSurfaceState> CSurfaceStateQueue::enqueue(UP<SSurfaceState>&& state) {
+WP<SSurfaceState> CSurfaceStateQueue::enqueue(SSurfaceState& pending) {
+    UP<SSurfaceState> state;
+    if (!m_pool.empty()) {
+        state = std::move(m_pool.back());
+        m_pool.pop_back();
+        m_stats.reused++;
+    } else {
+        state = makeUnique<SSurfaceState>();
+        m_stats.allocated++;
+    }
+
+    state->takeFrom(pending);
+    state->queued = true;
+
     return m_queue.emplace_back(std::move(state));
 }
 
 void CSurfaceStateQueue::dropState(const WP<SSurfaceState>& state) {
+    if (state.expired() || !state->queued)
+        return;
+
+    // states get rejected in the commit that queued them, nothing can be queued after them yet
+    if (m_queue.back().get() == state.get()) {
+        auto dropped = std::move(m_queue.back());
+        m_queue.pop_back();
+        recycle(std::move(dropped));
+        return;
+    }
+
     auto it = find(state);
     if (it == m_queue.end())
         return;
 
+    auto dropped = std::move(*it);
     m_queue.erase(it);
+    recycle(std::move(dropped));
 }
 
 void CSurfaceStateQueue::lock(const WP<SSurfaceState>& weakState, eLockReason reason) {
-    auto it = find(weakState);
-    if (it == m_queue.end())
+    // pooled states aren't queued, so a handle to one that was applied already is a no-op
+    if (weakState.expired() || !weakState->queued)
         return;
 
-    it->get()->lockMask |= reason;
+    weakState->lockMask |= reason;
 }
 
 void CSurfaceStateQueue::unlock(const WP<SSurfaceState>& state, eLockReason reason) {
-    auto it = find(state);
-    if (it == m_queue.end())
+    if (state.expired() || !state->queued)
         return;
 
-    it->get()->lockMask &= ~reason;
+    state->lockMask &= ~reason;
     tryProcess();
 }
 
@@ -54,12 +84,23 @@ auto CSurfaceStateQueue::find(const WP<SSurfaceState>& state) -> std::deque<UP<S
 
     auto* raw = state.get(); // get raw pointer
 
-    for (auto it = m_queue.begin(); it != m_queue.end(); ++it) {
-        if (it->get() == raw)
-            return it;
-    }
+    // only for a drop of anything but the last queued state, which doesn't happen in practice
+    auto it = std::ranges::find_if(m_queue.rbegin(), m_queue.rend(), [raw](const auto& s) { return s.get() == raw; });
+    return it == m_queue.rend() ? m_queue.end() : std::prev(it.base());
+}
 
-    return m_queue.end();
+// A pooled state is handed out again by enqueue, so a stale handle to it would lock or unlock someone else's commit.
+// None can be left: the only handles kept past commit are the fence waiters set up in scheduleState, and a state with
+// a waiter holds LOCK_REASON_FENCE until that waiter fires, once. tryProcess only gets here with the lock mask empty,
+// dropState only for states rejected before scheduleState, and clear(), which can cut waiters short, frees instead.
+void CSurfaceStateQueue::recycle(UP<SSurfaceState>&& state) {
+    state->queued = false;
+
+    if (m_pool.size() >= POOL_CAPACITY)
+        return;
+
+    state->release();
+    m_pool.emplace_back(std::move(state));
 }
 
 void CSurfaceStateQueue::tryProcess() {
@@ -69,6 +110,9 @@ void CSurfaceStateQueue::tryProcess() {
             return;
 
         m_surface->commitState(*front);
+
+        auto applied = std::move(m_queue.front());
         m_queue.pop_front();
+        recycle(std::move(applied));
     }
 }
@@ -3,6 +3,7 @@
 #include "../../helpers/memory/Memory.hpp"
 #include "SurfaceState.hpp"
 #include <deque>
+#include <vector>
 
 class CWLSurfaceResource;
 
@@ -12,16 +13,23 @@ class CSurfaceStateQueue {
     explicit CSurfaceStateQueue(WP<CWLSurfaceResource> surf);
 
     void              clear();
-    WP<SSurfaceState> enqueue(UP<SSurfaceState>&& state);
+    WP<SSurfaceState> enqueue(SSurfaceState& pending);
     void              dropState(const WP<SSurfaceState>& state);
     void              lock(const WP<SSurfaceState>& state, eLockReason reason);
     void              unlock(const WP<SSurfaceState>& state, eLockReason reason = LOCK_REASON_NONE);
     void              unlockFirst(eLockReason reason);
     void              tryProcess();
 
+    struct SStats {
+        size_t allocated = 0; // states that had to be allocated
+        size_t reused    = 0; // states taken from the pool
+    } m_stats;
+
   private:
     std::deque<UP<SSurfaceState>>                    m_queue;
+    std::vector<UP<SSurfaceState>>                   m_pool; // applied states, kept for their storage
     WP<CWLSurfaceResource>                           m_surface;
 
     typename std::deque<UP<SSurfaceState>>::iterator find(const WP<SSurfaceState>& state);
+    void                                             recycle(UP<SSurfaceState>&& state);
 };
@@ -343,6 +343,11 @@ CHyprOpenGLImpl::CHyprOpenGLImpl() : m_drmFD(g_pCompositor->m_drmRenderNode.fd >
     Debug::log(LOG, "Renderer: {}", rc<const char*>(glGetString(GL_RENDERER)));
     Debug::log(LOG, "Supported extensions: ({}) {}", std::ranges::count(m_extensions, ' '), m_extensions);
 
+    m_programCache       = makeUnique<CProgramCache>();
+    m_textRenderer       = makeUnique<CTextRenderer>();
+    m_shmUploader        = makeUnique<CShmUploader>();
+    m_useSurfaceVariants = !envEnabled("HYPRLAND_NO_SHADER_VARIANTS");
+
     m_exts.EXT_read_format_bgra = m_extensions.contains("GL_EXT_read_format_bgra");
 
     RASSERT(m_extensions.contains("GL_EXT_texture_format_BGRA8888"), "GL_EXT_texture_format_BGRA8888 support by the GPU driver is required");
@@ -660,6 +665,12 @@ void CHyprOpenGLImpl::logShaderError(const GLuint& shader, bool program, bool si
 }
 
 GLuint CHyprOpenGLImpl::createProgram(const std::string& vert, const std::string& frag, bool dynamic, bool silent) {
+    if (const auto CACHED = m_programCache->load(vert, frag); CACHED)
+        return CACHED;
+
+    CTimer timer;
+    timer.reset();
+
     auto vertCompiled = compileShader(GL_VERTEX_SHADER, vert, dynamic, silent);
     if (dynamic) {
         if (vertCompiled == 0)
@@ -677,6 +688,8 @@ GLuint CHyprOpenGLImpl::createProgram(const std::string& vert, const std::string
     auto prog = glCreateProgram();
     glAttachShader(prog, vertCompiled);
     glAttachShader(prog, fragCompiled);
+    if (m_programCache->enabled())
+        glProgramParameteri(prog, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
     glLinkProgram(prog);
 
     glDetachShader(prog, vertCompiled);
@@ -697,6 +710,9 @@ GLuint CHyprOpenGLImpl::createProgram(const std::string& vert, const std::string
         RASSERT(ok != GL_FALSE, "createProgram() failed! GL_LINK_STATUS not OK!");
     }
 
+    m_programCache->m_stats.compileMs += timer.getMillis();
+    m_programCache->store(prog, vert, frag);
+
     return prog;
 }
 
@@ -990,14 +1006,19 @@ bool CHyprOpenGLImpl::initShaders() {
     auto              shaders   = makeShared<SPreparedShaders>();
     const bool        isDynamic = m_shadersInitialized;
     static const auto PCM       = CConfigValue<Hyprlang::INT>("render:cm_enabled");
+    const auto        STATS     = m_programCache->m_stats;
+
+    CTimer            timer;
+    timer.reset();
 
     try {
         std::map<std::string, std::string> includes;
         loadShaderInclude("rounding.glsl", includes);
         loadShaderInclude("CM.glsl", includes);
 
-        shaders->TEXVERTSRC    = processShader("tex300.vert", includes);
-        shaders->TEXVERTSRC320 = processShader("tex320.vert", includes);
+        shaders->TEXVERTSRC        = processShader("tex300.vert", includes);
+        shaders->TEXVERTSRC320     = processShader("tex320.vert", includes);
+        shaders->TEXFRAGSRCSURFACE = processShader("surface.frag", includes);
 
         GLuint prog;
 
@@ -1038,8 +1059,6 @@ bool CHyprOpenGLImpl::initShaders() {
 
         const auto FRAGSHADOW             = processShader("shadow.frag", includes);
         const auto FRAGBORDER1            = processShader("border.frag", includes);
-        const auto FRAGBLURPREPARE        = processShader("blurprepare.frag", includes);
-        const auto FRAGBLURFINISH         = processShader("blurfinish.frag", includes);
         const auto QUADFRAGSRC            = processShader("quad.frag", includes);
         const auto TEXFRAGSRCRGBA         = processShader("rgba.frag", includes);
         const auto TEXFRAGSRCRGBAPASSTHRU = processShader("passthru.frag", includes);
@@ -1151,7 +1170,9 @@ bool CHyprOpenGLImpl::initShaders() {
         prog = createProgram(shaders->TEXVERTSRC, FRAGBLUR1, isDynamic);
         if (!prog)
             return false;
-        shaders->m_shBLUR1.program                                    = prog;
+        shaders->m_shBLUR1.program = prog;
+        getCMShaderUniforms(shaders->m_shBLUR1);
+
         shaders->m_shBLUR1.uniformLocations[SHADER_TEX]               = glGetUniformLocation(prog, "tex");
         shaders->m_shBLUR1.uniformLocations[SHADER_ALPHA]             = glGetUniformLocation(prog, "alpha");
         shaders->m_shBLUR1.uniformLocations[SHADER_PROJ]              = glGetUniformLocation(prog, "proj");
@@ -1162,49 +1183,27 @@ bool CHyprOpenGLImpl::initShaders() {
         shaders->m_shBLUR1.uniformLocations[SHADER_PASSES]            = glGetUniformLocation(prog, "passes");
         shaders->m_shBLUR1.uniformLocations[SHADER_VIBRANCY]          = glGetUniformLocation(prog, "vibrancy");
         shaders->m_shBLUR1.uniformLocations[SHADER_VIBRANCY_DARKNESS] = glGetUniformLocation(prog, "vibrancy_darkness");
+        shaders->m_shBLUR1.uniformLocations[SHADER_BLUR_PREPARE]      = glGetUniformLocation(prog, "prepare");
+        shaders->m_shBLUR1.uniformLocations[SHADER_CONTRAST]          = glGetUniformLocation(prog, "contrast");
+        shaders->m_shBLUR1.uniformLocations[SHADER_BRIGHTNESS]        = glGetUniformLocation(prog, "brightness");
         shaders->m_shBLUR1.createVao();
 
         prog = createProgram(shaders->TEXVERTSRC, FRAGBLUR2, isDynamic);
         if (!prog)
             return false;
-        shaders->m_shBLUR2.program                             = prog;
-        shaders->m_shBLUR2.uniformLocations[SHADER_TEX]        = glGetUniformLocation(prog, "tex");
-        shaders->m_shBLUR2.uniformLocations[SHADER_ALPHA]      = glGetUniformLocation(prog, "alpha");
-        shaders->m_shBLUR2.uniformLocations[SHADER_PROJ]       = glGetUniformLocation(prog, "proj");
-        shaders->m_shBLUR2.uniformLocations[SHADER_POS_ATTRIB] = glGetAttribLocation(prog, "pos");
-        shaders->m_shBLUR2.uniformLocations[SHADER_TEX_ATTRIB] = glGetAttribLocation(prog, "texcoord");
-        shaders->m_shBLUR2.uniformLocations[SHADER_RADIUS]     = glGetUniformLocation(prog, "radius");
-        shaders->m_shBLUR2.uniformLocations[SHADER_HALFPIXEL]  = glGetUniformLocation(prog, "halfpixel");
+        shaders->m_shBLUR2.program                              = prog;
+        shaders->m_shBLUR2.uniformLocations[SHADER_TEX]         = glGetUniformLocation(prog, "tex");
+        shaders->m_shBLUR2.uniformLocations[SHADER_ALPHA]       = glGetUniformLocation(prog, "alpha");
+        shaders->m_shBLUR2.uniformLocations[SHADER_PROJ]        = glGetUniformLocation(prog, "proj");
+        shaders->m_shBLUR2.uniformLocations[SHADER_POS_ATTRIB]  = glGetAttribLocation(prog, "pos");
+        shaders->m_shBLUR2.uniformLocations[SHADER_TEX_ATTRIB]  = glGetAttribLocation(prog, "texcoord");
+        shaders->m_shBLUR2.uniformLocations[SHADER_RADIUS]      = glGetUniformLocation(prog, "radius");
+        shaders->m_shBLUR2.uniformLocations[SHADER_HALFPIXEL]   = glGetUniformLocation(prog, "halfpixel");
+        shaders->m_shBLUR2.uniformLocations[SHADER_BLUR_FINISH] = glGetUniformLocation(prog, "finish");
+        shaders->m_shBLUR2.uniformLocations[SHADER_NOISE]       = glGetUniformLocation(prog, "noise");
+        shaders->m_shBLUR2.uniformLocations[SHADER_BRIGHTNESS]  = glGetUniformLocation(prog, "brightness");
         shaders->m_shBLUR2.createVao();
 
-        prog = createProgram(shaders->TEXVERTSRC, FRAGBLURPREPARE, isDynamic);
-        if (!prog)
-            return false;
-        shaders->m_shBLURPREPARE.program = prog;
-        getCMShaderUniforms(shaders->m_shBLURPREPARE);
-
-        shaders->m_shBLURPREPARE.uniformLocations[SHADER_TEX]        = glGetUniformLocation(prog, "tex");
-        shaders->m_shBLURPREPARE.uniformLocations[SHADER_PROJ]       = glGetUniformLocation(prog, "proj");
-        shaders->m_shBLURPREPARE.uniformLocations[SHADER_POS_ATTRIB] = glGetAttribLocation(prog, "pos");
-        shaders->m_shBLURPREPARE.uniformLocations[SHADER_TEX_ATTRIB] = glGetAttribLocation(prog, "texcoord");
-        shaders->m_shBLURPREPARE.uniformLocations[SHADER_CONTRAST]   = glGetUniformLocation(prog, "contrast");
-        shaders->m_shBLURPREPARE.uniformLocations[SHADER_BRIGHTNESS] = glGetUniformLocation(prog, "brightness");
-        shaders->m_shBLURPREPARE.createVao();
-
-        prog = createProgram(shaders->TEXVERTSRC, FRAGBLURFINISH, isDynamic);
-        if (!prog)
-            return false;
-        shaders->m_shBLURFINISH.program = prog;
-        // getCMShaderUniforms(shaders->m_shBLURFINISH);
-
-        shaders->m_shBLURFINISH.uniformLocations[SHADER_TEX]        = glGetUniformLocation(prog, "tex");
-        shaders->m_shBLURFINISH.uniformLocations[SHADER_PROJ]       = glGetUniformLocation(prog, "proj");
-        shaders->m_shBLURFINISH.uniformLocations[SHADER_POS_ATTRIB] = glGetAttribLocation(prog, "pos");
-        shaders->m_shBLURFINISH.uniformLocations[SHADER_TEX_ATTRIB] = glGetAttribLocation(prog, "texcoord");
-        shaders->m_shBLURFINISH.uniformLocations[SHADER_BRIGHTNESS] = glGetUniformLocation(prog, "brightness");
-        shaders->m_shBLURFINISH.uniformLocations[SHADER_NOISE]      = glGetUniformLocation(prog, "noise");
-        shaders->m_shBLURFINISH.createVao();
-
         prog = createProgram(shaders->TEXVERTSRC, FRAGSHADOW, isDynamic);
         if (!prog)
             return false;
@@ -1245,6 +1244,16 @@ bool CHyprOpenGLImpl::initShaders() {
         shaders->m_shBORDER1.uniformLocations[SHADER_ALPHA]                   = glGetUniformLocation(prog, "alpha");
         shaders->m_shBORDER1.createVao();
 
+        // attributes are at fixed locations and the vao belongs to CTextRenderer, it feeds one instance per glyph
+        prog = createProgram(processShader("glyph.vert", includes), processShader("glyph.frag", includes), true, true);
+        if (prog) {
+            shaders->m_shGLYPH.program                            = prog;
+            shaders->m_shGLYPH.uniformLocations[SHADER_TEX]       = glGetUniformLocation(prog, "tex");
+            shaders->m_shGLYPH.uniformLocations[SHADER_COLOR]     = glGetUniformLocation(prog, "color");
+            shaders->m_shGLYPH.uniformLocations[SHADER_FULL_SIZE] = glGetUniformLocation(prog, "fullSize");
+        } else
+            Debug::log(ERR, "Glyph shader failed compiling, text will be rasterized with cairo");
+
     } catch (const std::exception& e) {
         if (!m_shadersInitialized)
             throw e;
@@ -1256,10 +1265,63 @@ bool CHyprOpenGLImpl::initShaders() {
     m_shaders            = shaders;
     m_shadersInitialized = true;
 
-    Debug::log(LOG, "Shaders initialized successfully.");
+    Debug::log(LOG, "Shaders initialized successfully in {:.2f}ms, {} programs from the cache, {} compiled", timer.getMillis(), m_programCache->m_stats.hits - STATS.hits,
+               m_programCache->m_stats.misses - STATS.misses);
     return true;
 }
 
+SShader* CHyprOpenGLImpl::getSurfaceShader(uint32_t features) {
+    if (const auto IT = m_shaders->m_shSurfaceVariants.find(features); IT != m_shaders->m_shSurfaceVariants.end())
+        return IT->second.program ? &IT->second : nullptr;
+
+    std::string defines;
+    if (features & SURFACE_SHADER_RGBX)
+        defines += "#define TEX_RGBX\n";
+    if (features & SURFACE_SHADER_DISCARD_OPAQUE)
+        defines += "#define DISCARD_OPAQUE\n";
+    if (features & SURFACE_SHADER_DISCARD_ALPHA)
+        defines += "#define DISCARD_ALPHA\n";
+    if (features & SURFACE_SHADER_TINT)
+        defines += "#define APPLY_TINT\n";
+    if (features & SURFACE_SHADER_ROUNDING)
+        defines += "#define ROUNDING\n";
+    if (features & SURFACE_SHADER_CM)
+        defines += std::format("#define USE_CM\n#define SOURCE_TF {}\n#define TARGET_TF {}\n", (features >> SURFACE_SHADER_SOURCE_TF_SHIFT) & 0xFF,
+                               (features >> SURFACE_SHADER_TARGET_TF_SHIFT) & 0xFF);
+
+    // defines have to come after #version
+    auto       source = m_shaders->TEXFRAGSRCSURFACE;
+    const auto EOL    = source.find('\n');
+    source.insert(EOL + 1, defines);
+
+    CTimer timer;
+    timer.reset();
+
+    auto&      shader = m_shaders->m_shSurfaceVariants[features];
+    const auto PROG   = createProgram(m_shaders->TEXVERTSRC, source, true, true);
+
+    if (!PROG) {
+        Debug::log(ERR, "Surface shader variant {:#x} failed to compile, falling back to the generic shaders for it", features);
+        return nullptr;
+    }
+
+    shader.program = PROG;
+    getCMShaderUniforms(shader);
+    getRoundingShaderUniforms(shader);
+    shader.uniformLocations[SHADER_PROJ]                = glGetUniformLocation(PROG, "proj");
+    shader.uniformLocations[SHADER_TEX]                 = glGetUniformLocation(PROG, "tex");
+    shader.uniformLocations[SHADER_ALPHA]               = glGetUniformLocation(PROG, "alpha");
+    shader.uniformLocations[SHADER_TEX_ATTRIB]          = glGetAttribLocation(PROG, "texcoord");
+    shader.uniformLocations[SHADER_POS_ATTRIB]          = glGetAttribLocation(PROG, "pos");
+    shader.uniformLocations[SHADER_DISCARD_ALPHA_VALUE] = glGetUniformLocation(PROG, "discardAlphaValue");
+    shader.uniformLocations[SHADER_TINT]                = glGetUniformLocation(PROG, "tint");
+    shader.createVao();
+
+    Debug::log(LOG, "Surface shader variant {:#x} ready in {:.2f}ms ({} variants)", features, timer.getMillis(), m_shaders->m_shSurfaceVariants.size());
+
+    return &shader;
+}
+
 void CHyprOpenGLImpl::applyScreenShader(const std::string& path) {
 
     static auto PDT = CConfigValue<Hyprlang::INT>("debug:damage_tracking");
@@ -1419,6 +1481,82 @@ void CHyprOpenGLImpl::scissor(const int x, const int y, const int w, const int h
     scissor(box, transform);
 }
 
+void CHyprOpenGLImpl::drawDamage(SShader& shader, const Mat3x3& proj, const CRegion& damage, bool transform, const Vector2D& uvTopLeft, const Vector2D& uvBottomRight) {
+    static auto PBATCHTHRESHOLD = CConfigValue<Hyprlang::INT>("render:damage_batch_threshold");
+
+    const auto  RECTS = damage.getRects();
+
+    if (RECTS.empty())
+        return;
+
+    m_damageDrawStats.rects += RECTS.size();
+
+    // proj takes the unit quad to clip space, this takes it on to framebuffer pixels: px = A * x + B * y + C, py = D * x + E * y + F
+    const auto  M  = proj.getMatrix();
+    const float HW = m_lastViewport.width / 2.F, HH = m_lastViewport.height / 2.F;
+    const float A  = M[0] * HW, B = M[1] * HW, C = ((M[2] + 1.F) * HW) + m_lastViewport.x;
+    const float D  = M[3] * HH, E = M[4] * HH, F = ((M[5] + 1.F) * HH) + m_lastViewport.y;
+
+    // the quad can only be cut into rects when it's axis aligned, possibly with x and y swapped
+    const bool STRAIGHT = std::abs(B) < 1e-6F && std::abs(D) < 1e-6F;
+    const bool SWAPPED  = !STRAIGHT && std::abs(A) < 1e-6F && std::abs(E) < 1e-6F;
+
+    if (*PBATCHTHRESHOLD <= 0 || sc<int64_t>(RECTS.size()) < *PBATCHTHRESHOLD || (!STRAIGHT && !SWAPPED)) {
+        glBindVertexArray(shader.uniformLocations[SHADER_SHADER_VAO]);
+
+        for (const auto& RECT : RECTS) {
+            scissor(&RECT, transform);
+            glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+        }
+
+        glBindVertexArray(0);
+
+        m_damageDrawStats.draws += RECTS.size();
+        return;
+    }
+
+    // cut the quad into one piece per rect and draw all of them at once, without scissoring
+    const auto UNPROJECT = [](double from, double to, float scale, float offset) {
+        const double P1 = (from - offset) / scale, P2 = (to - offset) / scale;
+        return std::pair{std::clamp(std::min(P1, P2), 0.0, 1.0), std::clamp(std::max(P1, P2), 0.0, 1.0)};
+    };
+
+    const auto UVSIZE = uvBottomRight - uvTopLeft;
+
+    m_batchVerts.clear();
+
+    for (const auto& RECT : RECTS) {
+        CBox box = {RECT.x1, RECT.y1, RECT.x2 - RECT.x1, RECT.y2 - RECT.y1};
+        if (transform)
+            box.transform(wlTransformToHyprutils(invertTransform(m_renderData.pMonitor->m_transform)), m_renderData.pMonitor->m_transformedSize.x,
+                          m_renderData.pMonitor->m_transformedSize.y);
+
+        const auto [X1, X2] = STRAIGHT ? UNPROJECT(box.x, box.x + box.width, A, C) : UNPROJECT(box.y, box.y + box.height, D, F);
+        const auto [Y1, Y2] = STRAIGHT ? UNPROJECT(box.y, box.y + box.height, E, F) : UNPROJECT(box.x, box.x + box.width, B, C);
+
+        if (X1 >= X2 || Y1 >= Y2)
+            continue;
+
+        for (const auto& [X, Y] : {std::pair{X1, Y1}, std::pair{X2, Y1}, std::pair{X1, Y2}, std::pair{X2, Y1}, std::pair{X2, Y2}, std::pair{X1, Y2}}) {
+            m_batchVerts.insert(m_batchVerts.end(), {sc<GLfloat>(X), sc<GLfloat>(Y), sc<GLfloat>(uvTopLeft.x + (X * UVSIZE.x)), sc<GLfloat>(uvTopLeft.y + (Y * UVSIZE.y))});
+        }
+    }
+
+    if (m_batchVerts.empty())
+        return;
+
+    scissor(nullptr);
+
+    glBindVertexArray(shader.uniformLocations[SHADER_SHADER_VAO_BATCH]);
+    glBindBuffer(GL_ARRAY_BUFFER, shader.uniformLocations[SHADER_SHADER_VBO_BATCH]);
+    glBufferData(GL_ARRAY_BUFFER, m_batchVerts.size() * sizeof(GLfloat), m_batchVerts.data(), GL_STREAM_DRAW);
+    glDrawArrays(GL_TRIANGLES, 0, m_batchVerts.size() / 4);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+
+    m_damageDrawStats.draws++;
+}
+
 void CHyprOpenGLImpl::renderRect(const CBox& box, const CHyprColor& col, SRectRenderData data) {
     if (!data.damage)
         data.damage = &m_renderData.damage;
@@ -1509,26 +1647,14 @@ void CHyprOpenGLImpl::renderRectWithDamageInternal(const CBox& box, const CHyprC
     m_shaders->m_shQUAD.setUniformFloat(SHADER_RADIUS, data.round);
     m_shaders->m_shQUAD.setUniformFloat(SHADER_ROUNDING_POWER, data.roundingPower);
 
-    glBindVertexArray(m_shaders->m_shQUAD.uniformLocations[SHADER_SHADER_VAO]);
-
     if (m_renderData.clipBox.width != 0 && m_renderData.clipBox.height != 0) {
         CRegion damageClip{m_renderData.clipBox.x, m_renderData.clipBox.y, m_renderData.clipBox.width, m_renderData.clipBox.height};
         damageClip.intersect(*data.damage);
 
-        if (!damageClip.empty()) {
-            damageClip.forEachRect([this](const auto& RECT) {
-                scissor(&RECT);
-                glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-            });
-        }
-    } else {
-        data.damage->forEachRect([this](const auto& RECT) {
-            scissor(&RECT);
-            glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-        });
-    }
+        drawDamage(m_shaders->m_shQUAD, glMatrix, damageClip);
+    } else
+        drawDamage(m_shaders->m_shQUAD, glMatrix, *data.damage);
 
-    glBindVertexArray(0);
     scissor(nullptr);
 }
 
@@ -1560,18 +1686,21 @@ static bool isSDR2HDR(const NColorManagement::SImageDescription& imageDescriptio
          targetImageDescription.transferFunction == NColorManagement::CM_TRANSFER_FUNCTION_HLG);
 }
 
-void CHyprOpenGLImpl::passCMUniforms(SShader& shader, const NColorManagement::SImageDescription& imageDescription,
-                                     const NColorManagement::SImageDescription& targetImageDescription, bool modifySDR, float sdrMinLuminance, int sdrMaxLuminance) {
+NColorManagement::eTransferFunction CHyprOpenGLImpl::getCMSourceTF(const NColorManagement::SImageDescription& imageDescription) {
     static auto PSDREOTF = CConfigValue<Hyprlang::INT>("render:cm_sdr_eotf");
 
     if (m_renderData.surface.valid() &&
         ((!m_renderData.surface->m_colorManagement.valid() && *PSDREOTF >= 1) ||
          (*PSDREOTF == 2 && m_renderData.surface->m_colorManagement.valid() &&
-          imageDescription.transferFunction == NColorManagement::eTransferFunction::CM_TRANSFER_FUNCTION_SRGB))) {
-        shader.setUniformInt(SHADER_SOURCE_TF, NColorManagement::eTransferFunction::CM_TRANSFER_FUNCTION_GAMMA22);
-    } else
-        shader.setUniformInt(SHADER_SOURCE_TF, imageDescription.transferFunction);
+          imageDescription.transferFunction == NColorManagement::eTransferFunction::CM_TRANSFER_FUNCTION_SRGB)))
+        return NColorManagement::eTransferFunction::CM_TRANSFER_FUNCTION_GAMMA22;
+
+    return imageDescription.transferFunction;
+}
 
+void CHyprOpenGLImpl::passCMUniforms(SShader& shader, const NColorManagement::SImageDescription& imageDescription,
+                                     const NColorManagement::SImageDescription& targetImageDescription, bool modifySDR, float sdrMinLuminance, int sdrMaxLuminance) {
+    shader.setUniformInt(SHADER_SOURCE_TF, getCMSourceTF(imageDescription));
     shader.setUniformInt(SHADER_TARGET_TF, targetImageDescription.transferFunction);
 
     const auto                   targetPrimaries = targetImageDescription.primariesNameSet || targetImageDescription.primaries == SPCPRimaries{} ?
@@ -1702,20 +1831,58 @@ void CHyprOpenGLImpl::renderTextureInternal(SP<CTexture> tex, const CBox& box, c
         || (imageDescription == m_renderData.pMonitor->m_imageDescription && !data.cmBackToSRGB) /* Source and target have the same image description */
         || (((*PPASS && canPassHDRSurface) || (*PPASS == 1 && !isHDRSurface)) && m_renderData.pMonitor->inFullscreenMode()) /* Fullscreen window with pass cm enabled */;
 
-    if (!skipCM && !usingFinalShader && (texType == TEXTURE_RGBA || texType == TEXTURE_RGBX))
+    const bool SURFACETEX = !usingFinalShader && (texType == TEXTURE_RGBA || texType == TEXTURE_RGBX);
+    const bool USECM      = SURFACETEX && !skipCM;
+
+    if (USECM)
         shader = &m_shaders->m_shCM;
 
+    static auto PSDREOTF      = CConfigValue<Hyprlang::INT>("render:cm_sdr_eotf");
+    const auto  SDREOTF       = *PSDREOTF > 0 ? NColorManagement::CM_TRANSFER_FUNCTION_GAMMA22 : NColorManagement::CM_TRANSFER_FUNCTION_SRGB;
+    const bool  DISCARDOPAQUE = data.discardActive && (m_renderData.discardMode & DISCARD_OPAQUE);
+    const bool  DISCARDALPHA  = data.discardActive && (m_renderData.discardMode & DISCARD_ALPHA);
+
+    float       dim = 0.F;
+    if (data.allowDim && m_renderData.currentWindow) {
+        if (m_renderData.currentWindow->m_notRespondingTint->value() > 0)
+            dim = m_renderData.currentWindow->m_notRespondingTint->value();
+        else if (m_renderData.currentWindow->m_dimPercent->value() > 0)
+            dim = m_renderData.currentWindow->m_dimPercent->value();
+    }
+
+    if (SURFACETEX && m_useSurfaceVariants) {
+        uint32_t features = 0;
+
+        if (texType == TEXTURE_RGBX)
+            features |= SURFACE_SHADER_RGBX;
+        if (DISCARDOPAQUE)
+            features |= SURFACE_SHADER_DISCARD_OPAQUE;
+        // rgbx.frag never discarded on alpha, CM.frag did for both
+        if (DISCARDALPHA && (texType == TEXTURE_RGBA || USECM))
+            features |= SURFACE_SHADER_DISCARD_ALPHA;
+        if (dim > 0)
+            features |= SURFACE_SHADER_TINT;
+        if (data.round > 0)
+            features |= SURFACE_SHADER_ROUNDING;
+        if (USECM) {
+            const auto TARGETTF = data.cmBackToSRGB ? SDREOTF : m_renderData.pMonitor->m_imageDescription.transferFunction;
+            features |= SURFACE_SHADER_CM | (sc<uint32_t>(getCMSourceTF(imageDescription)) << SURFACE_SHADER_SOURCE_TF_SHIFT) |
+                (sc<uint32_t>(TARGETTF) << SURFACE_SHADER_TARGET_TF_SHIFT);
+        }
+
+        if (const auto VARIANT = getSurfaceShader(features); VARIANT)
+            shader = VARIANT;
+    }
+
     useProgram(shader->program);
 
-    if (shader == &m_shaders->m_shCM) {
+    if (USECM) {
         shader->setUniformInt(SHADER_TEX_TYPE, texType);
         if (data.cmBackToSRGB) {
             // revert luma changes to avoid black screenshots.
             // this will likely not be 1:1, and might cause screenshots to be too bright, but it's better than pitch black.
             imageDescription.luminances = {};
-            static auto PSDREOTF        = CConfigValue<Hyprlang::INT>("render:cm_sdr_eotf");
-            auto        chosenSdrEotf   = *PSDREOTF > 0 ? NColorManagement::CM_TRANSFER_FUNCTION_GAMMA22 : NColorManagement::CM_TRANSFER_FUNCTION_SRGB;
-            passCMUniforms(*shader, imageDescription, NColorManagement::SImageDescription{.transferFunction = chosenSdrEotf}, true, -1, -1);
+            passCMUniforms(*shader, imageDescription, NColorManagement::SImageDescription{.transferFunction = SDREOTF}, true, -1, -1);
         } else
             passCMUniforms(*shader, imageDescription);
     }
@@ -1787,14 +1954,10 @@ void CHyprOpenGLImpl::renderTextureInternal(SP<CTexture> tex, const CBox& box, c
     if (!usingFinalShader) {
         shader->setUniformFloat(SHADER_ALPHA, alpha);
 
-        if (data.discardActive) {
-            shader->setUniformInt(SHADER_DISCARD_OPAQUE, !!(m_renderData.discardMode & DISCARD_OPAQUE));
-            shader->setUniformInt(SHADER_DISCARD_ALPHA, !!(m_renderData.discardMode & DISCARD_ALPHA));
+        shader->setUniformInt(SHADER_DISCARD_OPAQUE, DISCARDOPAQUE);
+        shader->setUniformInt(SHADER_DISCARD_ALPHA, DISCARDALPHA);
+        if (data.discardActive)
             shader->setUniformFloat(SHADER_DISCARD_ALPHA_VALUE, m_renderData.discardOpacity);
-        } else {
-            shader->setUniformInt(SHADER_DISCARD_OPAQUE, 0);
-            shader->setUniformInt(SHADER_DISCARD_ALPHA, 0);
-        }
     }
 
     CBox transformedBox = newBox;
@@ -1811,23 +1974,13 @@ void CHyprOpenGLImpl::renderTextureInternal(SP<CTexture> tex, const CBox& box, c
         shader->setUniformFloat(SHADER_RADIUS, data.round);
         shader->setUniformFloat(SHADER_ROUNDING_POWER, data.roundingPower);
 
-        if (data.allowDim && m_renderData.currentWindow) {
-            if (m_renderData.currentWindow->m_notRespondingTint->value() > 0) {
-                const auto DIM = m_renderData.currentWindow->m_notRespondingTint->value();
-                shader->setUniformInt(SHADER_APPLY_TINT, 1);
-                shader->setUniformFloat3(SHADER_TINT, 1.f - DIM, 1.f - DIM, 1.f - DIM);
-            } else if (m_renderData.currentWindow->m_dimPercent->value() > 0) {
-                shader->setUniformInt(SHADER_APPLY_TINT, 1);
-                const auto DIM = m_renderData.currentWindow->m_dimPercent->value();
-                shader->setUniformFloat3(SHADER_TINT, 1.f - DIM, 1.f - DIM, 1.f - DIM);
-            } else
-                shader->setUniformInt(SHADER_APPLY_TINT, 0);
-        } else
-            shader->setUniformInt(SHADER_APPLY_TINT, 0);
+        shader->setUniformInt(SHADER_APPLY_TINT, dim > 0);
+        if (dim > 0)
+            shader->setUniformFloat3(SHADER_TINT, 1.f - dim, 1.f - dim, 1.f - dim);
     }
 
-    glBindVertexArray(shader->uniformLocations[SHADER_SHADER_VAO]);
-    if (data.allowCustomUV && m_renderData.primarySurfaceUVTopLeft != Vector2D(-1, -1)) {
+    const bool CUSTOMUV = data.allowCustomUV && m_renderData.primarySurfaceUVTopLeft != Vector2D(-1, -1);
+    if (CUSTOMUV) {
         const float customUVs[] = {
             m_renderData.primarySurfaceUVBottomRight.x, m_renderData.primarySurfaceUVTopLeft.y,     m_renderData.primarySurfaceUVTopLeft.x,
             m_renderData.primarySurfaceUVTopLeft.y,     m_renderData.primarySurfaceUVBottomRight.x, m_renderData.primarySurfaceUVBottomRight.y,
@@ -1841,6 +1994,9 @@ void CHyprOpenGLImpl::renderTextureInternal(SP<CTexture> tex, const CBox& box, c
         glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(fullVerts), fullVerts);
     }
 
+    const auto UVTOPLEFT     = CUSTOMUV ? m_renderData.primarySurfaceUVTopLeft : Vector2D{0, 0};
+    const auto UVBOTTOMRIGHT = CUSTOMUV ? m_renderData.primarySurfaceUVBottomRight : Vector2D{1, 1};
+
     if (!m_renderData.clipBox.empty() || !m_renderData.clipRegion.empty()) {
         CRegion damageClip = m_renderData.clipBox;
 
@@ -1851,20 +2007,10 @@ void CHyprOpenGLImpl::renderTextureInternal(SP<CTexture> tex, const CBox& box, c
                 damageClip.intersect(m_renderData.clipRegion);
         }
 
-        if (!damageClip.empty()) {
-            damageClip.forEachRect([this](const auto& RECT) {
-                scissor(&RECT);
-                glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-            });
-        }
-    } else {
-        data.damage->forEachRect([this](const auto& RECT) {
-            scissor(&RECT);
-            glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-        });
-    }
+        drawDamage(*shader, glMatrix, damageClip, true, UVTOPLEFT, UVBOTTOMRIGHT);
+    } else
+        drawDamage(*shader, glMatrix, *data.damage, true, UVTOPLEFT, UVBOTTOMRIGHT);
 
-    glBindVertexArray(0);
     glBindBuffer(GL_ARRAY_BUFFER, 0);
     tex->unbind();
 }
@@ -1904,15 +2050,10 @@ void CHyprOpenGLImpl::renderTexturePrimitive(SP<CTexture> tex, const CBox& box)
     useProgram(shader->program);
     shader->setUniformMatrix3fv(SHADER_PROJ, 1, GL_TRUE, glMatrix.getMatrix());
     shader->setUniformInt(SHADER_TEX, 0);
-    glBindVertexArray(shader->uniformLocations[SHADER_SHADER_VAO]);
 
-    m_renderData.damage.forEachRect([this](const auto& RECT) {
-        scissor(&RECT);
-        glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-    });
+    drawDamage(*shader, glMatrix, m_renderData.damage);
 
     scissor(nullptr);
-    glBindVertexArray(0);
     tex->unbind();
 }
 
@@ -1947,15 +2088,9 @@ void CHyprOpenGLImpl::renderTextureMatte(SP<CTexture> tex, const CBox& box, CFra
     auto matteTex = matte.getTexture();
     matteTex->bind();
 
-    glBindVertexArray(shader->uniformLocations[SHADER_SHADER_VAO]);
-
-    m_renderData.damage.forEachRect([this](const auto& RECT) {
-        scissor(&RECT);
-        glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-    });
+    drawDamage(*shader, glMatrix, m_renderData.damage);
 
     scissor(nullptr);
-    glBindVertexArray(0);
     tex->unbind();
 }
 
@@ -1990,6 +2125,9 @@ CFramebuffer* CHyprOpenGLImpl::blurFramebufferWithDamage(float a, CRegion* origi
     static auto PBLURPASSES           = CConfigValue<Hyprlang::INT>("decoration:blur:passes");
     static auto PBLURVIBRANCY         = CConfigValue<Hyprlang::FLOAT>("decoration:blur:vibrancy");
     static auto PBLURVIBRANCYDARKNESS = CConfigValue<Hyprlang::FLOAT>("decoration:blur:vibrancy_darkness");
+    static auto PBLURCONTRAST         = CConfigValue<Hyprlang::FLOAT>("decoration:blur:contrast");
+    static auto PBLURBRIGHTNESS       = CConfigValue<Hyprlang::FLOAT>("decoration:blur:brightness");
+    static auto PBLURNOISE            = CConfigValue<Hyprlang::FLOAT>("decoration:blur:noise");
 
     const auto  BLUR_PASSES = std::clamp(*PBLURPASSES, sc<int64_t>(1), sc<int64_t>(8));
 
@@ -2000,176 +2138,95 @@ CFramebuffer* CHyprOpenGLImpl::blurFramebufferWithDamage(float a, CRegion* origi
     damage.expand(std::clamp(*PBLURSIZE, sc<int64_t>(1), sc<int64_t>(40)) * pow(2, BLUR_PASSES));
 
     // helper
-    const auto    PMIRRORFB     = &m_renderData.pCurrentMonData->mirrorFB;
-    const auto    PMIRRORSWAPFB = &m_renderData.pCurrentMonData->mirrorSwapFB;
-
-    CFramebuffer* currentRenderToFB = PMIRRORFB;
-
-    // Begin with base color adjustments - global brightness and contrast
-    // TODO: make this a part of the first pass maybe to save on a drawcall?
-    {
-        static auto PBLURCONTRAST   = CConfigValue<Hyprlang::FLOAT>("decoration:blur:contrast");
-        static auto PBLURBRIGHTNESS = CConfigValue<Hyprlang::FLOAT>("decoration:blur:brightness");
-
-        PMIRRORSWAPFB->bind();
-
-        glActiveTexture(GL_TEXTURE0);
-
-        auto currentTex = source.getTexture();
-
-        currentTex->bind();
-        currentTex->setTexParameter(GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-
-        useProgram(m_shaders->m_shBLURPREPARE.program);
-
-        // From FB to sRGB
-        const bool skipCM = !m_cmSupported || m_renderData.pMonitor->m_imageDescription == SImageDescription{};
-        m_shaders->m_shBLURPREPARE.setUniformInt(SHADER_SKIP_CM, skipCM);
-        if (!skipCM) {
-            passCMUniforms(m_shaders->m_shBLURPREPARE, m_renderData.pMonitor->m_imageDescription, SImageDescription{});
-            m_shaders->m_shBLURPREPARE.setUniformFloat(SHADER_SDR_SATURATION,
-                                                       m_renderData.pMonitor->m_sdrSaturation > 0 &&
-                                                               m_renderData.pMonitor->m_imageDescription.transferFunction == NColorManagement::CM_TRANSFER_FUNCTION_ST2084_PQ ?
-                                                           m_renderData.pMonitor->m_sdrSaturation :
-                                                           1.0f);
-            m_shaders->m_shBLURPREPARE.setUniformFloat(SHADER_SDR_BRIGHTNESS,
-                                                       m_renderData.pMonitor->m_sdrBrightness > 0 &&
-                                                               m_renderData.pMonitor->m_imageDescription.transferFunction == NColorManagement::CM_TRANSFER_FUNCTION_ST2084_PQ ?
-                                                           m_renderData.pMonitor->m_sdrBrightness :
-                                                           1.0f);
-        }
-
-        m_shaders->m_shBLURPREPARE.setUniformMatrix3fv(SHADER_PROJ, 1, GL_TRUE, glMatrix.getMatrix());
-        m_shaders->m_shBLURPREPARE.setUniformFloat(SHADER_CONTRAST, *PBLURCONTRAST);
-        m_shaders->m_shBLURPREPARE.setUniformFloat(SHADER_BRIGHTNESS, *PBLURBRIGHTNESS);
-        m_shaders->m_shBLURPREPARE.setUniformInt(SHADER_TEX, 0);
-
-        glBindVertexArray(m_shaders->m_shBLURPREPARE.uniformLocations[SHADER_SHADER_VAO]);
-
-        if (!damage.empty()) {
-            damage.forEachRect([this](const auto& RECT) {
-                scissor(&RECT, false /* this region is already transformed */);
-                glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-            });
-        }
+    const auto PMIRRORFB = &m_renderData.pCurrentMonData->mirrorFB;
+    const auto FULLSIZE  = m_renderData.pMonitor->m_pixelSize;
+    auto&      mips      = m_renderData.pCurrentMonData->blurMipFBs;
 
-        glBindVertexArray(0);
-        currentRenderToFB = PMIRRORSWAPFB;
+    // mips[i] is 1 / 2^(i + 1) of the monitor's size. Passes go down the chain and back up, so
+    // every pass only touches as many pixels as its level has, and the last one lands in mirrorFB.
+    for (auto i = 0; i < BLUR_PASSES; ++i) {
+        const Vector2D SIZE = {std::max(1.0, std::ceil(FULLSIZE.x / (2 << i))), std::max(1.0, std::ceil(FULLSIZE.y / (2 << i)))};
+        if (mips[i].m_size != SIZE || mips[i].m_drmFormat != PMIRRORFB->m_drmFormat)
+            mips[i].alloc(SIZE.x, SIZE.y, PMIRRORFB->m_drmFormat);
     }
 
     // declare the draw func
-    auto drawPass = [&](SShader* pShader, CRegion* pDamage) {
-        if (currentRenderToFB == PMIRRORFB)
-            PMIRRORSWAPFB->bind();
-        else
-            PMIRRORFB->bind();
+    auto drawPass = [&](SShader* pShader, CFramebuffer& from, CFramebuffer& to) {
+        to.bind();
+        setViewport(0, 0, to.m_size.x, to.m_size.y);
 
         glActiveTexture(GL_TEXTURE0);
 
-        auto currentTex = currentRenderToFB->getTexture();
+        auto currentTex = from.getTexture();
 
         currentTex->bind();
 
         currentTex->setTexParameter(GL_TEXTURE_MIN_FILTER, GL_LINEAR);
 
-        useProgram(pShader->program);
-
-        // prep two shaders
         pShader->setUniformMatrix3fv(SHADER_PROJ, 1, GL_TRUE, glMatrix.getMatrix());
-        pShader->setUniformFloat(SHADER_RADIUS, *PBLURSIZE * a); // this makes the blursize change with a
-        if (pShader == &m_shaders->m_shBLUR1) {
-            m_shaders->m_shBLUR1.setUniformFloat2(SHADER_HALFPIXEL, 0.5f / (m_renderData.pMonitor->m_pixelSize.x / 2.f), 0.5f / (m_renderData.pMonitor->m_pixelSize.y / 2.f));
-            m_shaders->m_shBLUR1.setUniformInt(SHADER_PASSES, BLUR_PASSES);
-            m_shaders->m_shBLUR1.setUniformFloat(SHADER_VIBRANCY, *PBLURVIBRANCY);
-            m_shaders->m_shBLUR1.setUniformFloat(SHADER_VIBRANCY_DARKNESS, *PBLURVIBRANCYDARKNESS);
-        } else
-            m_shaders->m_shBLUR2.setUniformFloat2(SHADER_HALFPIXEL, 0.5f / (m_renderData.pMonitor->m_pixelSize.x * 2.f), 0.5f / (m_renderData.pMonitor->m_pixelSize.y * 2.f));
         pShader->setUniformInt(SHADER_TEX, 0);
 
-        glBindVertexArray(pShader->uniformLocations[SHADER_SHADER_VAO]);
-
-        if (!pDamage->empty()) {
-            pDamage->forEachRect([this](const auto& RECT) {
-                scissor(&RECT, false /* this region is already transformed */);
-                glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-            });
-        }
-
-        glBindVertexArray(0);
+        // scale to the target's actual size, the mips are rounded up
+        CRegion passDamage = damage.copy().scale({to.m_size.x / FULLSIZE.x, to.m_size.y / FULLSIZE.y});
+        passDamage.expand(1);
 
-        if (currentRenderToFB != PMIRRORFB)
-            currentRenderToFB = PMIRRORFB;
-        else
-            currentRenderToFB = PMIRRORSWAPFB;
+        drawDamage(*pShader, glMatrix, passDamage, false /* this region is already transformed */);
     };
 
-    // draw the things.
-    // first draw is swap -> mirr
-    PMIRRORFB->bind();
-    PMIRRORSWAPFB->getTexture()->bind();
+    // down. The first pass also does the base color adjustments - global brightness and contrast
+    useProgram(m_shaders->m_shBLUR1.program);
 
-    // damage region will be scaled, make a temp
-    CRegion tempDamage{damage};
-
-    // and draw
-    for (auto i = 1; i <= BLUR_PASSES; ++i) {
-        tempDamage = damage.copy().scale(1.f / (1 << i));
-        drawPass(&m_shaders->m_shBLUR1, &tempDamage); // down
-    }
+    // From FB to sRGB
+    const bool skipCM = !m_cmSupported || m_renderData.pMonitor->m_imageDescription == SImageDescription{};
+    m_shaders->m_shBLUR1.setUniformInt(SHADER_SKIP_CM, skipCM);
+    if (!skipCM) {
+        passCMUniforms(m_shaders->m_shBLUR1, m_renderData.pMonitor->m_imageDescription, SImageDescription{});
+        m_shaders->m_shBLUR1.setUniformFloat(SHADER_SDR_SATURATION,
+                                             m_renderData.pMonitor->m_sdrSaturation > 0 &&
+                                                     m_renderData.pMonitor->m_imageDescription.transferFunction == NColorManagement::CM_TRANSFER_FUNCTION_ST2084_PQ ?
+                                                 m_renderData.pMonitor->m_sdrSaturation :
+                                                 1.0f);
+        m_shaders->m_shBLUR1.setUniformFloat(SHADER_SDR_BRIGHTNESS,
+                                             m_renderData.pMonitor->m_sdrBrightness > 0 &&
+                                                     m_renderData.pMonitor->m_imageDescription.transferFunction == NColorManagement::CM_TRANSFER_FUNCTION_ST2084_PQ ?
+                                                 m_renderData.pMonitor->m_sdrBrightness :
+                                                 1.0f);
+    }
+
+    m_shaders->m_shBLUR1.setUniformFloat(SHADER_CONTRAST, *PBLURCONTRAST);
+    m_shaders->m_shBLUR1.setUniformFloat(SHADER_BRIGHTNESS, *PBLURBRIGHTNESS);
+    m_shaders->m_shBLUR1.setUniformFloat(SHADER_RADIUS, *PBLURSIZE * a); // this makes the blursize change with a
+    m_shaders->m_shBLUR1.setUniformInt(SHADER_PASSES, BLUR_PASSES);
+    m_shaders->m_shBLUR1.setUniformFloat(SHADER_VIBRANCY, *PBLURVIBRANCY);
+    m_shaders->m_shBLUR1.setUniformFloat(SHADER_VIBRANCY_DARKNESS, *PBLURVIBRANCYDARKNESS);
+
+    for (auto i = 0; i < BLUR_PASSES; ++i) {
+        auto& from = i == 0 ? source : mips[i - 1];
+        m_shaders->m_shBLUR1.setUniformInt(SHADER_BLUR_PREPARE, i == 0);
+        m_shaders->m_shBLUR1.setUniformFloat2(SHADER_HALFPIXEL, 0.5f / (from.m_size.x / 2.f), 0.5f / (from.m_size.y / 2.f));
+        drawPass(&m_shaders->m_shBLUR1, from, mips[i]);
+    }
+
+    // up. The last pass also adds the noise and darkens
+    useProgram(m_shaders->m_shBLUR2.program);
+
+    m_shaders->m_shBLUR2.setUniformFloat(SHADER_RADIUS, *PBLURSIZE * a);
+    m_shaders->m_shBLUR2.setUniformFloat(SHADER_NOISE, *PBLURNOISE);
+    m_shaders->m_shBLUR2.setUniformFloat(SHADER_BRIGHTNESS, *PBLURBRIGHTNESS);
 
     for (auto i = BLUR_PASSES - 1; i >= 0; --i) {
-        tempDamage = damage.copy().scale(1.f / (1 << i)); // when upsampling we make the region twice as big
-        drawPass(&m_shaders->m_shBLUR2, &tempDamage);     // up
-    }
-
-    // finalize the image
-    {
-        static auto PBLURNOISE      = CConfigValue<Hyprlang::FLOAT>("decoration:blur:noise");
-        static auto PBLURBRIGHTNESS = CConfigValue<Hyprlang::FLOAT>("decoration:blur:brightness");
-
-        if (currentRenderToFB == PMIRRORFB)
-            PMIRRORSWAPFB->bind();
-        else
-            PMIRRORFB->bind();
-
-        glActiveTexture(GL_TEXTURE0);
-
-        auto currentTex = currentRenderToFB->getTexture();
-
-        currentTex->bind();
-
-        currentTex->setTexParameter(GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-
-        useProgram(m_shaders->m_shBLURFINISH.program);
-        m_shaders->m_shBLURFINISH.setUniformMatrix3fv(SHADER_PROJ, 1, GL_TRUE, glMatrix.getMatrix());
-        m_shaders->m_shBLURFINISH.setUniformFloat(SHADER_NOISE, *PBLURNOISE);
-        m_shaders->m_shBLURFINISH.setUniformFloat(SHADER_BRIGHTNESS, *PBLURBRIGHTNESS);
-
-        m_shaders->m_shBLURFINISH.setUniformInt(SHADER_TEX, 0);
-
-        glBindVertexArray(m_shaders->m_shBLURFINISH.uniformLocations[SHADER_SHADER_VAO]);
-
-        if (!damage.empty()) {
-            damage.forEachRect([this](const auto& RECT) {
-                scissor(&RECT, false /* this region is already transformed */);
-                glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-            });
-        }
-
-        glBindVertexArray(0);
-
-        if (currentRenderToFB != PMIRRORFB)
-            currentRenderToFB = PMIRRORFB;
-        else
-            currentRenderToFB = PMIRRORSWAPFB;
+        auto& to = i == 0 ? *PMIRRORFB : mips[i - 1];
+        m_shaders->m_shBLUR2.setUniformInt(SHADER_BLUR_FINISH, i == 0);
+        m_shaders->m_shBLUR2.setUniformFloat2(SHADER_HALFPIXEL, 0.5f / (mips[i].m_size.x * 2.f), 0.5f / (mips[i].m_size.y * 2.f));
+        drawPass(&m_shaders->m_shBLUR2, mips[i], to);
     }
 
     // finish
-    PMIRRORFB->getTexture()->unbind();
+    mips[0].getTexture()->unbind();
 
     blend(BLENDBEFORE);
 
-    return currentRenderToFB;
+    return PMIRRORFB;
 }
 
 void CHyprOpenGLImpl::markBlurDirtyForMonitor(PHLMONITOR pMonitor) {
@@ -2531,8 +2588,6 @@ void CHyprOpenGLImpl::renderBorder(const CBox& box, const CGradientValueData& gr
     m_shaders->m_shBORDER1.setUniformFloat(SHADER_ROUNDING_POWER, data.roundingPower);
     m_shaders->m_shBORDER1.setUniformFloat(SHADER_THICK, scaledBorderSize);
 
-    glBindVertexArray(m_shaders->m_shBORDER1.uniformLocations[SHADER_SHADER_VAO]);
-
     // calculate the border's region, which we need to render over. No need to run the shader on
     // things outside there
     CRegion borderRegion = m_renderData.damage.copy().intersect(newBox);
@@ -2541,14 +2596,7 @@ void CHyprOpenGLImpl::renderBorder(const CBox& box, const CGradientValueData& gr
     if (m_renderData.clipBox.width != 0 && m_renderData.clipBox.height != 0)
         borderRegion.intersect(m_renderData.clipBox);
 
-    if (!borderRegion.empty()) {
-        borderRegion.forEachRect([this](const auto& RECT) {
-            scissor(&RECT);
-            glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-        });
-    }
-
-    glBindVertexArray(0);
+    drawDamage(m_shaders->m_shBORDER1, glMatrix, borderRegion);
 
     blend(BLEND);
 }
@@ -2619,8 +2667,6 @@ void CHyprOpenGLImpl::renderBorder(const CBox& box, const CGradientValueData& gr
     m_shaders->m_shBORDER1.setUniformFloat(SHADER_ROUNDING_POWER, data.roundingPower);
     m_shaders->m_shBORDER1.setUniformFloat(SHADER_THICK, scaledBorderSize);
 
-    glBindVertexArray(m_shaders->m_shBORDER1.uniformLocations[SHADER_SHADER_VAO]);
-
     // calculate the border's region, which we need to render over. No need to run the shader on
     // things outside there
     CRegion borderRegion = m_renderData.damage.copy().intersect(newBox);
@@ -2629,14 +2675,7 @@ void CHyprOpenGLImpl::renderBorder(const CBox& box, const CGradientValueData& gr
     if (m_renderData.clipBox.width != 0 && m_renderData.clipBox.height != 0)
         borderRegion.intersect(m_renderData.clipBox);
 
-    if (!borderRegion.empty()) {
-        borderRegion.forEachRect([this](const auto& RECT) {
-            scissor(&RECT);
-            glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-        });
-    }
-
-    glBindVertexArray(0);
+    drawDamage(m_shaders->m_shBORDER1, glMatrix, borderRegion);
     blend(BLEND);
 }
 
@@ -2687,26 +2726,13 @@ void CHyprOpenGLImpl::renderRoundedShadow(const CBox& box, int round, float roun
     m_shaders->m_shSHADOW.setUniformFloat(SHADER_RANGE, range);
     m_shaders->m_shSHADOW.setUniformFloat(SHADER_SHADOW_POWER, SHADOWPOWER);
 
-    glBindVertexArray(m_shaders->m_shSHADOW.uniformLocations[SHADER_SHADER_VAO]);
-
     if (m_renderData.clipBox.width != 0 && m_renderData.clipBox.height != 0) {
         CRegion damageClip{m_renderData.clipBox.x, m_renderData.clipBox.y, m_renderData.clipBox.width, m_renderData.clipBox.height};
         damageClip.intersect(m_renderData.damage);
 
-        if (!damageClip.empty()) {
-            damageClip.forEachRect([this](const auto& RECT) {
-                scissor(&RECT);
-                glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-            });
-        }
-    } else {
-        m_renderData.damage.forEachRect([this](const auto& RECT) {
-            scissor(&RECT);
-            glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-        });
-    }
-
-    glBindVertexArray(0);
+        drawDamage(m_shaders->m_shSHADOW, glMatrix, damageClip);
+    } else
+        drawDamage(m_shaders->m_shSHADOW, glMatrix, m_renderData.damage);
 }
 
 void CHyprOpenGLImpl::saveBufferForMirror(const CBox& box) {
@@ -2869,83 +2895,7 @@ SP<CTexture> CHyprOpenGLImpl::texFromCairo(cairo_surface_t* cairo) {
 }
 
 SP<CTexture> CHyprOpenGLImpl::renderText(const std::string& text, CHyprColor col, int pt, bool italic, const std::string& fontFamily, int maxWidth, int weight) {
-    SP<CTexture>          tex = makeShared<CTexture>();
-
-    static auto           FONT = CConfigValue<std::string>("misc:font_family");
-
-    const auto            FONTFAMILY = fontFamily.empty() ? *FONT : fontFamily;
-    const auto            FONTSIZE   = pt;
-    const auto            COLOR      = col;
-
-    auto                  CAIROSURFACE = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, 1920, 1080 /* arbitrary, just for size */);
-    auto                  CAIRO        = cairo_create(CAIROSURFACE);
-
-    PangoLayout*          layoutText = pango_cairo_create_layout(CAIRO);
-    PangoFontDescription* pangoFD    = pango_font_description_new();
-
-    pango_font_description_set_family_static(pangoFD, FONTFAMILY.c_str());
-    pango_font_description_set_absolute_size(pangoFD, FONTSIZE * PANGO_SCALE);
-    pango_font_description_set_style(pangoFD, italic ? PANGO_STYLE_ITALIC : PANGO_STYLE_NORMAL);
-    pango_font_description_set_weight(pangoFD, sc<PangoWeight>(weight));
-    pango_layout_set_font_description(layoutText, pangoFD);
-
-    cairo_set_source_rgba(CAIRO, COLOR.r, COLOR.g, COLOR.b, COLOR.a);
-
-    int textW = 0, textH = 0;
-    pango_layout_set_text(layoutText, text.c_str(), -1);
-
-    if (maxWidth > 0) {
-        pango_layout_set_width(layoutText, maxWidth * PANGO_SCALE);
-        pango_layout_set_ellipsize(layoutText, PANGO_ELLIPSIZE_END);
-    }
-
-    pango_layout_get_size(layoutText, &textW, &textH);
-    textW /= PANGO_SCALE;
-    textH /= PANGO_SCALE;
-
-    pango_font_description_free(pangoFD);
-    g_object_unref(layoutText);
-    cairo_destroy(CAIRO);
-    cairo_surface_destroy(CAIROSURFACE);
-
-    CAIROSURFACE = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, textW, textH);
-    CAIRO        = cairo_create(CAIROSURFACE);
-
-    layoutText = pango_cairo_create_layout(CAIRO);
-    pangoFD    = pango_font_description_new();
-
-    pango_font_description_set_family_static(pangoFD, FONTFAMILY.c_str());
-    pango_font_description_set_absolute_size(pangoFD, FONTSIZE * PANGO_SCALE);
-    pango_font_description_set_style(pangoFD, italic ? PANGO_STYLE_ITALIC : PANGO_STYLE_NORMAL);
-    pango_font_description_set_weight(pangoFD, sc<PangoWeight>(weight));
-    pango_layout_set_font_description(layoutText, pangoFD);
-    pango_layout_set_text(layoutText, text.c_str(), -1);
-
-    cairo_set_source_rgba(CAIRO, COLOR.r, COLOR.g, COLOR.b, COLOR.a);
-
-    cairo_move_to(CAIRO, 0, 0);
-    pango_cairo_show_layout(CAIRO, layoutText);
-
-    pango_font_description_free(pangoFD);
-    g_object_unref(layoutText);
-
-    cairo_surface_flush(CAIROSURFACE);
-
-    tex->allocate();
-    tex->m_size = {cairo_image_surface_get_width(CAIROSURFACE), cairo_image_surface_get_height(CAIROSURFACE)};
-
-    const auto DATA = cairo_image_surface_get_data(CAIROSURFACE);
-    tex->bind();
-    tex->setTexParameter(GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    tex->setTexParameter(GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    tex->setTexParameter(GL_TEXTURE_SWIZZLE_R, GL_BLUE);
-    tex->setTexParameter(GL_TEXTURE_SWIZZLE_B, GL_RED);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, tex->m_size.x, tex->m_size.y, 0, GL_RGBA, GL_UNSIGNED_BYTE, DATA);
-
-    cairo_destroy(CAIRO);
-    cairo_surface_destroy(CAIROSURFACE);
-
-    return tex;
+    return m_textRenderer->render(text, col, pt, italic, fontFamily, maxWidth, weight);
 }
 
 void CHyprOpenGLImpl::initMissingAssetTexture() {
@@ -3225,6 +3175,9 @@ void CHyprOpenGLImpl::destroyMonitorResources(PHLMONITORREF pMonitor) {
         RESIT->second.monitorMirrorFB.release();
         RESIT->second.blurFB.release();
         RESIT->second.offMainFB.release();
+        for (auto& mip : RESIT->second.blurMipFBs) {
+            mip.release();
+        }
         RESIT->second.stencilTex->destroyTexture();
         g_pHyprOpenGL->m_monitorRenderResources.erase(RESIT);
     }
@@ -8,11 +8,13 @@
 #include "../helpers/Format.hpp"
 #include "../helpers/sync/SyncTimeline.hpp"
 #include <GLES3/gl32.h>
+#include <array>
 #include <cstdint>
 #include <list>
 #include <string>
 #include <stack>
 #include <map>
+#include <unordered_map>
 
 #include <cairo/cairo.h>
 
@@ -20,6 +22,9 @@
 #include "Texture.hpp"
 #include "Framebuffer.hpp"
 #include "Renderbuffer.hpp"
+#include "ProgramCache.hpp"
+#include "TextRenderer.hpp"
+#include "ShmUploader.hpp"
 #include "pass/Pass.hpp"
 
 #include <EGL/egl.h>
@@ -81,9 +86,23 @@ enum eMonitorExtraRenderFBs : uint8_t {
     FB_MONITOR_RENDER_EXTRA_BLUR,
 };
 
+// feature bits of a specialized surface.frag variant, see CHyprOpenGLImpl::getSurfaceShader
+enum eSurfaceShaderFeature : uint32_t {
+    SURFACE_SHADER_RGBX           = 1 << 0,
+    SURFACE_SHADER_DISCARD_OPAQUE = 1 << 1,
+    SURFACE_SHADER_DISCARD_ALPHA  = 1 << 2,
+    SURFACE_SHADER_TINT           = 1 << 3,
+    SURFACE_SHADER_ROUNDING       = 1 << 4,
+    SURFACE_SHADER_CM             = 1 << 5,
+    // with SURFACE_SHADER_CM, bits 8-15 hold the source and bits 16-23 the target transfer function
+    SURFACE_SHADER_SOURCE_TF_SHIFT = 8,
+    SURFACE_SHADER_TARGET_TF_SHIFT = 16,
+};
+
 struct SPreparedShaders {
     std::string TEXVERTSRC;
     std::string TEXVERTSRC320;
+    std::string TEXFRAGSRCSURFACE;
     SShader     m_shQUAD;
     SShader     m_shRGBA;
     SShader     m_shPASSTHRURGBA;
@@ -92,12 +111,14 @@ struct SPreparedShaders {
     SShader     m_shEXT;
     SShader     m_shBLUR1;
     SShader     m_shBLUR2;
-    SShader     m_shBLURPREPARE;
-    SShader     m_shBLURFINISH;
     SShader     m_shSHADOW;
     SShader     m_shBORDER1;
     SShader     m_shGLITCH;
     SShader     m_shCM;
+    SShader     m_shGLYPH; // program 0 if it didn't compile, text then goes through cairo only
+
+    // compiled on first use, a failed variant is kept with program 0 so it isn't retried every frame
+    std::unordered_map<uint32_t, SShader> m_shSurfaceVariants;
 };
 
 struct SMonitorRenderData {
@@ -112,6 +133,9 @@ struct SMonitorRenderData {
 
     bool         blurFBDirty        = true;
     bool         blurFBShouldRender = false;
+
+    // half, quarter, ... of the monitor's size, one level per blur pass
+    std::array<CFramebuffer, 8> blurMipFBs;
 };
 
 struct SCurrentRenderData {
@@ -244,6 +268,10 @@ class CHyprOpenGLImpl {
     void         scissor(const pixman_box32*, bool transform = true);
     void         scissor(const int x, const int y, const int w, const int h, bool transform = true);
 
+    // draws the bound shader's quad over every rect of damage, see render:damage_batch_threshold
+    void         drawDamage(SShader& shader, const Mat3x3& proj, const CRegion& damage, bool transform = true, const Vector2D& uvTopLeft = {0, 0},
+                            const Vector2D& uvBottomRight = {1, 1});
+
     void         destroyMonitorResources(PHLMONITORREF);
 
     void         markBlurDirtyForMonitor(PHLMONITOR);
@@ -296,6 +324,18 @@ class CHyprOpenGLImpl {
 
     bool                                        m_reloadScreenShader = true; // at launch it can be set
 
+    struct {
+        size_t draws = 0;
+        size_t rects = 0;
+    } m_damageDrawStats;
+
+    UP<CProgramCache> m_programCache;
+    UP<CTextRenderer> m_textRenderer;
+    UP<CShmUploader>  m_shmUploader;
+
+    // use specialized surface.frag variants instead of the rgba / rgbx / CM shaders, off with HYPRLAND_NO_SHADER_VARIANTS
+    bool m_useSurfaceVariants = true;
+
     std::map<PHLWINDOWREF, CFramebuffer>        m_windowFramebuffers;
     std::map<PHLLSREF, CFramebuffer>            m_layerFramebuffers;
     std::map<WP<CPopup>, CFramebuffer>          m_popupFramebuffers;
@@ -396,6 +436,9 @@ class CHyprOpenGLImpl {
     GLint                                                m_pressedHistoryKilled    = 0;
     GLint                                                m_pressedHistoryTouched   = 0;
 
+    // quads for batched damage draws, kept around to not reallocate every draw
+    std::vector<GLfloat> m_batchVerts;
+
     //
     std::optional<std::vector<uint64_t>> getModsForFormat(EGLint format);
 
@@ -416,10 +459,16 @@ class CHyprOpenGLImpl {
 
     void          preBlurForCurrentMonitor();
 
+    // the source TF passCMUniforms ends up using, render:cm_sdr_eotf can override it
+    NColorManagement::eTransferFunction getCMSourceTF(const NColorManagement::SImageDescription& imageDescription);
+    // nullptr if the variant failed to compile
+    SShader* getSurfaceShader(uint32_t features);
+
     friend class CHyprRenderer;
     friend class CTexPassElement;
     friend class CPreBlurElement;
     friend class CSurfacePassElement;
+    friend class CTextRenderer;
 };
 
 inline UP<CHyprOpenGLImpl> g_pHyprOpenGL;
@@ -0,0 +1,287 @@
+#include "ProgramCache.hpp"
+#include "../helpers/MiscFunctions.hpp"
+#include "../helpers/time/Timer.hpp"
+#include "../debug/Log.hpp"
+
+#include <GLES3/gl32.h>
+#include <cstring>
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <vector>
+#include <unistd.h>
+
+constexpr uint32_t CACHE_VERSION   = 1;
+constexpr uint64_t MAX_BINARY_SIZE = 64 * 1024 * 1024;
+// shader edits and driver updates leave entries nothing asks for anymore. Those go after a while, or sooner, least recently used
+// first, when all drivers together are past the size cap.
+constexpr uint64_t MAX_CACHE_SIZE = 64 * 1024 * 1024;
+constexpr auto     MAX_ENTRY_AGE  = std::chrono::days{30};
+
+struct SProgramCacheHeader {
+    char     magic[8]   = {'H', 'Y', 'P', 'R', 'P', 'R', 'O', 'G'};
+    uint32_t version    = CACHE_VERSION;
+    uint32_t format     = 0;
+    uint64_t key        = 0;
+    uint64_t vertSize   = 0;
+    uint64_t fragSize   = 0;
+    uint64_t binarySize = 0;
+};
+
+static std::string glString(GLenum name) {
+    const auto STR = rc<const char*>(glGetString(name));
+    return STR ? STR : "";
+}
+
+// FNV-1a, with a separator after every part
+static uint64_t hashParts(std::initializer_list<std::string_view> parts) {
+    uint64_t hash = 14695981039346656037ULL;
+
+    for (const auto& part : parts) {
+        for (const unsigned char c : part) {
+            hash ^= c;
+            hash *= 1099511628211ULL;
+        }
+
+        hash ^= 0xFF;
+        hash *= 1099511628211ULL;
+    }
+
+    return hash;
+}
+
+CProgramCache::CProgramCache() {
+    if (envEnabled("HYPRLAND_NO_SHADER_CACHE")) {
+        Debug::log(LOG, "ProgramCache: disabled by HYPRLAND_NO_SHADER_CACHE");
+        return;
+    }
+
+    GLint formats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+    if (formats <= 0) {
+        Debug::log(LOG, "ProgramCache: driver has no program binary formats, disabled");
+        return;
+    }
+
+    const auto CACHEHOME = getenv("XDG_CACHE_HOME");
+    const auto HOME      = getenv("HOME");
+
+    std::string root;
+    if (CACHEHOME && CACHEHOME[0] != '\0')
+        root = std::string{CACHEHOME} + "/hyprland/shaders";
+    else if (HOME && HOME[0] != '\0')
+        root = std::string{HOME} + "/.cache/hyprland/shaders";
+    else {
+        Debug::log(LOG, "ProgramCache: $XDG_CACHE_HOME and $HOME not set, disabled");
+        return;
+    }
+
+    m_driver = glString(GL_VENDOR) + '\n' + glString(GL_RENDERER) + '\n' + glString(GL_VERSION) + '\n' + glString(GL_SHADING_LANGUAGE_VERSION);
+
+    // one directory per driver, binaries from any other driver can't be loaded anymore
+    const auto      DIR = std::format("{}/{:016x}", root, hashParts({m_driver}));
+
+    std::error_code ec;
+    std::filesystem::create_directories(DIR, ec);
+    if (ec) {
+        Debug::log(ERR, "ProgramCache: couldn't create {}: {}, disabled", DIR, ec.message());
+        return;
+    }
+
+    m_dir = DIR;
+
+    prune(root);
+
+    Debug::log(LOG, "ProgramCache: caching program binaries in {}", m_dir);
+}
+
+void CProgramCache::prune(const std::string& root) {
+    struct SEntry {
+        std::filesystem::path           path;
+        std::filesystem::file_time_type used;
+        uint64_t                        size = 0;
+    };
+
+    // every driver's directory, not just ours. Other GPUs of a multi GPU setup or another session on other drivers still use theirs,
+    // what's gone stops being loaded and ages out.
+    std::vector<SEntry> entries;
+    std::vector<SEntry> stale;
+    uint64_t            total = 0;
+    std::error_code     ec;
+    const auto          NOW = std::filesystem::file_time_type::clock::now();
+
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(root, ec)) {
+        std::error_code entryEc;
+        if (!entry.is_regular_file(entryEc))
+            continue;
+
+        const auto SIZE = entry.file_size(entryEc);
+        const auto USED = entry.last_write_time(entryEc);
+        if (entryEc)
+            continue;
+
+        if (NOW - USED > MAX_ENTRY_AGE)
+            stale.emplace_back(SEntry{.path = entry.path(), .used = USED, .size = SIZE});
+        else {
+            entries.emplace_back(SEntry{.path = entry.path(), .used = USED, .size = SIZE});
+            total += SIZE;
+        }
+    }
+
+    for (const auto& entry : stale) {
+        std::filesystem::remove(entry.path, ec);
+    }
+
+    size_t evicted = 0;
+    if (total > MAX_CACHE_SIZE) {
+        // load() touches what it hits, so the oldest are the ones no shader needed in a while
+        std::ranges::sort(entries, {}, &SEntry::used);
+
+        for (const auto& entry : entries) {
+            if (total <= MAX_CACHE_SIZE)
+                break;
+
+            std::filesystem::remove(entry.path, ec);
+            total -= entry.size;
+            evicted++;
+        }
+    }
+
+    // directories of drivers that have nothing left
+    for (const auto& entry : std::filesystem::directory_iterator(root, ec)) {
+        std::error_code entryEc;
+        if (entry.path() != m_dir && entry.is_directory(entryEc) && std::filesystem::is_empty(entry.path(), entryEc))
+            std::filesystem::remove(entry.path(), entryEc);
+    }
+
+    if (!stale.empty() || evicted > 0)
+        Debug::log(LOG, "ProgramCache: dropped {} entries unused for a month and {} over the size cap, {} bytes left for all drivers", stale.size(), evicted, total);
+}
+
+bool CProgramCache::enabled() const {
+    return !m_dir.empty();
+}
+
+uint64_t CProgramCache::keyFor(const std::string& vert, const std::string& frag) const {
+    return hashParts({m_driver, vert, frag});
+}
+
+std::string CProgramCache::pathFor(uint64_t key) const {
+    return std::format("{}/{:016x}.bin", m_dir, key);
+}
+
+GLuint CProgramCache::load(const std::string& vert, const std::string& frag) {
+    if (!enabled())
+        return 0;
+
+    CTimer timer;
+    timer.reset();
+
+    const auto    KEY  = keyFor(vert, frag);
+    const auto    PATH = pathFor(KEY);
+
+    std::ifstream file(PATH, std::ios::binary);
+    if (!file.good()) {
+        m_stats.misses++;
+        return 0;
+    }
+
+    const auto REJECT = [this, &PATH](const char* why) -> GLuint {
+        Debug::log(WARN, "ProgramCache: dropping {}: {}", PATH, why);
+        std::error_code ec;
+        std::filesystem::remove(PATH, ec);
+        m_stats.rejected++;
+        m_stats.misses++;
+        return 0;
+    };
+
+    SProgramCacheHeader header;
+    SProgramCacheHeader expected;
+    file.read(rc<char*>(&header), sizeof(header));
+
+    if (!file.good() || std::memcmp(header.magic, expected.magic, sizeof(header.magic)) != 0 || header.version != CACHE_VERSION)
+        return REJECT("bad header");
+
+    // keys can collide, sizes make that a lot less likely to matter
+    if (header.key != KEY || header.vertSize != vert.size() || header.fragSize != frag.size())
+        return REJECT("doesn't match the sources");
+
+    if (header.binarySize == 0 || header.binarySize > MAX_BINARY_SIZE)
+        return REJECT("bad binary size");
+
+    std::vector<char> binary(header.binarySize);
+    file.read(binary.data(), binary.size());
+
+    if (sc<uint64_t>(file.gcount()) != header.binarySize || file.peek() != std::char_traits<char>::eof())
+        return REJECT("truncated");
+
+    auto prog = glCreateProgram();
+    glProgramBinary(prog, header.format, binary.data(), binary.size());
+
+    GLint ok = GL_FALSE;
+    glGetProgramiv(prog, GL_LINK_STATUS, &ok);
+    if (ok != GL_TRUE) {
+        glDeleteProgram(prog);
+        return REJECT("rejected by the driver");
+    }
+
+    // the mtime is what prune() goes by
+    std::error_code ec;
+    std::filesystem::last_write_time(PATH, std::filesystem::file_time_type::clock::now(), ec);
+
+    m_stats.hits++;
+    m_stats.loadMs += timer.getMillis();
+
+    return prog;
+}
+
+void CProgramCache::store(GLuint prog, const std::string& vert, const std::string& frag) {
+    if (!enabled())
+        return;
+
+    GLint length = 0;
+    glGetProgramiv(prog, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0)
+        return;
+
+    SProgramCacheHeader header;
+    std::vector<char>   binary(length);
+    GLsizei             written = 0;
+    GLenum              format  = 0;
+    glGetProgramBinary(prog, length, &written, &format, binary.data());
+    if (written <= 0)
+        return;
+
+    header.format     = format;
+    header.key        = keyFor(vert, frag);
+    header.vertSize   = vert.size();
+    header.fragSize   = frag.size();
+    header.binarySize = written;
+
+    // write next to it and move over, so a crash or a second instance never leaves half a file
+    const auto PATH = pathFor(header.key);
+    const auto TEMP = std::format("{}.{}.tmp", PATH, getpid());
+
+    {
+        std::ofstream file(TEMP, std::ios::binary | std::ios::trunc);
+        file.write(rc<const char*>(&header), sizeof(header));
+        file.write(binary.data(), written);
+
+        if (!file.good()) {
+            Debug::log(ERR, "ProgramCache: failed writing {}", TEMP);
+            file.close();
+            std::error_code ec;
+            std::filesystem::remove(TEMP, ec);
+            return;
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(TEMP, PATH, ec);
+    if (ec) {
+        Debug::log(ERR, "ProgramCache: failed to move {} into place: {}", TEMP, ec.message());
+        std::filesystem::remove(TEMP, ec);
+    }
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "../defines.hpp"
+#include <string>
+
+/*
+    On-disk cache of linked GL programs, in $XDG_CACHE_HOME/hyprland/shaders/<driver hash>.
+
+    Entries are keyed by the GL driver strings and the fully preprocessed sources, so a driver
+    update or any shader / include / define change simply misses. Binaries the driver refuses
+    to load back are deleted and the program gets compiled from source again.
+
+    On startup, entries of all drivers unused for a month are dropped, then the least recently
+    used ones until all drivers together are under a size cap. Other drivers' directories are
+    kept, multi GPU setups use several at once.
+*/
+class CProgramCache {
+  public:
+    CProgramCache();
+
+    // 0 if there's nothing usable cached
+    GLuint load(const std::string& vert, const std::string& frag);
+    // prog has to be linked with GL_PROGRAM_BINARY_RETRIEVABLE_HINT set
+    void store(GLuint prog, const std::string& vert, const std::string& frag);
+
+    bool enabled() const;
+
+    struct SStats {
+        size_t hits      = 0;
+        size_t misses    = 0;
+        size_t rejected  = 0;
+        float  loadMs    = 0.F;
+        float  compileMs = 0.F;
+    } m_stats;
+
+  private:
+    uint64_t    keyFor(const std::string& vert, const std::string& frag) const;
+    std::string pathFor(uint64_t key) const;
+    void        prune(const std::string& root);
+
+    std::string m_dir; // empty if disabled
+    std::string m_driver;
+};
@@ -26,6 +26,7 @@
 #include "../helpers/sync/SyncTimeline.hpp"
 #include "../hyprerror/HyprError.hpp"
 #include "../debug/HyprDebugOverlay.hpp"
+#include "../debug/Telemetry.hpp"
 #include "../debug/HyprNotificationOverlay.hpp"
 #include "../i18n/Engine.hpp"
 #include "helpers/CursorShapes.hpp"
@@ -1275,6 +1276,8 @@ void CHyprRenderer::renderMonitor(PHLMONITOR pMonitor, bool commit) {
         return;
     }
 
+    const auto RENDERBEGIN = Time::steadyNow();
+
     if (!*PDAMAGEBLINK)
         damageBlinkCleanup = 0;
 
@@ -1303,8 +1306,10 @@ void CHyprRenderer::renderMonitor(PHLMONITOR pMonitor, bool commit) {
         g_pLayoutManager->getCurrentLayout()->recalculateMonitor(pMonitor->m_id);
     }
 
-    if (!pMonitor->m_output->needsFrame && pMonitor->m_forceFullFrames == 0)
+    if (!pMonitor->m_output->needsFrame && pMonitor->m_forceFullFrames == 0) {
+        g_pTelemetry->onIdleFrame(pMonitor);
         return;
+    }
 
     // tearing and DS first
     bool shouldTear = pMonitor->updateTearing();
@@ -1329,8 +1334,10 @@ void CHyprRenderer::renderMonitor(PHLMONITOR pMonitor, bool commit) {
     // check the damage
     bool hasChanged = pMonitor->m_output->needsFrame || pMonitor->m_damage.hasChanged();
 
-    if (!hasChanged && *PDAMAGETRACKINGMODE != DAMAGE_TRACKING_NONE && pMonitor->m_forceFullFrames == 0 && damageBlinkCleanup == 0)
+    if (!hasChanged && *PDAMAGETRACKINGMODE != DAMAGE_TRACKING_NONE && pMonitor->m_forceFullFrames == 0 && damageBlinkCleanup == 0) {
+        g_pTelemetry->onIdleFrame(pMonitor);
         return;
+    }
 
     if (*PDAMAGETRACKINGMODE == -1) {
         Debug::log(CRIT, "Damage tracking mode -1 ????");
@@ -1459,6 +1466,8 @@ void CHyprRenderer::renderMonitor(PHLMONITOR pMonitor, bool commit) {
 
     endRender();
 
+    pMonitor->m_renderedFrames++;
+
     TRACY_GPU_COLLECT;
 
     CRegion    frameDamage{g_pHyprOpenGL->m_renderData.damage};
@@ -1494,6 +1503,13 @@ void CHyprRenderer::renderMonitor(PHLMONITOR pMonitor, bool commit) {
 
     pMonitor->m_pendingFrame = false;
 
+    auto& telemetry = g_pTelemetry->forMonitor(pMonitor);
+    telemetry.renderMs.add(std::chrono::duration_cast<std::chrono::microseconds>(Time::steadyNow() - RENDERBEGIN).count() / 1000.F);
+
+    float damagedArea = 0.F;
+    frameDamage.forEachRect([&damagedArea](const auto& RECT) { damagedArea += sc<float>(RECT.x2 - RECT.x1) * (RECT.y2 - RECT.y1); });
+    telemetry.damagePercent.add(std::min(100.F, damagedArea * 100.F / sc<float>(pMonitor->m_transformedSize.x * pMonitor->m_transformedSize.y)));
+
     if (*PDEBUGOVERLAY == 1) {
         const float durationUs = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - renderStart).count() / 1000.f;
         g_pDebugOverlay->renderData(pMonitor, durationUs);
@@ -1689,6 +1705,9 @@ bool CHyprRenderer::commitPendingAndDoExplicitSync(PHLMONITOR pMonitor) {
         }
     }
 
+    if (ok)
+        g_pTelemetry->onCommit(pMonitor);
+
     return ok;
 }
 
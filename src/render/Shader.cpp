@@ -45,12 +45,33 @@ void SShader::createVao() {
         glVertexAttribPointer(uniformLocations[SHADER_TEX_ATTRIB], 2, GL_FLOAT, GL_FALSE, 0, nullptr);
     }
 
+    // interleaved pos and uv, filled by CHyprOpenGLImpl::drawDamage with one quad per damage rect
+    GLuint batchVao = 0, batchVbo = 0;
+
+    glGenVertexArrays(1, &batchVao);
+    glBindVertexArray(batchVao);
+
+    glGenBuffers(1, &batchVbo);
+    glBindBuffer(GL_ARRAY_BUFFER, batchVbo);
+
+    if (uniformLocations[SHADER_POS_ATTRIB] != -1) {
+        glEnableVertexAttribArray(uniformLocations[SHADER_POS_ATTRIB]);
+        glVertexAttribPointer(uniformLocations[SHADER_POS_ATTRIB], 2, GL_FLOAT, GL_FALSE, 4 * sizeof(GLfloat), nullptr);
+    }
+
+    if (uniformLocations[SHADER_TEX_ATTRIB] != -1) {
+        glEnableVertexAttribArray(uniformLocations[SHADER_TEX_ATTRIB]);
+        glVertexAttribPointer(uniformLocations[SHADER_TEX_ATTRIB], 2, GL_FLOAT, GL_FALSE, 4 * sizeof(GLfloat), rc<void*>(2 * sizeof(GLfloat)));
+    }
+
     glBindVertexArray(0);
     glBindBuffer(GL_ARRAY_BUFFER, 0);
 
-    uniformLocations[SHADER_SHADER_VAO]     = shaderVao;
-    uniformLocations[SHADER_SHADER_VBO_POS] = shaderVbo;
-    uniformLocations[SHADER_SHADER_VBO_UV]  = shaderVboUv;
+    uniformLocations[SHADER_SHADER_VAO]       = shaderVao;
+    uniformLocations[SHADER_SHADER_VBO_POS]   = shaderVbo;
+    uniformLocations[SHADER_SHADER_VBO_UV]    = shaderVboUv;
+    uniformLocations[SHADER_SHADER_VAO_BATCH] = batchVao;
+    uniformLocations[SHADER_SHADER_VBO_BATCH] = batchVbo;
 
     RASSERT(uniformLocations[SHADER_SHADER_VAO] >= 0, "SHADER_SHADER_VAO could not be created");
     RASSERT(uniformLocations[SHADER_SHADER_VBO_POS] >= 0, "SHADER_SHADER_VBO_POS could not be created");
@@ -205,11 +226,13 @@ void SShader::destroy() {
     if (program == 0)
         return;
 
-    GLuint shaderVao, shaderVbo, shaderVboUv;
+    GLuint shaderVao, shaderVbo, shaderVboUv, batchVao, batchVbo;
 
     shaderVao   = uniformLocations[SHADER_SHADER_VAO] == -1 ? 0 : uniformLocations[SHADER_SHADER_VAO];
     shaderVbo   = uniformLocations[SHADER_SHADER_VBO_POS] == -1 ? 0 : uniformLocations[SHADER_SHADER_VBO_POS];
     shaderVboUv = uniformLocations[SHADER_SHADER_VBO_UV] == -1 ? 0 : uniformLocations[SHADER_SHADER_VBO_UV];
+    batchVao    = uniformLocations[SHADER_SHADER_VAO_BATCH] == -1 ? 0 : uniformLocations[SHADER_SHADER_VAO_BATCH];
+    batchVbo    = uniformLocations[SHADER_SHADER_VBO_BATCH] == -1 ? 0 : uniformLocations[SHADER_SHADER_VBO_BATCH];
 
     if (shaderVao)
         glDeleteVertexArrays(1, &shaderVao);
@@ -220,6 +243,12 @@ void SShader::destroy() {
     if (shaderVboUv)
         glDeleteBuffers(1, &shaderVboUv);
 
+    if (batchVao)
+        glDeleteVertexArrays(1, &batchVao);
+
+    if (batchVbo)
+        glDeleteBuffers(1, &batchVbo);
+
     glDeleteProgram(program);
     program = 0;
 }
@@ -32,6 +32,8 @@ enum eShaderUniform : uint8_t {
     SHADER_SHADER_VAO,
     SHADER_SHADER_VBO_POS,
     SHADER_SHADER_VBO_UV,
+    SHADER_SHADER_VAO_BATCH,
+    SHADER_SHADER_VBO_BATCH,
     SHADER_TOP_LEFT,
     SHADER_BOTTOM_RIGHT,
     SHADER_FULL_SIZE,
@@ -62,6 +64,8 @@ enum eShaderUniform : uint8_t {
     SHADER_VIBRANCY_DARKNESS,
     SHADER_BRIGHTNESS,
     SHADER_NOISE,
+    SHADER_BLUR_PREPARE,
+    SHADER_BLUR_FINISH,
     SHADER_POINTER,
     SHADER_POINTER_SHAPE,
     SHADER_POINTER_SWITCH_TIME,
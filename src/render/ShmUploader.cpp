@@ -0,0 +1,128 @@
+#include "ShmUploader.hpp"
+#include "../helpers/Format.hpp"
+#include "../macros.hpp"
+#include <hyprutils/math/Region.hpp>
+#include <cstring>
+
+// a 4K XRGB8888 frame is ~32MiB, anything bigger goes the direct route instead of growing a slot further
+constexpr size_t MAX_SLOT_BYTES = 64 * 1024 * 1024;
+constexpr size_t RECT_ALIGNMENT = 16;
+
+CShmUploader::~CShmUploader() {
+    for (auto& s : m_slots) {
+        if (s.fence)
+            glDeleteSync(s.fence);
+        if (s.pbo)
+            glDeleteBuffers(1, &s.pbo);
+    }
+}
+
+CShmUploader::SSlot* CShmUploader::freeSlot() {
+    for (size_t i = 0; i < m_slots.size(); ++i) {
+        auto& slot = m_slots[(m_next + i) % m_slots.size()];
+
+        if (slot.fence) {
+            // don't wait, a busy slot is skipped
+            const auto STATUS = glClientWaitSync(slot.fence, 0, 0);
+            if (STATUS != GL_ALREADY_SIGNALED && STATUS != GL_CONDITION_SATISFIED)
+                continue;
+
+            glDeleteSync(slot.fence);
+            slot.fence = nullptr;
+        }
+
+        m_next = (m_next + i + 1) % m_slots.size();
+        return &slot;
+    }
+
+    return nullptr;
+}
+
+bool CShmUploader::upload(const SPixelFormat& format, const uint8_t* pixels, uint32_t stride, const CRegion& damage) {
+    const auto BPP   = format.bytesPerBlock;
+    const auto RECTS = damage.getRects();
+
+    // shm formats we upload are one pixel per block, anything packed differently goes the direct route
+    if (BPP == 0 || format.blockSize.x > 1 || format.blockSize.y > 1 || RECTS.empty())
+        return false;
+
+    size_t total = 0;
+    for (const auto& r : RECTS) {
+        total = (total + RECT_ALIGNMENT - 1) / RECT_ALIGNMENT * RECT_ALIGNMENT;
+        total += sc<size_t>(r.x2 - r.x1) * BPP * (r.y2 - r.y1);
+    }
+
+    if (total > MAX_SLOT_BYTES) {
+        m_stats.fallbacks++;
+        return false;
+    }
+
+    const auto SLOT = freeSlot();
+    if (!SLOT) {
+        m_stats.fallbacks++;
+        return false;
+    }
+
+    if (!SLOT->pbo)
+        GLCALL(glGenBuffers(1, &SLOT->pbo));
+
+    GLCALL(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, SLOT->pbo));
+
+    if (SLOT->size < total) {
+        // grow in steps so a surface resizing by a few pixels doesn't reallocate every commit
+        SLOT->size = std::min(std::max(total, SLOT->size * 2), MAX_SLOT_BYTES);
+        GLCALL(glBufferData(GL_PIXEL_UNPACK_BUFFER, SLOT->size, nullptr, GL_STREAM_DRAW));
+    }
+
+    // the fence says the GPU is done with the old contents, so there's nothing for the driver to synchronize
+    const auto DST = sc<uint8_t*>(glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, total, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT | GL_MAP_UNSYNCHRONIZED_BIT));
+    if (!DST) {
+        GLCALL(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0));
+        m_stats.fallbacks++;
+        return false;
+    }
+
+    std::vector<size_t> offsets;
+    offsets.reserve(RECTS.size());
+
+    size_t offset = 0;
+    for (const auto& r : RECTS) {
+        offset = (offset + RECT_ALIGNMENT - 1) / RECT_ALIGNMENT * RECT_ALIGNMENT;
+        offsets.emplace_back(offset);
+
+        const size_t ROWBYTES = sc<size_t>(r.x2 - r.x1) * BPP;
+        const auto*  src      = pixels + sc<size_t>(r.y1) * stride + sc<size_t>(r.x1) * BPP;
+
+        if (ROWBYTES == stride) {
+            memcpy(DST + offset, src, ROWBYTES * (r.y2 - r.y1));
+            offset += ROWBYTES * (r.y2 - r.y1);
+            continue;
+        }
+
+        for (int y = r.y1; y < r.y2; ++y) {
+            memcpy(DST + offset, src, ROWBYTES);
+            src += stride;
+            offset += ROWBYTES;
+        }
+    }
+
+    GLCALL(glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER));
+
+    // rows are packed tightly in the buffer
+    GLCALL(glPixelStorei(GL_UNPACK_ALIGNMENT, 1));
+
+    for (size_t i = 0; i < RECTS.size(); ++i) {
+        const auto& r = RECTS[i];
+        GLCALL(glTexSubImage2D(GL_TEXTURE_2D, 0, r.x1, r.y1, r.x2 - r.x1, r.y2 - r.y1, format.glFormat, format.glType, rc<const void*>(offsets[i])));
+    }
+
+    GLCALL(glPixelStorei(GL_UNPACK_ALIGNMENT, 4));
+    GLCALL(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0));
+
+    SLOT->fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+    m_stats.uploads++;
+    m_stats.bytes += total;
+
+    return true;
+}
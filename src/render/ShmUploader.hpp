@@ -0,0 +1,42 @@
+#pragma once
+
+#include "../defines.hpp"
+#include <GLES3/gl32.h>
+#include <array>
+
+struct SPixelFormat;
+HYPRUTILS_FORWARD(Math, CRegion);
+
+/*
+    Streams wl_shm damage into textures through a small ring of pixel unpack buffers.
+
+    The main thread only copies the damaged rows into a mapped buffer; the transfer into the
+    texture happens whenever the driver gets to it. Every buffer is fenced after use and isn't
+    written again until the GPU has read it, so when the ring is busy the caller uploads directly.
+*/
+class CShmUploader {
+  public:
+    CShmUploader() = default;
+    ~CShmUploader();
+
+    // uploads damage into the currently bound GL_TEXTURE_2D. False means nothing was uploaded and the caller has to do it.
+    bool upload(const SPixelFormat& format, const uint8_t* pixels, uint32_t stride, const CRegion& damage);
+
+    struct SStats {
+        size_t uploads   = 0;
+        size_t fallbacks = 0; // ring busy or damage too large
+        size_t bytes     = 0; // copied into the ring, in total
+    } m_stats;
+
+  private:
+    struct SSlot {
+        GLuint pbo   = 0;
+        size_t size  = 0;
+        GLsync fence = nullptr;
+    };
+
+    SSlot*               freeSlot();
+
+    std::array<SSlot, 3> m_slots;
+    size_t               m_next = 0;
+};
@@ -0,0 +1,440 @@
+#include "TextRenderer.hpp"
+#include "OpenGL.hpp"
+#include "Texture.hpp"
+#include "../config/ConfigValue.hpp"
+#include <pango/pangocairo.h>
+#include <cstring>
+
+constexpr size_t SHAPE_CACHE_CAPACITY = 2048;
+constexpr size_t FONT_CACHE_CAPACITY  = 64;
+constexpr size_t FONT_REFS_CAPACITY   = 64;
+constexpr int    ATLAS_SIZE           = 1024;
+constexpr int    ATLAS_GUTTER         = 1;
+constexpr size_t FLOATS_PER_GLYPH     = 9; // dest xywh, src xywh, colored
+
+CTextRenderer::CTextRenderer() : m_shaped(SHAPE_CACHE_CAPACITY) {
+    // measuring doesn't care about the surface size, but the font options come from an image surface like the ones we draw into
+    m_measureSurface = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, 1, 1);
+    m_measureCairo   = cairo_create(m_measureSurface);
+    m_context        = pango_cairo_create_context(m_measureCairo);
+}
+
+CTextRenderer::~CTextRenderer() {
+    resetShaping();
+
+    for (auto& [key, fd] : m_fonts) {
+        pango_font_description_free(fd);
+    }
+
+    if (m_fbo)
+        glDeleteFramebuffers(1, &m_fbo);
+    if (m_vao)
+        glDeleteVertexArrays(1, &m_vao);
+    if (m_quadVbo)
+        glDeleteBuffers(1, &m_quadVbo);
+    if (m_instanceVbo)
+        glDeleteBuffers(1, &m_instanceVbo);
+
+    g_object_unref(m_context);
+    cairo_destroy(m_measureCairo);
+    cairo_surface_destroy(m_measureSurface);
+}
+
+size_t CTextRenderer::SLayoutKeyHash::operator()(const SLayoutKey& key) const {
+    size_t hash = std::hash<std::string>{}(key.text);
+    hash ^= std::hash<std::string>{}(key.font) << 1;
+    hash ^= std::hash<uint64_t>{}((sc<uint64_t>(key.pt) << 32) | sc<uint32_t>(key.maxWidth)) << 2;
+    hash ^= std::hash<uint64_t>{}((sc<uint64_t>(key.weight) << 1) | key.italic) << 3;
+    return hash;
+}
+
+size_t CTextRenderer::SGlyphKeyHash::operator()(const SGlyphKey& key) const {
+    return std::hash<uintptr_t>{}(rc<uintptr_t>(key.font)) ^ (std::hash<uint32_t>{}(key.glyph) << 1);
+}
+
+PangoFontDescription* CTextRenderer::fontFor(const SLayoutKey& key) {
+    const auto NAME = std::format("{}:{}:{}:{}", key.font, key.pt, key.italic, key.weight);
+
+    if (const auto IT = m_fonts.find(NAME); IT != m_fonts.end())
+        return IT->second;
+
+    if (m_fonts.size() >= FONT_CACHE_CAPACITY) {
+        // layouts keep their own copy, these are only needed to make new ones
+        for (auto& [name, fd] : m_fonts) {
+            pango_font_description_free(fd);
+        }
+        m_fonts.clear();
+    }
+
+    const auto FD = pango_font_description_new();
+    pango_font_description_set_family(FD, key.font.c_str());
+    pango_font_description_set_absolute_size(FD, key.pt * PANGO_SCALE);
+    pango_font_description_set_style(FD, key.italic ? PANGO_STYLE_ITALIC : PANGO_STYLE_NORMAL);
+    pango_font_description_set_weight(FD, sc<PangoWeight>(key.weight));
+
+    m_fonts.emplace(NAME, FD);
+    return FD;
+}
+
+PangoLayout* CTextRenderer::makeLayout(const SLayoutKey& key) {
+    const auto LAYOUT = pango_layout_new(m_context);
+    pango_layout_set_font_description(LAYOUT, fontFor(key));
+    pango_layout_set_text(LAYOUT, key.text.c_str(), -1);
+
+    if (key.maxWidth > 0) {
+        pango_layout_set_width(LAYOUT, key.maxWidth * PANGO_SCALE);
+        pango_layout_set_ellipsize(LAYOUT, PANGO_ELLIPSIZE_END);
+    }
+
+    return LAYOUT;
+}
+
+void CTextRenderer::resetShaping() {
+    // glyph keys point to the fonts, so everything referring to them goes too
+    m_shaped.clear();
+    resetAtlas();
+
+    for (const auto& f : m_fontRefs) {
+        g_object_unref(f);
+    }
+    m_fontRefs.clear();
+}
+
+const CTextRenderer::SShaped* CTextRenderer::shapedFor(const SLayoutKey& key) {
+    if (const auto SHAPED = m_shaped.get(key)) {
+        m_stats.shapeHits++;
+        return SHAPED;
+    }
+
+    m_stats.shapeMisses++;
+
+    // fallback fonts pile up with every script and emoji seen, start over once there's too many
+    if (m_fontRefs.size() >= FONT_REFS_CAPACITY)
+        resetShaping();
+
+    const auto LAYOUT = makeLayout(key);
+
+    SShaped    shaped;
+    pango_layout_get_size(LAYOUT, &shaped.width, &shaped.height);
+    shaped.width  /= PANGO_SCALE;
+    shaped.height /= PANGO_SCALE;
+
+    const auto ITER = pango_layout_get_iter(LAYOUT);
+    do {
+        const auto RUN = pango_layout_iter_get_run_readonly(ITER);
+        if (!RUN)
+            continue; // end of a line
+
+        PangoRectangle logical;
+        pango_layout_iter_get_run_extents(ITER, nullptr, &logical);
+        const int  BASELINE = pango_layout_iter_get_baseline(ITER);
+        const auto FONT     = RUN->item->analysis.font;
+
+        if (m_fontRefs.emplace(FONT).second)
+            g_object_ref(FONT);
+
+        int x = logical.x;
+        for (int i = 0; i < RUN->glyphs->num_glyphs; ++i) {
+            const auto& GLYPH = RUN->glyphs->glyphs[i];
+
+            if (GLYPH.glyph != PANGO_GLYPH_EMPTY)
+                shaped.glyphs.emplace_back(SPlacedGlyph{
+                    .key = {.font = FONT, .glyph = GLYPH.glyph},
+                    .x   = PANGO_PIXELS(x + GLYPH.geometry.x_offset),
+                    .y   = PANGO_PIXELS(BASELINE + GLYPH.geometry.y_offset),
+                });
+
+            x += GLYPH.geometry.width;
+        }
+    } while (pango_layout_iter_next_run(ITER));
+
+    pango_layout_iter_free(ITER);
+    g_object_unref(LAYOUT);
+
+    return &m_shaped.insert(key, std::move(shaped));
+}
+
+void CTextRenderer::initGL() {
+    if (m_vao)
+        return;
+
+    // one unit quad, instanced per glyph
+    constexpr std::array<GLfloat, 8> QUAD = {0, 0, 1, 0, 0, 1, 1, 1};
+
+    glGenFramebuffers(1, &m_fbo);
+    glGenVertexArrays(1, &m_vao);
+    glGenBuffers(1, &m_quadVbo);
+    glGenBuffers(1, &m_instanceVbo);
+
+    glBindVertexArray(m_vao);
+
+    glBindBuffer(GL_ARRAY_BUFFER, m_quadVbo);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(QUAD), QUAD.data(), GL_STATIC_DRAW);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
+
+    constexpr GLsizei STRIDE = FLOATS_PER_GLYPH * sizeof(GLfloat);
+    glBindBuffer(GL_ARRAY_BUFFER, m_instanceVbo);
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, STRIDE, nullptr);
+    glVertexAttribDivisor(1, 1);
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, STRIDE, rc<void*>(4 * sizeof(GLfloat)));
+    glVertexAttribDivisor(2, 1);
+    glEnableVertexAttribArray(3);
+    glVertexAttribPointer(3, 1, GL_FLOAT, GL_FALSE, STRIDE, rc<void*>(8 * sizeof(GLfloat)));
+    glVertexAttribDivisor(3, 1);
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void CTextRenderer::resetAtlas() {
+    m_atlasGlyphs.clear();
+    m_shelfX = m_shelfY = m_shelfHeight = 0;
+
+    if (m_atlas)
+        m_stats.atlasResets++;
+    m_atlas.reset();
+}
+
+bool CTextRenderer::rasterizeGlyph(const SGlyphKey& key, SAtlasGlyph& out) {
+    PangoRectangle ink;
+    pango_font_get_glyph_extents(key.font, key.glyph, &ink, nullptr);
+
+    if (ink.width <= 0 || ink.height <= 0)
+        return true; // nothing to draw, like a space
+
+    // a pixel of padding around the ink, antialiasing can spill over it
+    out.left = PANGO_PIXELS_FLOOR(ink.x) - 1;
+    out.top  = PANGO_PIXELS_FLOOR(ink.y) - 1;
+    out.w    = PANGO_PIXELS_CEIL(ink.x + ink.width) + 1 - out.left;
+    out.h    = PANGO_PIXELS_CEIL(ink.y + ink.height) + 1 - out.top;
+
+    if (out.w + ATLAS_GUTTER > ATLAS_SIZE || out.h + ATLAS_GUTTER > ATLAS_SIZE)
+        return false;
+
+    // shelf packing: glyphs of one font are close in height, so a row fits them without much waste
+    if (m_shelfX + out.w + ATLAS_GUTTER > ATLAS_SIZE) {
+        m_shelfY += m_shelfHeight;
+        m_shelfX      = 0;
+        m_shelfHeight = 0;
+    }
+
+    if (m_shelfY + out.h + ATLAS_GUTTER > ATLAS_SIZE)
+        return false;
+
+    out.x         = m_shelfX;
+    out.y         = m_shelfY;
+    m_shelfX     += out.w + ATLAS_GUTTER;
+    m_shelfHeight = std::max(m_shelfHeight, out.h + ATLAS_GUTTER);
+
+    PangoGlyphInfo   glyphInfo = {.glyph = key.glyph, .geometry = {}, .attr = {}};
+    PangoGlyphString glyphs    = {.num_glyphs = 1, .glyphs = &glyphInfo, .log_clusters = nullptr};
+
+    const auto       rasterize = [&](double value) {
+        const auto SURFACE = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, out.w, out.h);
+        const auto CAIRO   = cairo_create(SURFACE);
+
+        m_stats.surfaceBytes += sc<size_t>(cairo_image_surface_get_stride(SURFACE)) * out.h;
+
+        cairo_set_source_rgba(CAIRO, value, value, value, 1.0);
+        cairo_move_to(CAIRO, -out.left, -out.top);
+        pango_cairo_show_glyph_string(CAIRO, key.font, &glyphs);
+        cairo_surface_flush(SURFACE);
+        cairo_destroy(CAIRO);
+
+        return SURFACE;
+    };
+
+    // the atlas is white so the shader can tint it. glyphs that come out the same in black have colors of their own
+    const auto WHITE = rasterize(1.0);
+    const auto BLACK = rasterize(0.0);
+
+    const auto STRIDE = cairo_image_surface_get_stride(WHITE);
+    out.colored       = !memcmp(cairo_image_surface_get_data(WHITE), cairo_image_surface_get_data(BLACK), sc<size_t>(STRIDE) * out.h);
+
+    m_atlas->bind();
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, STRIDE / 4);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, out.x, out.y, out.w, out.h, GL_RGBA, GL_UNSIGNED_BYTE, cairo_image_surface_get_data(WHITE));
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+
+    cairo_surface_destroy(WHITE);
+    cairo_surface_destroy(BLACK);
+
+    return true;
+}
+
+const CTextRenderer::SAtlasGlyph* CTextRenderer::glyphFor(const SGlyphKey& key) {
+    if (const auto IT = m_atlasGlyphs.find(key); IT != m_atlasGlyphs.end()) {
+        m_stats.glyphHits++;
+        return &IT->second;
+    }
+
+    if (!m_atlas) {
+        m_atlas = makeShared<CTexture>();
+        m_atlas->allocate();
+        m_atlas->m_size = {ATLAS_SIZE, ATLAS_SIZE};
+        m_atlas->bind();
+        // glyphs are drawn 1:1 at whole pixels, nearest keeps neighbours from bleeding in
+        m_atlas->setTexParameter(GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        m_atlas->setTexParameter(GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        m_atlas->setTexParameter(GL_TEXTURE_SWIZZLE_R, GL_BLUE);
+        m_atlas->setTexParameter(GL_TEXTURE_SWIZZLE_B, GL_RED);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, ATLAS_SIZE, ATLAS_SIZE, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    }
+
+    SAtlasGlyph glyph;
+    if (!rasterizeGlyph(key, glyph))
+        return nullptr;
+
+    m_stats.glyphMisses++;
+    return &m_atlasGlyphs.emplace(key, glyph).first->second;
+}
+
+SP<CTexture> CTextRenderer::renderWithAtlas(const SShaped& shaped, const CHyprColor& col) {
+    // a full atlas starts over once, a string that doesn't fit an empty one goes through cairo
+    for (int attempt = 0; attempt < 2; ++attempt) {
+        m_instances.clear();
+
+        bool full = false;
+        for (const auto& g : shaped.glyphs) {
+            const auto ATLASGLYPH = glyphFor(g.key);
+            if (!ATLASGLYPH) {
+                full = true;
+                break;
+            }
+
+            if (ATLASGLYPH->w == 0)
+                continue;
+
+            m_instances.insert(m_instances.end(),
+                               {sc<GLfloat>(g.x + ATLASGLYPH->left), sc<GLfloat>(g.y + ATLASGLYPH->top), sc<GLfloat>(ATLASGLYPH->w), sc<GLfloat>(ATLASGLYPH->h),
+                                sc<GLfloat>(ATLASGLYPH->x) / ATLAS_SIZE, sc<GLfloat>(ATLASGLYPH->y) / ATLAS_SIZE, sc<GLfloat>(ATLASGLYPH->w) / ATLAS_SIZE,
+                                sc<GLfloat>(ATLASGLYPH->h) / ATLAS_SIZE, ATLASGLYPH->colored ? 1.F : 0.F});
+        }
+
+        if (!full)
+            break;
+
+        if (attempt == 1 || m_atlasGlyphs.empty())
+            return nullptr;
+
+        resetAtlas();
+    }
+
+    SP<CTexture> tex = makeShared<CTexture>();
+    tex->allocate();
+    tex->m_size = {shaped.width, shaped.height};
+    tex->bind();
+    tex->setTexParameter(GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    tex->setTexParameter(GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, shaped.width, shaped.height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+
+    // this can run in the middle of a frame, put back whatever the renderer had going
+    GLint prevFb = 0;
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &prevFb);
+    const auto PREVVIEWPORT = g_pHyprOpenGL->m_lastViewport;
+    const bool PREVSCISSOR  = g_pHyprOpenGL->m_capStatus[CHyprOpenGLImpl::CAP_STATUS_SCISSOR_TEST];
+    const bool PREVSTENCIL  = g_pHyprOpenGL->m_capStatus[CHyprOpenGLImpl::CAP_STATUS_STENCIL_TEST];
+    const bool PREVBLEND    = g_pHyprOpenGL->m_blend;
+
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, m_fbo);
+    glFramebufferTexture2D(GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, tex->m_texID, 0);
+    g_pHyprOpenGL->setViewport(0, 0, shaped.width, shaped.height);
+    g_pHyprOpenGL->setCapStatus(GL_SCISSOR_TEST, false);
+    g_pHyprOpenGL->setCapStatus(GL_STENCIL_TEST, false);
+
+    glClearColor(0, 0, 0, 0);
+    glClear(GL_COLOR_BUFFER_BIT);
+
+    if (!m_instances.empty()) {
+        auto& shader = g_pHyprOpenGL->m_shaders->m_shGLYPH;
+
+        g_pHyprOpenGL->blend(true);
+        g_pHyprOpenGL->useProgram(shader.program);
+        shader.setUniformInt(SHADER_TEX, 0);
+        shader.setUniformFloat2(SHADER_FULL_SIZE, shaped.width, shaped.height);
+        shader.setUniformFloat4(SHADER_COLOR, col.r * col.a, col.g * col.a, col.b * col.a, col.a);
+
+        glActiveTexture(GL_TEXTURE0);
+        m_atlas->bind();
+
+        glBindVertexArray(m_vao);
+        glBindBuffer(GL_ARRAY_BUFFER, m_instanceVbo);
+        glBufferData(GL_ARRAY_BUFFER, m_instances.size() * sizeof(GLfloat), m_instances.data(), GL_STREAM_DRAW);
+        glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, sc<GLsizei>(m_instances.size() / FLOATS_PER_GLYPH));
+        glBindVertexArray(0);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+
+    glFramebufferTexture2D(GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, 0, 0);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, prevFb);
+    g_pHyprOpenGL->setViewport(PREVVIEWPORT.x, PREVVIEWPORT.y, PREVVIEWPORT.width, PREVVIEWPORT.height);
+    g_pHyprOpenGL->setCapStatus(GL_SCISSOR_TEST, PREVSCISSOR);
+    g_pHyprOpenGL->setCapStatus(GL_STENCIL_TEST, PREVSTENCIL);
+    g_pHyprOpenGL->blend(PREVBLEND);
+
+    m_stats.atlasStrings++;
+    return tex;
+}
+
+SP<CTexture> CTextRenderer::renderWithCairo(const SLayoutKey& key, const CHyprColor& col) {
+    const auto LAYOUT = makeLayout(key);
+
+    int        textW = 0, textH = 0;
+    pango_layout_get_size(LAYOUT, &textW, &textH);
+    textW /= PANGO_SCALE;
+    textH /= PANGO_SCALE;
+
+    const auto CAIROSURFACE = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, textW, textH);
+    const auto CAIRO        = cairo_create(CAIROSURFACE);
+
+    m_stats.surfaceBytes += sc<size_t>(cairo_image_surface_get_stride(CAIROSURFACE)) * textH;
+
+    cairo_set_source_rgba(CAIRO, col.r, col.g, col.b, col.a);
+    cairo_move_to(CAIRO, 0, 0);
+    pango_cairo_show_layout(CAIRO, LAYOUT);
+
+    cairo_surface_flush(CAIROSURFACE);
+
+    SP<CTexture> tex = makeShared<CTexture>();
+    tex->allocate();
+    tex->m_size = {cairo_image_surface_get_width(CAIROSURFACE), cairo_image_surface_get_height(CAIROSURFACE)};
+
+    const auto DATA = cairo_image_surface_get_data(CAIROSURFACE);
+    tex->bind();
+    tex->setTexParameter(GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    tex->setTexParameter(GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    tex->setTexParameter(GL_TEXTURE_SWIZZLE_R, GL_BLUE);
+    tex->setTexParameter(GL_TEXTURE_SWIZZLE_B, GL_RED);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, tex->m_size.x, tex->m_size.y, 0, GL_RGBA, GL_UNSIGNED_BYTE, DATA);
+
+    cairo_destroy(CAIRO);
+    cairo_surface_destroy(CAIROSURFACE);
+    g_object_unref(LAYOUT);
+
+    m_stats.cairoStrings++;
+    return tex;
+}
+
+SP<CTexture> CTextRenderer::render(const std::string& text, const CHyprColor& col, int pt, bool italic, const std::string& fontFamily, int maxWidth, int weight) {
+    static auto      FONT = CConfigValue<std::string>("misc:font_family");
+
+    const SLayoutKey KEY = {.text = text, .font = fontFamily.empty() ? *FONT : fontFamily, .pt = pt, .italic = italic, .maxWidth = maxWidth, .weight = weight};
+
+    // shaders are set up on the first frame, text made before that (and if the glyph shader didn't build) is rasterized whole
+    if (!g_pHyprOpenGL->m_shaders || !g_pHyprOpenGL->m_shaders->m_shGLYPH.program)
+        return renderWithCairo(KEY, col);
+
+    initGL();
+
+    const auto SHAPED = shapedFor(KEY);
+    if (SHAPED->width <= 0 || SHAPED->height <= 0)
+        return renderWithCairo(KEY, col);
+
+    if (auto tex = renderWithAtlas(*SHAPED, col))
+        return tex;
+
+    return renderWithCairo(KEY, col);
+}
@@ -0,0 +1,127 @@
+#pragma once
+
+#include "../defines.hpp"
+#include "../helpers/Color.hpp"
+#include "../helpers/LRUCache.hpp"
+#include <GLES3/gl32.h>
+#include <cairo/cairo.h>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+class CTexture;
+
+typedef struct _PangoContext         PangoContext;
+typedef struct _PangoLayout          PangoLayout;
+typedef struct _PangoFontDescription PangoFontDescription;
+typedef struct _PangoFont            PangoFont;
+
+/*
+    Renders text for CHyprOpenGLImpl::renderText.
+
+    Strings are shaped once with pango and the resulting glyph runs are cached, color isn't part
+    of the shaping. Every glyph is rasterized once into a shared atlas texture, and a string is
+    drawn into its texture as one instanced quad per glyph, so a new string costs no cairo raster
+    or upload as long as its glyphs were seen before.
+
+    When the atlas can't be used (shaders not ready yet, or a string with more distinct glyphs than
+    fit) the string is rasterized with cairo and uploaded as a whole instead.
+*/
+class CTextRenderer {
+  public:
+    CTextRenderer();
+    ~CTextRenderer();
+
+    SP<CTexture> render(const std::string& text, const CHyprColor& col, int pt, bool italic, const std::string& fontFamily, int maxWidth, int weight);
+
+    struct SStats {
+        size_t shapeHits    = 0;
+        size_t shapeMisses  = 0; // strings shaped
+        size_t glyphHits    = 0;
+        size_t glyphMisses  = 0; // glyphs rasterized into the atlas
+        size_t atlasResets  = 0;
+        size_t atlasStrings = 0; // drawn from the atlas
+        size_t cairoStrings = 0; // rasterized whole
+        size_t surfaceBytes = 0; // cairo raster memory allocated, in total
+    } m_stats;
+
+  private:
+    struct SLayoutKey {
+        std::string text;
+        std::string font;
+        int         pt       = 0;
+        bool        italic   = false;
+        int         maxWidth = 0;
+        int         weight   = 400;
+
+        bool        operator==(const SLayoutKey&) const = default;
+    };
+
+    struct SLayoutKeyHash {
+        size_t operator()(const SLayoutKey& key) const;
+    };
+
+    struct SGlyphKey {
+        PangoFont* font  = nullptr;
+        uint32_t   glyph = 0;
+
+        bool       operator==(const SGlyphKey&) const = default;
+    };
+
+    struct SGlyphKeyHash {
+        size_t operator()(const SGlyphKey& key) const;
+    };
+
+    // a glyph of a shaped string, at its origin on the baseline in px
+    struct SPlacedGlyph {
+        SGlyphKey key;
+        int       x = 0;
+        int       y = 0;
+    };
+
+    struct SShaped {
+        int                       width  = 0;
+        int                       height = 0;
+        std::vector<SPlacedGlyph> glyphs;
+    };
+
+    // where a glyph is in the atlas, and where its bitmap goes relative to the glyph origin
+    struct SAtlasGlyph {
+        int  x = 0, y = 0, w = 0, h = 0;
+        int  left = 0, top = 0;
+        bool colored = false; // emoji and such, not tinted
+    };
+
+    const SShaped*                                            shapedFor(const SLayoutKey& key);
+    PangoLayout*                                              makeLayout(const SLayoutKey& key);
+    PangoFontDescription*                                     fontFor(const SLayoutKey& key);
+
+    SP<CTexture>                                              renderWithAtlas(const SShaped& shaped, const CHyprColor& col);
+    SP<CTexture>                                              renderWithCairo(const SLayoutKey& key, const CHyprColor& col);
+
+    void                                                      initGL();
+    const SAtlasGlyph*                                        glyphFor(const SGlyphKey& key);
+    bool                                                      rasterizeGlyph(const SGlyphKey& key, SAtlasGlyph& out);
+    void                                                      resetAtlas();
+    void                                                      resetShaping();
+
+    cairo_surface_t*                                          m_measureSurface = nullptr;
+    cairo_t*                                                  m_measureCairo   = nullptr;
+    PangoContext*                                             m_context        = nullptr;
+
+    CLRUCache<SLayoutKey, SShaped, SLayoutKeyHash>            m_shaped;
+
+    std::unordered_map<std::string, PangoFontDescription*>    m_fonts;
+    std::unordered_set<PangoFont*>                            m_fontRefs; // fonts glyph keys point to, kept alive until resetShaping
+
+    std::unordered_map<SGlyphKey, SAtlasGlyph, SGlyphKeyHash> m_atlasGlyphs;
+    SP<CTexture>                                              m_atlas;
+    int                                                       m_shelfX = 0, m_shelfY = 0, m_shelfHeight = 0;
+
+    GLuint                                                    m_fbo         = 0;
+    GLuint                                                    m_vao         = 0;
+    GLuint                                                    m_quadVbo     = 0;
+    GLuint                                                    m_instanceVbo = 0;
+    std::vector<GLfloat>                                      m_instances; // kept around to not reallocate every string
+};
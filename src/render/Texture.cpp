@@ -3,6 +3,7 @@
 #include "../Compositor.hpp"
 #include "../protocols/types/Buffer.hpp"
 #include "../helpers/Format.hpp"
+#include "../config/ConfigValue.hpp"
 #include <cstring>
 
 CTexture::CTexture() = default;
@@ -126,19 +127,25 @@ void CTexture::update(uint32_t drmFormat, uint8_t* pixels, uint32_t stride, cons
         setTexParameter(GL_TEXTURE_SWIZZLE_B, GL_RED);
     }
 
-    damage.copy().intersect(CBox{{}, m_size}).forEachRect([&format, &stride, &pixels](const auto& rect) {
-        GLCALL(glPixelStorei(GL_UNPACK_ROW_LENGTH_EXT, stride / format->bytesPerBlock));
-        GLCALL(glPixelStorei(GL_UNPACK_SKIP_PIXELS_EXT, rect.x1));
-        GLCALL(glPixelStorei(GL_UNPACK_SKIP_ROWS_EXT, rect.y1));
+    static auto PASYNC = CConfigValue<Hyprlang::INT>("render:async_shm_upload");
 
-        int width  = rect.x2 - rect.x1;
-        int height = rect.y2 - rect.y1;
-        GLCALL(glTexSubImage2D(GL_TEXTURE_2D, 0, rect.x1, rect.y1, width, height, format->glFormat, format->glType, pixels));
-    });
+    const auto  DAMAGE = damage.copy().intersect(CBox{{}, m_size});
 
-    GLCALL(glPixelStorei(GL_UNPACK_ROW_LENGTH_EXT, 0));
-    GLCALL(glPixelStorei(GL_UNPACK_SKIP_PIXELS_EXT, 0));
-    GLCALL(glPixelStorei(GL_UNPACK_SKIP_ROWS_EXT, 0));
+    if (!*PASYNC || !g_pHyprOpenGL->m_shmUploader->upload(*format, pixels, stride, DAMAGE)) {
+        DAMAGE.forEachRect([&format, &stride, &pixels](const auto& rect) {
+            GLCALL(glPixelStorei(GL_UNPACK_ROW_LENGTH_EXT, stride / format->bytesPerBlock));
+            GLCALL(glPixelStorei(GL_UNPACK_SKIP_PIXELS_EXT, rect.x1));
+            GLCALL(glPixelStorei(GL_UNPACK_SKIP_ROWS_EXT, rect.y1));
+
+            int width  = rect.x2 - rect.x1;
+            int height = rect.y2 - rect.y1;
+            GLCALL(glTexSubImage2D(GL_TEXTURE_2D, 0, rect.x1, rect.y1, width, height, format->glFormat, format->glType, pixels));
+        });
+
+        GLCALL(glPixelStorei(GL_UNPACK_ROW_LENGTH_EXT, 0));
+        GLCALL(glPixelStorei(GL_UNPACK_SKIP_PIXELS_EXT, 0));
+        GLCALL(glPixelStorei(GL_UNPACK_SKIP_ROWS_EXT, 0));
+    }
 
     unbind();
 
@@ -16,7 +16,80 @@ static SP<CTexture> m_tGradientInactive       = makeShared<CTexture>();
 static SP<CTexture> m_tGradientLockedActive   = makeShared<CTexture>();
 static SP<CTexture> m_tGradientLockedInactive = makeShared<CTexture>();
 
-constexpr int       BAR_TEXT_PAD = 2;
+constexpr size_t    TITLE_CACHE_CAPACITY = 128;
+
+CTitleTexCache& titleTexCache() {
+    static CTitleTexCache cache;
+    return cache;
+}
+
+CTitleTexCache::CTitleTexCache() : m_entries(TITLE_CACHE_CAPACITY) {
+    ;
+}
+
+size_t CTitleTexCache::SKeyHash::operator()(const SKey& key) const {
+    size_t hash = std::hash<std::string>{}(key.title);
+    hash ^= std::hash<std::string>{}(key.font) << 1;
+    hash ^= std::hash<uint64_t>{}((sc<uint64_t>(key.fontSize) << 32) | sc<uint32_t>(key.maxWidth)) << 2;
+    hash ^= std::hash<uint64_t>{}((sc<uint64_t>(key.color) << 32) | sc<uint32_t>(key.weight)) << 3;
+    return hash;
+}
+
+SP<CTexture> CTitleTexCache::get(const SKey& key) {
+    if (const auto TEX = m_entries.get(key)) {
+        m_hits++;
+        return *TEX;
+    }
+
+    m_renders++;
+
+    return m_entries.insert(key, g_pHyprOpenGL->renderText(key.title, CHyprColor(sc<uint64_t>(key.color)), key.fontSize, false, key.font, key.maxWidth, key.weight));
+}
+
+void CTitleTexCache::clear() {
+    m_entries.clear();
+}
+
+CTitleTexCache::SStats CTitleTexCache::stats() const {
+    return SStats{
+        .hits     = m_hits,
+        .renders  = m_renders,
+        .entries  = m_entries.size(),
+        .capacity = m_entries.capacity(),
+    };
+}
+
+static CTitleTexCache::SKey titleKey(const std::string& title, bool active, bool locked, float barWidth, float monitorScale) {
+    static auto      FALLBACKFONT             = CConfigValue<std::string>("misc:font_family");
+    static auto      PTITLEFONTFAMILY         = CConfigValue<std::string>("group:groupbar:font_family");
+    static auto      PTITLEFONTSIZE           = CConfigValue<Hyprlang::INT>("group:groupbar:font_size");
+    static auto      PTEXTCOLORACTIVE         = CConfigValue<Hyprlang::INT>("group:groupbar:text_color");
+    static auto      PTEXTCOLORINACTIVE       = CConfigValue<Hyprlang::INT>("group:groupbar:text_color_inactive");
+    static auto      PTEXTCOLORLOCKEDACTIVE   = CConfigValue<Hyprlang::INT>("group:groupbar:text_color_locked_active");
+    static auto      PTEXTCOLORLOCKEDINACTIVE = CConfigValue<Hyprlang::INT>("group:groupbar:text_color_locked_inactive");
+
+    static auto      PTITLEFONTWEIGHTACTIVE   = CConfigValue<Hyprlang::CUSTOMTYPE>("group:groupbar:font_weight_active");
+    static auto      PTITLEFONTWEIGHTINACTIVE = CConfigValue<Hyprlang::CUSTOMTYPE>("group:groupbar:font_weight_inactive");
+
+    const auto       FONTWEIGHTACTIVE   = sc<CFontWeightConfigValueData*>((PTITLEFONTWEIGHTACTIVE.ptr())->getData());
+    const auto       FONTWEIGHTINACTIVE = sc<CFontWeightConfigValueData*>((PTITLEFONTWEIGHTINACTIVE.ptr())->getData());
+
+    const CHyprColor COLORACTIVE         = CHyprColor(*PTEXTCOLORACTIVE);
+    const CHyprColor COLORINACTIVE       = *PTEXTCOLORINACTIVE == -1 ? COLORACTIVE : CHyprColor(*PTEXTCOLORINACTIVE);
+    const CHyprColor COLORLOCKEDACTIVE   = *PTEXTCOLORLOCKEDACTIVE == -1 ? COLORACTIVE : CHyprColor(*PTEXTCOLORLOCKEDACTIVE);
+    const CHyprColor COLORLOCKEDINACTIVE = *PTEXTCOLORLOCKEDINACTIVE == -1 ? COLORINACTIVE : CHyprColor(*PTEXTCOLORLOCKEDINACTIVE);
+
+    const CHyprColor COLOR = locked ? (active ? COLORLOCKEDACTIVE : COLORLOCKEDINACTIVE) : (active ? COLORACTIVE : COLORINACTIVE);
+
+    return {
+        .title    = title,
+        .font     = *PTITLEFONTFAMILY != STRVAL_EMPTY ? *PTITLEFONTFAMILY : *FALLBACKFONT,
+        .fontSize = sc<int>(*PTITLEFONTSIZE * monitorScale),
+        .maxWidth = sc<int>(barWidth * monitorScale - 2),
+        .color    = COLOR.getAsHex(),
+        .weight   = active ? FONTWEIGHTACTIVE->m_value : FONTWEIGHTINACTIVE->m_value,
+    };
+}
 
 CHyprGroupBarDecoration::CHyprGroupBarDecoration(PHLWINDOW pWindow) : IHyprWindowDecoration(pWindow), m_window(pWindow) {
     static auto PGRADIENTS = CConfigValue<Hyprlang::INT>("group:groupbar:enabled");
@@ -107,7 +180,6 @@ void CHyprGroupBarDecoration::draw(PHLMONITOR pMonitor, float const& a) {
         return;
 
     static auto PRENDERTITLES              = CConfigValue<Hyprlang::INT>("group:groupbar:render_titles");
-    static auto PTITLEFONTSIZE             = CConfigValue<Hyprlang::INT>("group:groupbar:font_size");
     static auto PHEIGHT                    = CConfigValue<Hyprlang::INT>("group:groupbar:height");
     static auto PINDICATORGAP              = CConfigValue<Hyprlang::INT>("group:groupbar:indicator_gap");
     static auto PINDICATORHEIGHT           = CConfigValue<Hyprlang::INT>("group:groupbar:indicator_height");
@@ -225,20 +297,8 @@ void CHyprGroupBarDecoration::draw(PHLMONITOR pMonitor, float const& a) {
             }
 
             if (*PRENDERTITLES) {
-                CTitleTex* pTitleTex = textureFromTitle(m_dwGroupMembers[WINDOWINDEX]->m_title);
-
-                if (!pTitleTex)
-                    pTitleTex = m_titleTexs.titleTexs
-                                    .emplace_back(makeUnique<CTitleTex>(m_dwGroupMembers[WINDOWINDEX].lock(),
-                                                                        Vector2D{m_barWidth * pMonitor->m_scale, (*PTITLEFONTSIZE + 2L * BAR_TEXT_PAD) * pMonitor->m_scale},
-                                                                        pMonitor->m_scale))
-                                    .get();
-
-                SP<CTexture> titleTex;
-                if (m_dwGroupMembers[WINDOWINDEX] == Desktop::focusState()->window())
-                    titleTex = GROUPLOCKED ? pTitleTex->m_texLockedActive : pTitleTex->m_texActive;
-                else
-                    titleTex = GROUPLOCKED ? pTitleTex->m_texLockedInactive : pTitleTex->m_texInactive;
+                const auto   PMEMBER  = m_dwGroupMembers[WINDOWINDEX].lock();
+                SP<CTexture> titleTex = titleTexCache().get(titleKey(PMEMBER->m_title, PMEMBER == Desktop::focusState()->window(), GROUPLOCKED, m_barWidth, pMonitor->m_scale));
 
                 rect.y += std::ceil(((rect.height - titleTex->m_size.y) / 2.0) - (*PTEXTOFFSET * pMonitor->m_scale));
                 rect.height = titleTex->m_size.y;
@@ -259,52 +319,6 @@ void CHyprGroupBarDecoration::draw(PHLMONITOR pMonitor, float const& a) {
         else
             xoff += *PINNERGAP + m_barWidth;
     }
-
-    if (*PRENDERTITLES)
-        invalidateTextures();
-}
-
-CTitleTex* CHyprGroupBarDecoration::textureFromTitle(const std::string& title) {
-    for (auto const& tex : m_titleTexs.titleTexs) {
-        if (tex->m_content == title)
-            return tex.get();
-    }
-
-    return nullptr;
-}
-
-void CHyprGroupBarDecoration::invalidateTextures() {
-    m_titleTexs.titleTexs.clear();
-}
-
-CTitleTex::CTitleTex(PHLWINDOW pWindow, const Vector2D& bufferSize, const float monitorScale) : m_content(pWindow->m_title), m_windowOwner(pWindow) {
-    static auto      FALLBACKFONT             = CConfigValue<std::string>("misc:font_family");
-    static auto      PTITLEFONTFAMILY         = CConfigValue<std::string>("group:groupbar:font_family");
-    static auto      PTITLEFONTSIZE           = CConfigValue<Hyprlang::INT>("group:groupbar:font_size");
-    static auto      PTEXTCOLORACTIVE         = CConfigValue<Hyprlang::INT>("group:groupbar:text_color");
-    static auto      PTEXTCOLORINACTIVE       = CConfigValue<Hyprlang::INT>("group:groupbar:text_color_inactive");
-    static auto      PTEXTCOLORLOCKEDACTIVE   = CConfigValue<Hyprlang::INT>("group:groupbar:text_color_locked_active");
-    static auto      PTEXTCOLORLOCKEDINACTIVE = CConfigValue<Hyprlang::INT>("group:groupbar:text_color_locked_inactive");
-
-    static auto      PTITLEFONTWEIGHTACTIVE   = CConfigValue<Hyprlang::CUSTOMTYPE>("group:groupbar:font_weight_active");
-    static auto      PTITLEFONTWEIGHTINACTIVE = CConfigValue<Hyprlang::CUSTOMTYPE>("group:groupbar:font_weight_inactive");
-
-    const auto       FONTWEIGHTACTIVE   = sc<CFontWeightConfigValueData*>((PTITLEFONTWEIGHTACTIVE.ptr())->getData());
-    const auto       FONTWEIGHTINACTIVE = sc<CFontWeightConfigValueData*>((PTITLEFONTWEIGHTINACTIVE.ptr())->getData());
-
-    const CHyprColor COLORACTIVE         = CHyprColor(*PTEXTCOLORACTIVE);
-    const CHyprColor COLORINACTIVE       = *PTEXTCOLORINACTIVE == -1 ? COLORACTIVE : CHyprColor(*PTEXTCOLORINACTIVE);
-    const CHyprColor COLORLOCKEDACTIVE   = *PTEXTCOLORLOCKEDACTIVE == -1 ? COLORACTIVE : CHyprColor(*PTEXTCOLORLOCKEDACTIVE);
-    const CHyprColor COLORLOCKEDINACTIVE = *PTEXTCOLORLOCKEDINACTIVE == -1 ? COLORINACTIVE : CHyprColor(*PTEXTCOLORLOCKEDINACTIVE);
-
-    const auto       FONTFAMILY = *PTITLEFONTFAMILY != STRVAL_EMPTY ? *PTITLEFONTFAMILY : *FALLBACKFONT;
-
-#define RENDER_TEXT(color, weight) g_pHyprOpenGL->renderText(pWindow->m_title, (color), *PTITLEFONTSIZE* monitorScale, false, FONTFAMILY, bufferSize.x - 2, (weight));
-    m_texActive         = RENDER_TEXT(COLORACTIVE, FONTWEIGHTACTIVE->m_value);
-    m_texInactive       = RENDER_TEXT(COLORINACTIVE, FONTWEIGHTINACTIVE->m_value);
-    m_texLockedActive   = RENDER_TEXT(COLORLOCKEDACTIVE, FONTWEIGHTACTIVE->m_value);
-    m_texLockedInactive = RENDER_TEXT(COLORLOCKEDINACTIVE, FONTWEIGHTINACTIVE->m_value);
-#undef RENDER_TEXT
 }
 
 static void renderGradientTo(SP<CTexture> tex, CGradientValueData* grad) {
@@ -369,6 +383,9 @@ void refreshGroupBarGradients() {
 
     g_pHyprRenderer->makeEGLCurrent();
 
+    // colors, fonts or sizes may have changed, nothing in there is going to be asked for again
+    titleTexCache().clear();
+
     if (m_tGradientActive->m_texID != 0) {
         m_tGradientActive->destroyTexture();
         m_tGradientInactive->destroyTexture();
@@ -5,22 +5,51 @@
 #include <vector>
 #include "../Texture.hpp"
 #include <string>
+#include "../../helpers/LRUCache.hpp"
 #include "../../helpers/memory/Memory.hpp"
 
-class CTitleTex {
+// Rendered groupbar titles, shared by every groupbar. Keyed on everything that changes the pixels,
+// so a title only gets rendered again when it or the config changes.
+class CTitleTexCache {
   public:
-    CTitleTex(PHLWINDOW pWindow, const Vector2D& bufferSize, const float monitorScale);
-    ~CTitleTex() = default;
+    CTitleTexCache();
 
-    SP<CTexture> m_texActive;
-    SP<CTexture> m_texInactive;
-    SP<CTexture> m_texLockedActive;
-    SP<CTexture> m_texLockedInactive;
-    std::string  m_content;
+    struct SKey {
+        std::string title;
+        std::string font;
+        int         fontSize = 0; // px
+        int         maxWidth = 0; // px
+        uint32_t    color    = 0; // argb
+        int         weight   = 400;
 
-    PHLWINDOWREF m_windowOwner;
+        bool        operator==(const SKey&) const = default;
+    };
+
+    SP<CTexture> get(const SKey& key);
+    void         clear();
+
+    struct SStats {
+        size_t hits     = 0;
+        size_t renders  = 0;
+        size_t entries  = 0;
+        size_t capacity = 0;
+    };
+
+    SStats stats() const;
+
+  private:
+    struct SKeyHash {
+        size_t operator()(const SKey& key) const;
+    };
+
+    CLRUCache<SKey, SP<CTexture>, SKeyHash> m_entries;
+
+    size_t                                  m_hits    = 0;
+    size_t                                  m_renders = 0;
 };
 
+CTitleTexCache& titleTexCache();
+
 void refreshGroupBarGradients();
 
 class CHyprGroupBarDecoration : public IHyprWindowDecoration {
@@ -60,9 +89,6 @@ class CHyprGroupBarDecoration : public IHyprWindowDecoration {
 
     bool                      m_bLastVisibilityStatus = true;
 
-    CTitleTex*                textureFromTitle(const std::string&);
-    void                      invalidateTextures();
-
     CBox                      assignedBoxGlobal();
     bool                      visible();
 
@@ -70,9 +96,4 @@ class CHyprGroupBarDecoration : public IHyprWindowDecoration {
     bool                      onEndWindowDragOnDeco(const Vector2D&, PHLWINDOW);
     bool                      onMouseButtonOnDeco(const Vector2D&, const IPointer::SButtonEvent&);
     bool                      onScrollOnDeco(const Vector2D&, const IPointer::SAxisEvent);
-
-    struct STitleTexs {
-        // STitleTexs*                            overriden = nullptr; // TODO: make shit shared in-group to decrease VRAM usage.
-        std::vector<UP<CTitleTex>> titleTexs;
-    } m_titleTexs;
 };
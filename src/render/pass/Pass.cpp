@@ -4,6 +4,7 @@
 #include <ranges>
 #include "../../Compositor.hpp"
 #include "../../config/ConfigValue.hpp"
+#include "../../debug/Telemetry.hpp"
 #include "../../desktop/WLSurface.hpp"
 #include "../../managers/SeatManager.hpp"
 #include "../../managers/eventLoop/EventLoopManager.hpp"
@@ -174,6 +175,10 @@ CRegion CRenderPass::render(const CRegion& damage_) {
     if (m_passElements.empty())
         return {};
 
+    auto& telemetry = g_pTelemetry->forMonitor(g_pHyprOpenGL->m_renderData.pMonitor.lock());
+    telemetry.passElements.add(m_passElements.size());
+    telemetry.discardedElements.add(std::ranges::count_if(m_passElements, [](const auto& e) { return e->discard; }));
+
     for (auto& el : m_passElements) {
         if (el->discard) {
             el->element->discard();
@@ -1,4 +1,6 @@
 #version 300 es
+#extension GL_ARB_shading_language_include : enable
+
 precision            highp float;
 uniform sampler2D    tex;
 
@@ -8,8 +10,19 @@ uniform int          passes;
 uniform float        vibrancy;
 uniform float        vibrancy_darkness;
 
+// the first pass reads the unblurred image and does the color adjustments on every tap
+uniform int          prepare;
+uniform float        contrast;
+uniform float        brightness;
+
+uniform int          skipCM;
+uniform int          sourceTF; // eTransferFunction
+uniform int          targetTF; // eTransferFunction
+
 in vec2 v_texcoord;
 
+#include "CM.glsl"
+
 // see http://alienryderflex.com/hsp.html
 const float Pr = 0.299;
 const float Pg = 0.587;
@@ -108,15 +121,51 @@ vec3 hsl2rgb(vec3 col) {
     return rgb;
 }
 
+float gain(float x, float k) {
+    float a = 0.5 * pow(2.0 * ((x < 0.5) ? x : 1.0 - x), k);
+    return (x < 0.5) ? a : 1.0 - a;
+}
+
+vec4 sampleTex(vec2 uv) {
+    vec4 pixColor = texture(tex, uv);
+
+    if (prepare == 0)
+        return pixColor;
+
+    if (skipCM == 0) {
+        if (sourceTF == CM_TRANSFER_FUNCTION_ST2084_PQ) {
+            pixColor.rgb /= sdrBrightnessMultiplier;
+        }
+        pixColor.rgb = convertMatrix * toLinearRGB(pixColor.rgb, sourceTF);
+        pixColor = toNit(pixColor, srcTFRange);
+        pixColor = fromLinearNit(pixColor, targetTF, dstTFRange);
+    }
+
+    // contrast
+    if (contrast != 1.0) {
+        pixColor.r = gain(pixColor.r, contrast);
+        pixColor.g = gain(pixColor.g, contrast);
+        pixColor.b = gain(pixColor.b, contrast);
+    }
+
+    // brightness
+    if (brightness > 1.0) {
+        pixColor.rgb *= brightness;
+    }
+
+    return pixColor;
+}
+
 layout(location = 0) out vec4 fragColor;
 void main() {
-    vec2 uv = v_texcoord * 2.0;
-
-    vec4 sum = texture(tex, uv) * 4.0;
-    sum += texture(tex, uv - halfpixel.xy * radius);
-    sum += texture(tex, uv + halfpixel.xy * radius);
-    sum += texture(tex, uv + vec2(halfpixel.x, -halfpixel.y) * radius);
-    sum += texture(tex, uv - vec2(halfpixel.x, -halfpixel.y) * radius);
+    // the target is half the size of tex, so this is already the downsample
+    vec2 uv = v_texcoord;
+
+    vec4 sum = sampleTex(uv) * 4.0;
+    sum += sampleTex(uv - halfpixel.xy * radius);
+    sum += sampleTex(uv + halfpixel.xy * radius);
+    sum += sampleTex(uv + vec2(halfpixel.x, -halfpixel.y) * radius);
+    sum += sampleTex(uv - vec2(halfpixel.x, -halfpixel.y) * radius);
 
     vec4 color = sum / 8.0;
 
@@ -5,11 +5,23 @@ uniform sampler2D tex;
 uniform float radius;
 uniform vec2 halfpixel;
 
+// the last pass writes the full size result, with noise and darkening on top
+uniform int finish;
+uniform float noise;
+uniform float brightness;
+
 in vec2 v_texcoord;
 layout(location = 0) out vec4 fragColor;
 
+float hash(vec2 p) {
+    vec3 p3 = fract(vec3(p.xyx) * 1689.1984);
+    p3 += dot(p3, p3.yzx + 33.33);
+    return fract((p3.x + p3.y) * p3.z);
+}
+
 void main() {
-    vec2 uv = v_texcoord / 2.0;
+    // the target is twice the size of tex, so this is already the upsample
+    vec2 uv = v_texcoord;
 
     vec4 sum = texture(tex, uv + vec2(-halfpixel.x * 2.0, 0.0) * radius);
 
@@ -21,5 +33,19 @@ void main() {
     sum += texture(tex, uv + vec2(0.0,          -halfpixel.y * 2.0) * radius);
     sum += texture(tex, uv + vec2(-halfpixel.x, -halfpixel.y) * radius) * 2.0;
 
-    fragColor = sum / 12.0;
+    vec4 pixColor = sum / 12.0;
+
+    if (finish == 1) {
+        // noise
+        float noiseHash   = hash(v_texcoord);
+        float noiseAmount = (mod(noiseHash, 1.0) - 0.5);
+        pixColor.rgb += noiseAmount * noise;
+
+        // brightness
+        if (brightness < 1.0) {
+            pixColor.rgb *= brightness;
+        }
+    }
+
+    fragColor = pixColor;
 }
@@ -0,0 +1,15 @@
+#version 300 es
+
+precision highp float;
+in vec2 v_texcoord;
+in float v_colored;
+
+uniform sampler2D tex;
+uniform vec4 color; // premultiplied
+
+layout(location = 0) out vec4 fragColor;
+void main() {
+    // the atlas holds glyphs in white, apart from the ones that keep their own colors
+    vec4 glyph = texture(tex, v_texcoord);
+    fragColor = v_colored > 0.5 ? glyph * color.a : color * glyph.a;
+}
@@ -0,0 +1,18 @@
+#version 300 es
+
+uniform vec2 fullSize; // of the texture drawn into, in px
+
+layout(location = 0) in vec2 corner;   // of the unit quad
+layout(location = 1) in vec4 dest;     // per glyph: x, y, w, h in px, y down
+layout(location = 2) in vec4 src;      // per glyph: x, y, w, h in atlas uv
+layout(location = 3) in float colored; // per glyph: has colors of its own, like emoji
+
+out vec2 v_texcoord;
+out float v_colored;
+
+void main() {
+    // y down on purpose, the first row of the texture is the top of the text like with the cairo upload
+    gl_Position = vec4((dest.xy + corner * dest.zw) / fullSize * 2.0 - 1.0, 0.0, 1.0);
+    v_texcoord = src.xy + corner * src.zw;
+    v_colored = colored;
+}
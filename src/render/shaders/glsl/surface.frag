@@ -0,0 +1,61 @@
+#version 300 es
+#extension GL_ARB_shading_language_include : enable
+
+// Specialized variant of rgba.frag / rgbx.frag / CM.frag. Never compiled as is, CHyprOpenGLImpl::getSurfaceShader
+// injects the feature defines below right after #version:
+//   TEX_RGBX, DISCARD_OPAQUE, DISCARD_ALPHA, APPLY_TINT, ROUNDING, USE_CM + SOURCE_TF / TARGET_TF
+
+precision highp float;
+in vec2 v_texcoord;
+uniform sampler2D tex;
+uniform float alpha;
+
+#ifdef DISCARD_ALPHA
+uniform float discardAlphaValue;
+#endif
+
+#ifdef APPLY_TINT
+uniform vec3 tint;
+#endif
+
+#ifdef ROUNDING
+#include "rounding.glsl"
+#endif
+
+#ifdef USE_CM
+uniform mat4x2 targetPrimaries;
+#include "CM.glsl"
+#endif
+
+layout(location = 0) out vec4 fragColor;
+void main() {
+#ifdef TEX_RGBX
+    vec4 pixColor = vec4(texture(tex, v_texcoord).rgb, 1.0);
+#else
+    vec4 pixColor = texture(tex, v_texcoord);
+#endif
+
+#ifdef DISCARD_OPAQUE
+    if (pixColor[3] * alpha == 1.0)
+        discard;
+#endif
+
+#ifdef DISCARD_ALPHA
+    if (pixColor[3] <= discardAlphaValue)
+        discard;
+#endif
+
+#ifdef USE_CM
+    pixColor = doColorManagement(pixColor, SOURCE_TF, TARGET_TF, targetPrimaries);
+#endif
+
+#ifdef APPLY_TINT
+    pixColor = vec4(pixColor.rgb * tint.rgb, pixColor[3]);
+#endif
+
+#ifdef ROUNDING
+    pixColor = rounding(pixColor);
+#endif
+
+    fragColor = pixColor * alpha;
+}
@@ -1199,6 +1199,12 @@ void CXWM::updateWorkArea(int x, int y, int w, int h) {
         return;
     auto connection = g_pXWayland->m_wm->getConnection();
 
+    const CBox BOX = {x, y, w, h};
+    if (m_lastWorkArea == BOX)
+        return;
+
+    m_lastWorkArea = BOX;
+
     if (w <= 0 || h <= 0) {
         xcb_delete_property(connection, m_screen->root, HYPRATOMS["_NET_WORKAREA"]);
         xcb_flush(connection);
@@ -4,6 +4,7 @@
 #include "Dnd.hpp"
 #include "../helpers/memory/Memory.hpp"
 #include "../helpers/signal/Signal.hpp"
+#include "../helpers/math/Math.hpp"
 
 #include <xcb/xcb.h>
 #include <xcb/res.h>
@@ -13,6 +14,7 @@
 #include <hyprutils/os/FileDescriptor.hpp>
 #include <cinttypes> // for PRIxPTR
 #include <cstdint>
+#include <optional>
 
 struct wl_event_source;
 class CXWaylandSurfaceResource;
@@ -199,6 +201,8 @@ class CXWM {
 
     xcb_render_pictformat_t                   m_renderFormatID;
 
+    std::optional<CBox>                       m_lastWorkArea; // layouts update it on every recalc, most of which don't change it
+
     std::vector<WP<CXWaylandSurfaceResource>> m_shellResources;
     std::vector<SP<CXWaylandSurface>>         m_surfaces;
     std::vector<WP<CXWaylandSurface>>         m_mappedSurfaces;         // ordered by map time